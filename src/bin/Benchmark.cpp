@@ -0,0 +1,710 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Excutable file to benchmark the hot paths of the library on fixed
+ *  inputs: loading labeled and unlabeled data, generating samples per
+ *  feature set, extracting tree paths, training and labeling by the ME
+ *  classifier, sorting the labeled sentences for selection, and saving the
+ *  labeled props
+ *
+ *  Each benchmark is repeated and the minimum, median, mean and standard
+ *  deviation of its wall clock times are reported together with the median
+ *  time per sentence and per sample, so that the numbers of the same input
+ *  can be compared before and after a change. The inputs are the first
+ *  sentences (as many as the size parameter) of the given files; each
+ *  repetition of loading and sample generation works on a fresh copy of
+ *  them, since the sentences keep the samples and features generated for
+ *  them.
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+
+#include "CoNLLLoader.hpp"
+#include "ULoader.hpp"
+#include "CoNLLSaver.hpp"
+#include "Sentence.hpp"
+#include "TBTree.hpp"
+#include "DTree.hpp"
+#include "SampleGenerator.hpp"
+#include "Sample.hpp"
+#include "Utils.hpp"
+#include "Constants.hpp"
+#include "Classifier.hpp"
+#include "Metrics.hpp"
+#include "Logging.hpp"
+#include "FeatureHasher.hpp"
+
+using namespace std;
+
+
+struct benchmarkResult
+{
+ string name;
+ vector<double> times;
+ unsigned int sentenceCount;
+ unsigned int sampleCount;
+ };
+
+short loadCoNLLSentences(vector<Sentence *> &, string &, string &,
+                         string &, string &, int, bool, unsigned short);
+short loadUnlabeledSentences(vector<Sentence *> &, string &, string &,
+                             int, bool, unsigned short);
+unsigned int extractPaths(vector<Sample *> &);
+void initBenchmarkResult(benchmarkResult &, const string &);
+void logBenchmarkResult(benchmarkResult &, ostream &);
+
+static void usage(const char * execName)
+{
+ cout << "Usage: "
+      << execName << " [the file containing input parameters]" << endl << endl
+      << "possible parameters: (each in a new line in the parameter file)" << endl << endl
+      << " <-bs[Number of sentences of each input to benchmark with (0: all)]>" << endl
+      << " <-br[Number of repetitions of each benchmark]>" << endl
+      << " <-fs[Feature sets to generate samples with, separated by comma (e.g. 1,2,3); the first one is used by the rest of benchmarks]>" << endl
+      << " <-mi[ME iteration number]>" << endl
+      << " <-mp[ME parameter estimation method (lbfgs, gis, sgd or perceptron)]>" << endl
+      << " <-mt[ME training threads (0: maxent trainer; n: built-in parallel trainer with n threads)]>" << endl
+      << " <-fc[ME feature count cutoff (features seen less are dropped; 0: no cutoff)]>" << endl
+      << " <-fh[Feature hashing bits (0: no hashing; k: 2^k feature buckets)]>" << endl
+      << " <-hs[Signed feature hashing (0: no; 1: yes)]>" << endl
+      << " <-g[Gaussian parameter]>" << endl
+      << " <-fe[Fast ME evaluation by built-in scorer (0: no; 1: yes)]>" << endl
+      << " <-ph[Precompute head words, subcat and governing category of constituents at load time (0: no; 1: yes)]>" << endl
+      << " <-lt[Number of threads loading sentence-aligned chunks of data in parallel (0 or 1: sequential loading)]>" << endl
+      << " <-ltw[CoNLL training words file name]>" << endl
+      << " <-lts[CoNLL training cfg syntax file name]>" << endl
+      << " <-ltd[CoNLL training dependency syntax file name]>" << endl
+      << " <-ltp[CoNLL training propositions file name]>" << endl
+      << " <-utd[Unlabeled training data file name]>" << endl
+      << " <-utds[Unlabeled training dependency syntax file name]>" << endl
+      <<  endl;
+}
+
+int main(int argc, char ** argv)
+{
+ // setting defaults for input executable arguments
+
+ string vLabeledPath = DEFAULT_CONLL_LABELED_PATH;
+ string vLabeledWordsFile = vLabeledPath + "/" + DEFAULT_CONLL_TRAIN_WORDS_NAME;
+ string vLabeledSyntChaFile = vLabeledPath + "/" + DEFAULT_CONLL_TRAIN_SYNT_CHA_NAME;
+ string vLabeledSyntDepFile = vLabeledPath + "/" + DEFAULT_CONLL_TRAIN_SYNT_DEP_NAME;
+ string vLabeledPropsFile = vLabeledPath + "/" + DEFAULT_CONLL_TRAIN_PROPS_NAME;
+
+ string vUnlabeledPath = DEFAULT_CONLL_UNLABELED_PATH;
+ string vUnlabeledDataFile = vUnlabeledPath + "/" + DEFAULT_CONLL_UNLABELED_DATA_NAME;
+ string vUnlabeledSyntDepFile = vUnlabeledPath + "/" + DEFAULT_CONLL_UNLABELED_SYNT_DEP_NAME;
+
+ int vSize = 1000;
+ unsigned short vRepetitions = 5;
+ vector<unsigned short> vFeatureSets;
+ unsigned int vMEIterations = 100;
+ string vMEPEMethod = "lbfgs";
+ unsigned short vMEThreads = 0;
+ unsigned int vFeatureCutoff = 0;
+ unsigned short vHashingBits = 0;
+ bool vSignedHashing = false;
+ double vGaussian = 1;
+ bool vFastEval = false;
+ bool vPrecomputeTrees = false;
+ unsigned short vLoadThreads = 0;
+
+ if (argc < 2)
+ {
+  cerr << "No input parameter file is specified!" << endl;
+  exit(-1);
+  }
+
+ const string ctmpStr  = "help";
+ if(argv[1] == ctmpStr)
+ {
+  usage(argv[0]);
+  exit(-1);
+  }
+
+ string tmpLogFile = LOG_BENCHMARK_OUTPUT_FILE_PREFIX;
+ tmpLogFile += ".[" + getLocalTimeStr("YYYY-MM-DD-HH-MM") + "].log";
+ AsyncLogFile log (tmpLogFile.c_str());
+ if (!log)
+  cerr << "Cannot create output log file: " << tmpLogFile
+       << endl;
+
+ string vParamFile = argv[1];
+
+ /**
+  *  reading parameters
+  */
+
+ ifstream strmParams (vParamFile.c_str());
+
+ if(!strmParams)
+ {
+  cerr << "Can't open file: " << vParamFile << endl;
+  return -1;
+  }
+
+ string vParam;
+ vector<string> vcParam;
+
+ while (!strmParams.eof())
+ {
+  getline(strmParams, vParam);
+
+  // treating # as comment sign
+  if (!vParam.empty() && (vParam[0] == '#'))
+   continue;
+
+  vcParam.clear();
+  tokenize(vParam, vcParam, " \t");
+
+  if (vcParam.size() < 2)
+   continue;
+
+  log << vParam << endl;
+
+  if (vcParam[0] == "-bs")
+  {
+   vSize = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-br")
+  {
+   vRepetitions = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-fs")
+  {
+   vector<string> vcFeatureSets;
+   tokenize(vcParam[1], vcFeatureSets, ",");
+   for (unsigned i = 0; i < vcFeatureSets.size(); i++)
+    vFeatureSets.push_back(strToInt(vcFeatureSets[i]));
+   continue;
+   }
+
+  if (vcParam[0] == "-mi")
+  {
+   vMEIterations = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-mp")
+  {
+   vMEPEMethod = vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-mt")
+  {
+   vMEThreads = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-fc")
+  {
+   vFeatureCutoff = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-fh")
+  {
+   vHashingBits = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-hs")
+  {
+   vSignedHashing = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-g")
+  {
+   vGaussian = strToFloat(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-fe")
+  {
+   vFastEval = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-ph")
+  {
+   vPrecomputeTrees = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-lt")
+  {
+   vLoadThreads = strToInt(vcParam[1]);
+   continue;
+   }
+
+  if (vcParam[0] == "-ltw")
+  {
+   vLabeledWordsFile = vLabeledPath + "/" + vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-lts")
+  {
+   vLabeledSyntChaFile = vLabeledPath + "/" + vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-ltd")
+  {
+   vLabeledSyntDepFile = vLabeledPath + "/" + vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-ltp")
+  {
+   vLabeledPropsFile = vLabeledPath + "/" + vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-utd")
+  {
+   vUnlabeledDataFile = vUnlabeledPath + "/" + vcParam[1];
+   continue;
+   }
+
+  if (vcParam[0] == "-utds")
+  {
+   vUnlabeledSyntDepFile = vUnlabeledPath + "/" + vcParam[1];
+   continue;
+   }
+  }
+
+ if (vFeatureSets.empty())
+  vFeatureSets.push_back(1);
+ if (vRepetitions == 0)
+  vRepetitions = 1;
+
+ vector<benchmarkResult> vResults;
+ Timer oTimer;
+
+
+/**
+ *   loading CoNLL labeled data
+ */
+
+ mout("\nBenchmarking CoNLLLoader::loadData ...\n", cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "CoNLLLoader::loadData");
+
+ vector<Sentence *> vcLabeledSntncs;
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  vector<Sentence *> vcSentences;
+
+  oTimer.start();
+  if (loadCoNLLSentences(vcSentences, vLabeledWordsFile, vLabeledSyntChaFile,
+                         vLabeledSyntDepFile, vLabeledPropsFile, vSize,
+                         vPrecomputeTrees, vLoadThreads) != 0)
+   return -1;
+  oTimer.stop();
+
+  vResults.back().times.push_back(oTimer.getElapsedTime());
+  vResults.back().sentenceCount = vcSentences.size();
+
+  // the sentences of the first repetition are kept to train and label
+  if (i == 0)
+   vcLabeledSntncs.swap(vcSentences);
+  }
+
+
+/**
+ *   loading unlabeled data
+ */
+
+ mout("\nBenchmarking ULoader::loadData ...\n", cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "ULoader::loadData");
+
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  vector<Sentence *> vcSentences;
+
+  oTimer.start();
+  if (loadUnlabeledSentences(vcSentences, vUnlabeledDataFile,
+                             vUnlabeledSyntDepFile, vSize,
+                             vPrecomputeTrees, vLoadThreads) != 0)
+   return -1;
+  oTimer.stop();
+
+  vResults.back().times.push_back(oTimer.getElapsedTime());
+  vResults.back().sentenceCount = vcSentences.size();
+  }
+
+
+/**
+ *   generating samples (constructing Sample objects) per feature set; each
+ *   repetition generates on a fresh copy of the labeled data, because the
+ *   propositions cache the features shared by their samples
+ */
+
+ vector<Sample *> vcTrainingSamples;
+ for (unsigned short cntFeatureSets = 0;
+      cntFeatureSets < vFeatureSets.size();
+      cntFeatureSets++)
+ {
+  string vName = "Sample (fs " + intToStr(vFeatureSets[cntFeatureSets]) + ")";
+  mout("\nBenchmarking " + vName + " ...\n", cout, log);
+
+  vResults.push_back(benchmarkResult());
+  initBenchmarkResult(vResults.back(), vName);
+
+  unsigned short vFeatureSet[] = {vFeatureSets[cntFeatureSets]};
+  for (unsigned short i = 0; i < vRepetitions; i++)
+  {
+   vector<Sentence *> vcSentences;
+   if ((i == 0) && (cntFeatureSets == 0))
+    vcSentences = vcLabeledSntncs;
+   else if (loadCoNLLSentences(vcSentences, vLabeledWordsFile,
+                               vLabeledSyntChaFile, vLabeledSyntDepFile,
+                               vLabeledPropsFile, vSize,
+                               vPrecomputeTrees, vLoadThreads) != 0)
+    return -1;
+
+   LabeledSampleGenerator oSampleGenerator;
+   vector<Sample *> vcPositiveSamples;
+   vector<Sample *> vcNegativeSamples;
+
+   oTimer.start();
+   if (oSampleGenerator.generateSamples(vcSentences,
+                                        vcPositiveSamples,
+                                        vcNegativeSamples,
+                                        1, vFeatureSet, false) != 0)
+   {
+    mout("\nGenerating labeled training samples was not successful!\n",
+         cerr, log);
+    return -1;
+    }
+   oTimer.stop();
+
+   vResults.back().times.push_back(oTimer.getElapsedTime());
+   vResults.back().sentenceCount = vcSentences.size();
+   vResults.back().sampleCount = vcPositiveSamples.size() +
+                                 vcNegativeSamples.size();
+
+   // the samples of the kept labeled data are used by the rest
+   if ((i == 0) && (cntFeatureSets == 0))
+   {
+    vcTrainingSamples = vcPositiveSamples;
+    vcTrainingSamples.insert(vcTrainingSamples.end(),
+                             vcNegativeSamples.begin(),
+                             vcNegativeSamples.end());
+    }
+   }
+  }
+
+
+/**
+ *   extracting the constituency and dependency paths of the samples
+ */
+
+ mout("\nBenchmarking TBTree::getPathTo and DTree path methods ...\n", cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "TBTree/DTree paths");
+
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  oTimer.start();
+  unsigned int vLength = extractPaths(vcTrainingSamples);
+  oTimer.stop();
+
+  vResults.back().times.push_back(oTimer.getElapsedTime());
+  vResults.back().sentenceCount = vcLabeledSntncs.size();
+  vResults.back().sampleCount = vcTrainingSamples.size();
+  log << vLength << " path characters extracted" << endl;
+  }
+
+
+/**
+ *   training and labeling; the test data is another copy of the labeled
+ *   data, labeled after each training (the classifier does not label again
+ *   what the same training has labeled)
+ */
+
+ vector<Sentence *> vcTestSntncs;
+ vector<Sample *> vcTestSamples;
+ unsigned short vFeatureSet[] = {vFeatureSets[0]};
+
+ mout("\nLoading and generating test data ...\n", cout, log);
+ if (loadCoNLLSentences(vcTestSntncs, vLabeledWordsFile, vLabeledSyntChaFile,
+                        vLabeledSyntDepFile, vLabeledPropsFile, vSize,
+                        vPrecomputeTrees, vLoadThreads) != 0)
+  return -1;
+
+ TestSampleGenerator oTestSampleGenerator;
+ if (oTestSampleGenerator.generateSamples(vcTestSntncs, vcTestSamples,
+                                          1, vFeatureSet, false) != 0)
+ {
+  mout("\nGenerating test samples was not successful!\n", cerr, log);
+  return -1;
+  }
+
+ FeatureHasher::setHashing(vHashingBits, vSignedHashing);
+ 
+ ZMEClassifier zmeClassifier;
+ zmeClassifier.setFastEvaluation(vFastEval);
+ zmeClassifier.setTrainingThreads(vMEThreads);
+ zmeClassifier.setFeatureCutoff(vFeatureCutoff);
+ // each repetition trains from scratch, also by the online methods
+ zmeClassifier.setIncrementalTraining(false);
+
+ mout("\nBenchmarking ZMEClassifier::train and ZMEClassifier::classify ...\n",
+      cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "ZMEClassifier::train");
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "ZMEClassifier::classify");
+
+ benchmarkResult &vTrainResult = vResults[vResults.size() - 2];
+ benchmarkResult &vClassifyResult = vResults[vResults.size() - 1];
+
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  oTimer.start();
+  zmeClassifier.train(vcTrainingSamples, 1, 1, true,
+                      0, vMEIterations, vMEPEMethod, vGaussian, false,
+                      ZME_TRAINING_MODEL_FILE, log);
+  oTimer.stop();
+
+  vTrainResult.times.push_back(oTimer.getElapsedTime());
+  vTrainResult.sentenceCount = vcLabeledSntncs.size();
+  vTrainResult.sampleCount = vcTrainingSamples.size();
+
+  oTimer.start();
+  zmeClassifier.classify(vcTestSntncs, 1, false, log);
+  oTimer.stop();
+
+  vClassifyResult.times.push_back(oTimer.getElapsedTime());
+  vClassifyResult.sentenceCount = vcTestSntncs.size();
+  vClassifyResult.sampleCount = vcTestSamples.size();
+  }
+
+
+/**
+ *   sorting the labeled sentences by labeling probability as in
+ *   selectAndMove() of the bootstrapping executables
+ */
+
+ mout("\nBenchmarking selection sorting ...\n", cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "selection sort");
+
+ gvActiveFeatureView = 1;
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  vector<Sentence *> vcPool = vcTestSntncs;
+
+  oTimer.start();
+  sort(vcPool.begin(), vcPool.end(), isMoreLikelyLabeling);
+  oTimer.stop();
+
+  vResults.back().times.push_back(oTimer.getElapsedTime());
+  vResults.back().sentenceCount = vcTestSntncs.size();
+  vResults.back().sampleCount = vcTestSamples.size();
+  }
+
+
+/**
+ *   saving the labeled props
+ */
+
+ mout("\nBenchmarking CoNLLSaver::saveProps ...\n", cout, log);
+
+ vResults.push_back(benchmarkResult());
+ initBenchmarkResult(vResults.back(), "CoNLLSaver::saveProps");
+
+ string vOutputPropsFile = BENCHMARK_OUTPUT_PROPS_FILE;
+ for (unsigned short i = 0; i < vRepetitions; i++)
+ {
+  CoNLLSaver oCoNLLSaver(vOutputPropsFile);
+
+  oTimer.start();
+  if (oCoNLLSaver.saveProps(vcTestSntncs, 1) != 0)
+  {
+   mout("\nSaving labeled props was not successful!\n", cerr, log);
+   return -1;
+   }
+  oTimer.stop();
+
+  vResults.back().times.push_back(oTimer.getElapsedTime());
+  vResults.back().sentenceCount = vcTestSntncs.size();
+  vResults.back().sampleCount = vcTestSamples.size();
+  }
+
+
+/**
+ *   reporting
+ */
+
+ mout("\nBenchmark results (" + intToStr(vRepetitions) + " repetitions, " +
+      intToStr(vcLabeledSntncs.size()) + " sentences):\n\n", cout, log);
+
+ ostringstream strmResults;
+ strmResults << setw(28) << "benchmark" << setw(10) << "min ms"
+             << setw(10) << "med ms" << setw(10) << "mean ms"
+             << setw(10) << "stdev ms" << setw(10) << "sentences"
+             << setw(12) << "us/sentence" << setw(10) << "samples"
+             << setw(10) << "us/sample" << endl;
+ for (unsigned i = 0; i < vResults.size(); i++)
+  logBenchmarkResult(vResults[i], strmResults);
+
+ mout(strmResults.str(), cout, log);
+
+ log.close();
+
+ return 0;
+}
+
+
+///---------------------------------------------------------------------
+short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile,
+                         string &pSyntFile, string &pDepFile, string &pPropsFile,
+                         int pSize, bool pPrecomputeTrees,
+                         unsigned short pLoadThreads)
+{
+ CoNLLLoader oCoNLLLoader(pWordsFile,
+                          pSyntFile,
+                          pDepFile,
+                          pPropsFile,
+                          pSize);
+ oCoNLLLoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oCoNLLLoader.setThreadCount(pLoadThreads);
+
+ if (oCoNLLLoader.loadData(pSentences) != 0)
+ {
+  cerr << "\nLoading data was not successful" << endl;
+  return -1;
+  }
+
+ return 0;
+}
+
+///---------------------------------------------------------------------
+short loadUnlabeledSentences(vector<Sentence *> &pSentences, string &pDataFile,
+                             string &pDepFile, int pSize, bool pPrecomputeTrees,
+                             unsigned short pLoadThreads)
+{
+ ULoader oULoader(pDataFile, pDepFile, pSize);
+ oULoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oULoader.setThreadCount(pLoadThreads);
+
+ if (oULoader.loadData(pSentences) != 0)
+ {
+  cerr << "\nLoading unlabeled data was not successful" << endl;
+  return -1;
+  }
+
+ return 0;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  extracts the constituency path and the dependency relation, POS and
+ *  lemma paths between the predicate and the constituent of each sample
+ *  (as the PATH and dependency path features do), and returns the total
+ *  length of the paths so that the work is not optimized out
+ */
+unsigned int extractPaths(vector<Sample *> &pSamples)
+{
+ unsigned int vLength = 0;
+
+ for (vector<Sample *>::iterator itSample = pSamples.begin();
+      itSample < pSamples.end();
+      itSample++)
+ {
+  Proposition *vProp = (*itSample)->getProp();
+  Constituent vCnstnt = (*itSample)->getCnstntToken();
+
+  vLength += vProp->getPredCnstnt()->getPathTo(vCnstnt).size();
+
+  WordPtr vDepArgWord = vCnstnt->getDepArgWord();
+  if (vDepArgWord == NULL)
+   continue;
+
+  DTNode vArgNode = vDepArgWord->getDTNode();
+  DTNode vPredNode = vProp->getPredWord()->getDTNode();
+
+  vLength += vArgNode->getRelPathTo(vPredNode).size();
+  vLength += vArgNode->getPOSPathTo(vPredNode).size();
+  vLength += vArgNode->getLemmaPathTo(vPredNode).size();
+  vLength += vArgNode->getPathLengthToLCA(vPredNode);
+  }
+
+ return vLength;
+}
+
+///---------------------------------------------------------------------
+void initBenchmarkResult(benchmarkResult &pResult, const string &pName)
+{
+ pResult.name = pName;
+ pResult.times.clear();
+ pResult.sentenceCount = 0;
+ pResult.sampleCount = 0;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  writes the statistics of the times of the benchmark in milliseconds and
+ *  the median time per sentence and sample in microseconds
+ */
+void logBenchmarkResult(benchmarkResult &pResult, ostream &pStream)
+{
+ vector<double> vTimes = pResult.times;
+ sort(vTimes.begin(), vTimes.end());
+
+ double vMean = 0;
+ for (unsigned i = 0; i < vTimes.size(); i++)
+  vMean += vTimes[i];
+ vMean /= vTimes.size();
+
+ double vVariance = 0;
+ for (unsigned i = 0; i < vTimes.size(); i++)
+  vVariance += (vTimes[i] - vMean) * (vTimes[i] - vMean);
+ vVariance /= vTimes.size();
+
+ double vMedian = (vTimes.size() % 2 == 1) ? vTimes[vTimes.size() / 2] :
+                  (vTimes[vTimes.size() / 2 - 1] + vTimes[vTimes.size() / 2]) / 2;
+
+ pStream << setw(28) << pResult.name << fixed << setprecision(3)
+         << setw(10) << vTimes.front() * 1e3 << setw(10) << vMedian * 1e3
+         << setw(10) << vMean * 1e3 << setw(10) << sqrt(vVariance) * 1e3
+         << setw(10) << pResult.sentenceCount << setprecision(2);
+
+ if (pResult.sentenceCount > 0)
+  pStream << setw(12) << vMedian * 1e6 / pResult.sentenceCount;
+ else
+  pStream << setw(12) << "-";
+
+ pStream << setw(10) << pResult.sampleCount;
+
+ if (pResult.sampleCount > 0)
+  pStream << setw(10) << vMedian * 1e6 / pResult.sampleCount;
+ else
+  pStream << setw(10) << "-";
+
+ pStream << endl;
+ pStream.unsetf(ios_base::floatfield);
+ pStream << setprecision(6);
+}
@@ -14,20 +14,27 @@
 #include "CoNLLLoader.hpp"
 #include "ULoader.hpp"
 #include "CoNLLSaver.hpp"
+#include "GzStream.hpp"
 #include "Sentence.hpp"
 #include "SampleGenerator.hpp"
 #include "Sample.hpp"
 #include "Utils.hpp"
 #include "Constants.hpp"
 #include "Classifier.hpp"
+#include "Sweep.hpp"
+#include "Metrics.hpp"
+#include "FeatureProfiler.hpp"
+#include "FeatureHasher.hpp"
+#include "MemoryAccount.hpp"
+#include "Logging.hpp"
 
 using namespace std;
 
 
 short loadCoNLLSentences(vector<Sentence *> &, string &, string &, string &,
-                         string &, unsigned int, ofstream &);
+                         string &, unsigned int, bool, unsigned short, ofstream &);
 short loadUnlabeledSentences(vector<Sentence *> &, string &, string &,
-                             unsigned int, ofstream &);
+                             unsigned int, bool, unsigned short, ofstream &);
 short generateLabeledSamples(vector<Sentence *> &, unsigned int, unsigned int, 
                              unsigned short [], string &, bool, bool, ofstream &);
 short generateTestSamples(vector<Sentence *> &, unsigned short [], 
@@ -40,14 +47,16 @@ void coTrainCommon(vector<ZMEClassifier> &, vector<Sentence *> &, vector<Sentenc
                    unsigned short, unsigned short, unsigned short, unsigned short,
                    double, double, unsigned short, bool, unsigned short, 
                    unsigned short, unsigned short, unsigned short, string &, 
-                   string &, string &, ofstream &);
+                   string &, string &, const string &, 
+                   ofstream &);
 void coTrainSeparate(vector<ZMEClassifier> &, vector<Sentence *> &, vector<Sentence *> &,
                      vector<Sentence *> &, vector<Sentence *> &, vector<Sentence *> &,
                      unsigned short, string &, double, bool, unsigned int, 
                      unsigned short, unsigned short, unsigned short, 
                      unsigned short, double, unsigned short, bool, 
                      unsigned short, unsigned short, unsigned short, 
-                     unsigned short, string &, string &, string &, ofstream &);
+                     unsigned short, string &, string &, string &, const string &, 
+                     ofstream &);
 unsigned int addToTraining(vector<Sentence *> &, vector<Sentence *> &, 
                            unsigned int);
 unsigned int moveToTraining(vector<Sentence *> &, vector<Sentence *> &, 
@@ -85,8 +94,24 @@ static void usage(const char * execName)
       << " <-fs[Feature sets for each view (e.g. -fs 1,3: 1 for view 1 and 3 for view 2)]>" << endl
       << " <-go[Global optimization (0: no; 1: yes)]>" << endl 
       << " <-mi[ME iteration number]>" << endl 
-      << " <-mp[ME parameter estimation method (lbfgs or gis)]>" << endl 
+      << " <-mp[ME parameter estimation method (lbfgs, gis, sgd or perceptron)]>" << endl 
+      << " <-mt[ME training threads (0: maxent trainer; n: built-in parallel trainer with n threads)]>" << endl 
+      << " <-fc[ME feature count cutoff (features seen less are dropped; 0: no cutoff)]>" << endl 
+      << " <-ns[Negative sampling rate per proposition in training (0: use all negatives)]>" << endl 
+      << " <-it[Argument identification threshold of two-stage labeling (0: no identification stage)]>" << endl 
+      << " <-ph[Precompute head words, subcat and governing category of constituents at load time (0: no; 1: yes)]>" << endl 
+      << " <-lt[Number of threads loading sentence-aligned chunks of data in parallel (0 or 1: sequential loading)]>" << endl 
+      << " <-sw[Sweep configuration file (one worker is forked per configuration after loading data and training the base classifier)]>" << endl 
+      << " <-swj[Maximum number of sweep workers running at the same time (0: number of cores)]>" << endl 
+      << " <-swm[Memory budget of sweep workers in MB (0: no limit)]>" << endl 
+      << " <-mf[Metrics file the phase times and counts of each iteration are written into (one JSON record per line)]>" << endl 
+      << " <-fp[Profile the cost of feature extraction per feature type into the sample generation analysis logs (0: no; 1: yes)]>" << endl 
+      << " <-as[Save output props files asynchronously, overlapping the next steps (0: no; 1: yes)]>" << endl 
+      << " <-zo[Compress output props files and selection logs by gzip (0: no; 1: yes)]>" << endl 
+      << " <-fh[Feature hashing bits (0: no hashing; k: 2^k feature buckets)]>" << endl 
+      << " <-hs[Signed feature hashing (0: no; 1: yes)]>" << endl 
       << " <-g[Gaussian parameter]>" << endl 
+      << " <-fe[Fast ME evaluation by built-in scorer (0: no; 1: yes)]>" << endl 
       << " <-sc[Selection criterion(0: no selection;" << endl
       << "                          1: agreement-based;" << endl
       << "                          2: confidence-based)]>" << endl 
@@ -174,7 +199,23 @@ int main(int argc, char ** argv)
  bool vGlobalOpt = false;
  unsigned int vMEIterations = 350;
  string vMEPEMethod = "lbfgs";
+ unsigned short vMEThreads = 0;
+ unsigned int vFeatureCutoff = 0;
+ double vNegativeRate = 0;
+ double vIdThreshold = 0;
+ bool vPrecomputeTrees = false;
+ unsigned short vLoadThreads = 0;
+ string vSweepFile;
+ unsigned short vSweepWorkers = 0;
+ unsigned long vSweepMemory = 0;
+ string vMetricsFile;
+ bool vProfileFeatures = false;
+ bool vAsyncSaving = false;
+ bool vCompressOutput = false;
+ unsigned short vHashingBits = 0;
+ bool vSignedHashing = false;
  double vGaussian = 1;
+ bool vFastEval = false;
  unsigned int vPoolSize = 0;
  unsigned short vSelection = 0;
  unsigned short vCLSelMethod= AGREEMENT_CONFIDENCE;
@@ -197,7 +238,7 @@ const string ctmpStr  = "help";
  
  string tmpLogFile = LOG_COTRAINING_OUTPUT_FILE_PREFIX;
  tmpLogFile += ".1.[" + getLocalTimeStr("YYYY-MM-DD-HH-MM") + "].log";
- ofstream log (tmpLogFile.c_str());
+ AsyncLogFile log (tmpLogFile.c_str());
  if (!log)
   cerr << "Cannot create output log file: " << tmpLogFile
        << endl; 
@@ -297,12 +338,108 @@ const string ctmpStr  = "help";
    continue; 
    }
    
+  if (vcParam[0] == "-mt")
+  { 
+   vMEThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fc")
+  { 
+   vFeatureCutoff = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ns")
+  { 
+   vNegativeRate = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-it")
+  { 
+   vIdThreshold = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ph")
+  { 
+   vPrecomputeTrees = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-lt")
+  { 
+   vLoadThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-sw")
+  { 
+   vSweepFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-swj")
+  { 
+   vSweepWorkers = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-swm")
+  { 
+   vSweepMemory = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-mf")
+  { 
+   vMetricsFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-fp")
+  { 
+   vProfileFeatures = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-as")
+  { 
+   vAsyncSaving = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-zo")
+  { 
+   vCompressOutput = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fh")
+  { 
+   vHashingBits = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-hs")
+  { 
+   vSignedHashing = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-g")
   { 
    vGaussian = strToFloat(vcParam[1]);
    continue;
    }
    
+  if (vcParam[0] == "-fe")
+  { 
+   vFastEval = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-p")
   { 
    vPoolSize = strToInt(vcParam[1]);
@@ -497,9 +634,23 @@ const string ctmpStr  = "help";
   if (vSelection  == 1)
    vSelection = 2;
 
+ if (!vMetricsFile.empty())
+  if (MetricsRecorder::open(vMetricsFile) != 0)
+   return -1;
+ 
+ // the record of iteration 0 covers loading the data and training and 
+ // testing the base classifier(s)
+ MetricsRecorder::beginRecord(0);
+
+ FeatureProfiler::setEnabled(vProfileFeatures);
+ CoNLLSaver::setAsyncSaving(vAsyncSaving);
+ OGzStream::setCompression(vCompressOutput);
+ FeatureHasher::setHashing(vHashingBits, vSignedHashing);
+
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -514,12 +665,14 @@ const string ctmpStr  = "help";
  mout("\nLoading CoNLL labeled training data ...\n", cout, log);
  if (loadCoNLLSentences(vcLabeledSntncs, vLabeledWordsFile, 
                         vLabeledSyntChaFile, vLabeledSyntDepFile,
-                        vLabeledPropsFile, vSeedSize, log) != 0)
+                        vLabeledPropsFile, vSeedSize, 
+                        vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -532,31 +685,38 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLoading CoNLL WSJ development data ...\n", cout, log);
   if (loadCoNLLSentences(vcDevWSJSntncs, vDevWSJWordsFile, vDevWSJSyntChaFile, 
-                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, log) != 0)
+                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLoading CoNLL WSJ test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestWSJSntncs, vTestWSJWordsFile, vTestWSJSyntChaFile,
-                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, log) != 0)
+                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLoading CoNLL Brown test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestBrownSntncs, vTestBrownWordsFile, vTestBrownSyntChaFile,
-                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, log) != 0)
+                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -571,6 +731,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -579,6 +740,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nGenerating WSJ development samples ...\n", cout, log);
   if (generateTestSamples(vcDevWSJSntncs, vFeatureSets, vDevWSJWordsFile, true, false, log) != 0)
    return -1;
@@ -586,6 +748,7 @@ const string ctmpStr  = "help";
   
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nGenerating WSJ test samples ...\n", cout, log);
   if (generateTestSamples(vcTestWSJSntncs, vFeatureSets, vTestWSJWordsFile, true, false, log) != 0)
    return -1;
@@ -593,6 +756,7 @@ const string ctmpStr  = "help";
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nGenerating Brown test samples ...\n", cout, log);
   if (generateTestSamples(vcTestBrownSntncs, vFeatureSets, vTestBrownWordsFile, true, false, log) != 0)
    return -1;
@@ -601,6 +765,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -619,6 +784,11 @@ const string ctmpStr  = "help";
  */
  for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
  {
+  zmeClassifiers[cntView - 1].setFastEvaluation(vFastEval);
+  zmeClassifiers[cntView - 1].setTrainingThreads(vMEThreads);
+  zmeClassifiers[cntView - 1].setFeatureCutoff(vFeatureCutoff);
+  zmeClassifiers[cntView - 1].setNegativeSamplingRate(vNegativeRate);
+  zmeClassifiers[cntView - 1].setIdentificationThreshold(vIdThreshold);
   mout("\nTraining base classifier " + intToStr(cntView) + " (" + getLocalTimeStr() + ") ...\n", cout, log);
   zmeClassifiers[cntView - 1].train(vcLabeledSntncs, cntView, cntView, true,
                              1, vMEIterations, vMEPEMethod, vGaussian, true, 
@@ -630,6 +800,7 @@ const string ctmpStr  = "help";
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, log);
+  MemoryAccount::report(log);
   }
 
 
@@ -653,6 +824,7 @@ const string ctmpStr  = "help";
  {
   if (vTesting >= 1)
   {
+   PhaseGuard oPhase("dev");
    mout("\nLabeling development data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcDevWSJSntncs, cntView, vGlobalOpt, log);
    mout("Labeling development data is done! (" +
@@ -666,6 +838,7 @@ const string ctmpStr  = "help";
 
   if (vTesting >= 2)
   {
+   PhaseGuard oPhase("wsj");
    mout("\nLabeling WSJ test data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcTestWSJSntncs, cntView, vGlobalOpt, log);
    mout("Labeling WSJ test data is done! (" +
@@ -679,6 +852,7 @@ const string ctmpStr  = "help";
 
   if (vTesting >= 3)
   {
+   PhaseGuard oPhase("brown");
    mout("\nLabeling Brown test data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcTestBrownSntncs, cntView, vGlobalOpt, log);
    mout("Labeling Brown test data is done! (" +
@@ -694,6 +868,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLabeling development data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcDevWSJSntncs, CONFIDENECE_ONLY, vPreferedView, log);
   mout("\nLabeling development data is done!\n", cout, log);  
@@ -705,6 +880,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLabeling WSJ test data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcTestWSJSntncs, CONFIDENECE_ONLY, vPreferedView, log);
   mout("\nLabeling WSJ test data is done!\n", cout, log);  
@@ -716,6 +892,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLabeling Brown test data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcTestBrownSntncs, CONFIDENECE_ONLY, vPreferedView, log);
   mout("\nLabeling Brown test data is done!\n", cout, log);  
@@ -728,6 +905,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -737,6 +915,9 @@ const string ctmpStr  = "help";
  // if the specified size for unlabeled data is 0, ignore co-training
  if (vUnlabeledSize == 0)
  {
+  CoNLLSaver::waitPending();
+  MetricsRecorder::endRecord();
+  MetricsRecorder::close();
   cout << endl;
   log.close();
   return 0;
@@ -751,14 +932,17 @@ const string ctmpStr  = "help";
  
  vector<Sentence *> vcUnlabeledSntncs;
 
+ MetricsRecorder::beginPhase("unlabeled");
  mout("\nLoading unlabeled training data ...\n", cout, log);
  if (loadUnlabeledSentences(vcUnlabeledSntncs, vUnlabeledDataFile,
-                            vUnlabeledSyntDepFile, vUnlabeledSize, log) != 0)
+                            vUnlabeledSyntDepFile, vUnlabeledSize, 
+                            vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  /**
   *  generating unlabeled training samples for co-training
@@ -766,17 +950,127 @@ const string ctmpStr  = "help";
 
  if (generateUnlabeledSamples(vcUnlabeledSntncs, vFeatureSets, vUnlabeledDataFile, false, false, log) != 0)
   return -1;
+ MetricsRecorder::endPhase();
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
+
+ MetricsRecorder::endRecord();
+
 
+/**
+ *  sweeping the configurations
+ * 
+ *  A worker is forked per configuration to continue as a single run with
+ *  the parameters of its configuration, writing its own log and outputs 
+ *  (suffixed by the configuration label); the parent returns after all the
+ *  workers have finished.
+ */
 
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ // the pool selection logs of a configuration are suffixed by its label
+ string vSelectionLogSuffix = ".log";
  
- vStartClk = clock();
- time(&vStartTime);
+ if (!vSweepFile.empty())
+ {
+  vector<SweepConfig> vcSweepConfigs;
+  if (loadSweepConfigs(vSweepFile, vcSweepConfigs) != 0)
+   return -1;
+  
+  // the outputs of the base classifier(s) should be complete before forking
+  CoNLLSaver::waitPending();
+  
+  SweepRunner oSweepRunner(vSweepWorkers, vSweepMemory);
+  // the log is written synchronously while forking, since its writer
+  // thread is not inherited by the workers
+  log.setAsync(false);
+  int vSweepConfig = oSweepRunner.forkWorkers(vcSweepConfigs, log);
+  log.setAsync(true);
+  if (vSweepConfig < 0)
+  {
+   mout("\nSweeping is done! (" + intToStr(oSweepRunner.getFailedCount()) + 
+        " configurations failed)\n", cout, log);
+   cout << endl;
+   MetricsRecorder::close();
+   log.close();
+   return (oSweepRunner.getFailedCount() == 0) ? 0 : -1;
+   }
+  
+  SweepConfig &vConfig = vcSweepConfigs[vSweepConfig];
+  
+  log.close();
+  tmpLogFile.insert(tmpLogFile.size() - 4, "." + vConfig.label);
+  log.open(tmpLogFile.c_str());
+  if (!log)
+   cerr << "Cannot create output log file: " << tmpLogFile
+        << endl; 
+  
+  if (MetricsRecorder::isOpen())
+   if (MetricsRecorder::open(vMetricsFile + "." + vConfig.label) != 0)
+    return -1;
+  
+  for (unsigned short i = 0; i < vConfig.params.size(); i++)
+  {
+   vector<string> &vcSweepParam = vConfig.params[i];
+   log << vcSweepParam[0] << " " << vcSweepParam[1] << endl;
+   
+   if (vcSweepParam[0] == "-c")
+    vCoTrainingMethod = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-p")
+    vPoolSize = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-sc")
+    vSelection = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-cl")
+    vCLSelMethod = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pu")
+    vPoolUsage = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pt")
+    vProbThreshold = strToFloat(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-at")
+    vAgreeThreshold = strToFloat(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-nt")
+    vNumberThreshold = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-r")
+    vRemoveLabeled = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-si")
+    vSTIterations = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pq")
+    vPoolQuality = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-ls")
+    vLogSelection = strToInt(vcSweepParam[1]);
+   else
+   {
+    cerr << "Parameter " << vcSweepParam[0] << " cannot be swept!" << endl;
+    return -1;
+    }
+   }
+  
+  if (vCoTrainingMethod == 2)
+   if (vSelection  == 1)
+    vSelection = 2;
+  
+  // the outputs of the base classifiers (iteration 0) are written once by
+  // the parent, so they are copied for the configuration to have its
+  // complete series of outputs (view 0 for the common labels)
+  string *vOutputs[] = {&vDevWSJOutput, &vTestWSJOutput, &vTestBrownOutput};
+  for (unsigned short i = 0; i < 3; i++)
+  {
+   string vSuffixedOutput = *vOutputs[i] + "." + vConfig.label;
+   if (vTesting > i)
+    for (unsigned short cntView = 0; cntView <= FEATURE_VIEW_COUNT; cntView++)
+     if (CoNLLSaver::copyProps(*vOutputs[i] + "." + intToStr(cntView) + ".0",
+                               vSuffixedOutput + "." + intToStr(cntView) + ".0") != 0)
+      return -1;
+   *vOutputs[i] = vSuffixedOutput;
+   }
+  vSelectionLogSuffix = "." + vConfig.label + ".log";
+  for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
+   zmeClassifiers[cntView - 1].setTmpFileSuffix("." + vConfig.label);
+  }
+
+
+ Timer oTimer;
   
  mout("\nCo-training started at " + getLocalTimeStr() + " ...\n", cout, log);
  if (vCoTrainingMethod == 1)
@@ -786,7 +1080,7 @@ const string ctmpStr  = "help";
                 vSelection, vCLSelMethod, vPreferedView, vPoolUsage, vProbThreshold, 
                 vAgreeThreshold, vNumberThreshold, vRemoveLabeled, vSTIterations, 
                 vPoolQuality, vLogSelection, vTesting, vDevWSJOutput, vTestWSJOutput, 
-                vTestBrownOutput, log);
+                vTestBrownOutput, vSelectionLogSuffix, log);
  else if (vCoTrainingMethod == 2)
   coTrainSeparate(zmeClassifiers, vcLabeledSntncs, vcUnlabeledSntncs, 
                   vcDevWSJSntncs, vcTestWSJSntncs, vcTestBrownSntncs,
@@ -794,24 +1088,24 @@ const string ctmpStr  = "help";
                   vSelection, vCLSelMethod, vPreferedView, vPoolUsage, vProbThreshold, 
                   vNumberThreshold, vRemoveLabeled, vSTIterations, vPoolQuality, 
                   vLogSelection, vTesting, vDevWSJOutput, vTestWSJOutput, 
-                  vTestBrownOutput, log);
+                  vTestBrownOutput, vSelectionLogSuffix, log);
  
+ CoNLLSaver::waitPending();
  mout("\nCo-training is done at " + getLocalTimeStr() + "! ", cout, log);
- vEndClk = clock();
- mout("(" + floatToStr(((double) (vEndClk - vStartClk)) / (CLOCKS_PER_SEC * 60)), 
-      cout, log);
- time(&vEndTime);
- mout(" min/" + floatToStr(difftime(vEndTime, vStartTime) / 60) + " min)\n",
+ oTimer.stop();
+ mout("(" + floatToStr(oTimer.getCPUTime() / 60), cout, log);
+ mout(" min/" + floatToStr(oTimer.getElapsedTime() / 60) + " min)\n",
       cout, log);
 
- log.close();
+ MetricsRecorder::close();
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  cout << endl;
-
+ log.close();
 }
 
 
@@ -879,7 +1173,8 @@ void logSamples(vector<Sample *> &pSamples)
            << " [" << (*itSample)->getZMEContextStr(1) << "]"
            << endl;
  
-   cout << "\r" << cntSample << " samples logged" << flush;
+   if (Progress::isDue(itSample + 1 == pSamples.end()))
+    cout << "\r" << cntSample << " samples logged" << flush;
    }
   strmLog.close(); 
   }
@@ -889,13 +1184,16 @@ void logSamples(vector<Sample *> &pSamples)
 
 short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile, 
                          string &pSyntFile, string &pDepFile, string &pPropsFile, 
-                         unsigned int pMaxSntnc, ofstream &pLog)
+                         unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                         unsigned short pLoadThreads, ofstream &pLog)
 {
  CoNLLLoader oCoNLLLoader(pWordsFile, 
                           pSyntFile,
                           pDepFile,
                           pPropsFile, 
                           pMaxSntnc);
+ oCoNLLLoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oCoNLLLoader.setThreadCount(pLoadThreads);
 
  if (oCoNLLLoader.loadData(pSentences) == 0)
  {
@@ -921,9 +1219,12 @@ short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile,
 
 short loadUnlabeledSentences(vector<Sentence *> &pSentences, 
                              string &pDataFile, string &pSyntDepFile, 
-                             unsigned int pMaxSntnc, ofstream &pLog)
+                             unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                             unsigned short pLoadThreads, ofstream &pLog)
 {
  ULoader oULoader(pDataFile, pSyntDepFile, pMaxSntnc);
+ oULoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oULoader.setThreadCount(pLoadThreads);
 
  if (oULoader.loadData(pSentences) == 0)
  {
@@ -1145,7 +1446,8 @@ void setSelectedPrdLabeling(vector<Sentence *> &pcLabeledSntncs,
       itSentence++)
  {     
   (*itSentence)->setSelectedPrdLabels(pSelectionMethod, pPreferedView);
-  cout << "\r" << (itSentence - pcLabeledSntncs.begin() + 1) << " sentences processed" << flush;
+  if (Progress::isDue(itSentence + 1 == pcLabeledSntncs.end()))
+   cout << "\r" << (itSentence - pcLabeledSntncs.begin() + 1) << " sentences processed" << flush;
   }
  pLog << pcLabeledSntncs.size() << " sentences processed" << flush;
 
@@ -1185,6 +1487,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
                    string &pDevWSJOutput,
                    string &pTestWSJOutput,
                    string &pTestBrownOutput,
+                   const string &pSelectionLogSuffix,
                    ofstream &pLog)
 {
  unsigned vSeedSize = pTrainingSntncs.size();
@@ -1269,11 +1572,13 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
   {
    mout("\nIteration " + intToStr(cntIteration) +
         " (Pool " + intToStr(cntPool) + "):\n", cout, pLog);
+   MetricsRecorder::beginRecord(cntIteration);
 
    /**
     *  labeling unlabeled samples (sentence-based)
     */
  
+   MetricsRecorder::beginPhase("pool");
    for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
    {
     mout("\nLabeling unlabeled samples with classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
@@ -1286,11 +1591,13 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
    mout("\nLabeling unlabeled samples with selected common labels ...\n", cout, pLog);
    setSelectedPrdLabeling(vPool, pCLSelMethod, pPreferedView, pLog);
    mout("\nLabeling unlabeled samples is done!\n", cout, pLog);  
+   MetricsRecorder::endPhase();
    
    /**
     *  selecting and adding newly labeled data to training set
     */
  
+   MetricsRecorder::beginPhase("select");
    mout("\nAdding newly labeled data to training set ...\n", cout, pLog);
    
    unsigned int vAddedCount = 0;
@@ -1301,7 +1608,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
                                  pProbThreshold, pAgreeThreshold, pNumberThreshold,
                                  DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                  pLogSelection, LOG_POOL_SELECTION_FILE_NAME +
-                                 intToStr(cntIteration) + ".log",
+                                 intToStr(cntIteration) + pSelectionLogSuffix,
                                  pLog);
    else 
     // Note:
@@ -1318,6 +1625,8 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount) +
         " sentences)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount);
+   MetricsRecorder::endPhase();
  
    // Only if any new labeled data is added to training set, train a new
    // classifier 
@@ -1362,6 +1671,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     {
      if (pTesting >= 1)
      {
+      PhaseGuard oPhase("dev");
       mout("\nLabeling development data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pDevWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1376,6 +1686,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 2)
      {
+      PhaseGuard oPhase("wsj");
       mout("\nLabeling WSJ test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1390,6 +1701,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 3)
      {
+      PhaseGuard oPhase("brown");
       mout("\nLabeling Brown test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestBrownSntncs, cntView, pGlobalOpt, pLog);
@@ -1415,6 +1727,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     
     if (pTesting >= 1)
     {
+     PhaseGuard oPhase("dev");
      mout("\nLabeling development data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pDevWSJSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling development data is done!\n", cout, pLog);  
@@ -1425,6 +1738,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 2)
     {
+     PhaseGuard oPhase("wsj");
      mout("\nLabeling WSJ test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestWSJSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling WSJ test data is done!\n", cout, pLog);  
@@ -1435,6 +1749,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 3)
     {
+     PhaseGuard oPhase("brown");
      mout("\nLabeling Brown test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestBrownSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling Brown test data is done!\n", cout, pLog);  
@@ -1479,6 +1794,8 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
          cout, pLog);
    mout("\n", cout, pLog);
   
+   MetricsRecorder::endRecord();
+
    /**
     *  Checking stop criterion for looping inside the pool
     */
@@ -1505,6 +1822,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, pLog);
+  MemoryAccount::report(pLog);
 
   }
 }
@@ -1549,6 +1867,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                      string &pDevWSJOutput,
                      string &pTestWSJOutput,
                      string &pTestBrownOutput,
+                     const string &pSelectionLogSuffix,
                      ofstream &pLog)
 {
  unsigned short vSeedSize = pTrainingSntncs.size();
@@ -1663,11 +1982,13 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
    mout("\nIteration " + intToStr(cntIteration) +
         " (Pool " + intToStr(cntPool1) + " of view 1 and Pool " +
         intToStr(cntPool2) + " of view 2):\n", cout, pLog);
+   MetricsRecorder::beginRecord(cntIteration);
 
    /**
     *  labeling unlabeled samples (sentence-based)
     */
  
+   MetricsRecorder::beginPhase("pool");
    mout("\nLabeling unlabeled samples with classifier of view 1 ...\n", cout, pLog);
    pZMEClassifiers[0].classify(vPool1, 1, pGlobalOpt, pLog);
    mout("Labeling unlabeled samples is done! (" +
@@ -1679,11 +2000,13 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
    mout("Labeling unlabeled samples is done! (" +
         floatToStr(pZMEClassifiers[1].getElapsedTime()) + " sec)\n",
         cout, pLog);
+   MetricsRecorder::endPhase();
 
    /**
     *  selecting and adding newly labeled data to training set
     */
  
+   MetricsRecorder::beginPhase("select");
    mout("\nAdding newly labeled data by view 1 to training set of view 2 ...\n", cout, pLog);
    
    unsigned int vAddedCount2 = 0;
@@ -1694,7 +2017,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                                   pProbThreshold, 0, pNumberThreshold,
                                   DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                   pLogSelection, string(LOG_POOL_SELECTION_FILE_NAME) +
-                                  ".1." + intToStr(cntIteration) + ".log",
+                                  ".1." + intToStr(cntIteration) + pSelectionLogSuffix,
                                   pLog);
    else 
     // Note:
@@ -1711,6 +2034,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount2) +
         " sentences)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount2);
  
    mout("\nAdding newly labeled data by view 2 to training set of view 1 ...\n", cout, pLog);
    
@@ -1722,7 +2046,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                                   pProbThreshold, 0, pNumberThreshold,
                                   DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                   pLogSelection, string(LOG_POOL_SELECTION_FILE_NAME) +
-                                  ".2." + intToStr(cntIteration) + ".log",
+                                  ".2." + intToStr(cntIteration) + pSelectionLogSuffix,
                                   pLog);
    else 
     //  Refer to the comments for 1st view above.
@@ -1730,6 +2054,8 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount1) +
         " sentences)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount1);
+   MetricsRecorder::endPhase();
  
    
    // Only if any new labeled data is added to both training set, train
@@ -1775,6 +2101,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     {
      if (pTesting >= 1)
      {
+      PhaseGuard oPhase("dev");
       mout("\nLabeling development data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pDevWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1789,6 +2116,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 2)
      {
+      PhaseGuard oPhase("wsj");
       mout("\nLabeling WSJ test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1803,6 +2131,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 3)
      {
+      PhaseGuard oPhase("brown");
       mout("\nLabeling Brown test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestBrownSntncs, cntView, pGlobalOpt, pLog);
@@ -1828,6 +2157,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
     if (pTesting >= 1)
     {
+     PhaseGuard oPhase("dev");
      mout("\nLabeling development data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pDevWSJSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling development data is done!\n", cout, pLog);  
@@ -1838,6 +2168,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 2)
     {
+     PhaseGuard oPhase("wsj");
      mout("\nLabeling WSJ test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestWSJSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling WSJ test data is done!\n", cout, pLog);   
@@ -1848,6 +2179,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 3)
     {
+     PhaseGuard oPhase("brown");
      mout("\nLabeling Brown test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestBrownSntncs, CONFIDENECE_ONLY, pPreferedView, pLog);
      mout("\nLabeling Brown test data is done!\n", cout, pLog);  
@@ -1897,6 +2229,8 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
 
    mout("Data used so far: " + intToStr(vDataUsedSofar) + " sentences for training view 2\n", cout, pLog);
    
+   MetricsRecorder::endRecord();
+
    /**
     *  Checking stop criterion for looping inside the pool
     */
@@ -1930,6 +2264,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, pLog);
+  MemoryAccount::report(pLog);
 
   }
 }
@@ -2108,9 +2443,9 @@ unsigned int selectAndMoveAgreed(vector<Sentence *> &pPool,
                                  string &pLogFileName,
                                  ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  sort(pPool.begin(), pPool.end(), isMoreAgreedLabeling);
  
@@ -2180,7 +2515,7 @@ unsigned int selectAndMoveAgreed(vector<Sentence *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -2204,9 +2539,9 @@ unsigned int selectAndMoveConfident(vector<Sentence *> &pPool,
                                     string &pLogFileName,
                                     ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // Remember to always set the value of this global variable before using
  // the isMoreLikelyLabeling() and isMoreLikelyLabel() functions to determine
@@ -2285,7 +2620,7 @@ unsigned int selectAndMoveConfident(vector<Sentence *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -2312,9 +2647,9 @@ unsigned int selectAndMove(vector<Sentence *> &pPool,
                            string &pLogFileName,
                            ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // Remember to always set the value of this global variable before using
  // the isMoreLikelyLabeling() and isMoreLikelyLabel() functions to determine
@@ -2392,7 +2727,7 @@ unsigned int selectAndMove(vector<Sentence *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -14,20 +14,27 @@
 #include "CoNLLLoader.hpp"
 #include "ULoader.hpp"
 #include "CoNLLSaver.hpp"
+#include "GzStream.hpp"
 #include "Sentence.hpp"
 #include "SampleGenerator.hpp"
 #include "Sample.hpp"
 #include "Utils.hpp"
 #include "Constants.hpp"
 #include "Classifier.hpp"
+#include "Sweep.hpp"
+#include "Metrics.hpp"
+#include "FeatureProfiler.hpp"
+#include "FeatureHasher.hpp"
+#include "MemoryAccount.hpp"
+#include "Logging.hpp"
 
 using namespace std;
 
 
 short loadCoNLLSentences(vector<Sentence *> &, string &, string &, string &,
-                         string &, unsigned int, ofstream &);
+                         string &, unsigned int, bool, unsigned short, ofstream &);
 short loadUnlabeledSentences(vector<Sentence *> &, string &, string &,
-                             unsigned int, ofstream &);
+                             unsigned int, bool, unsigned short, ofstream &);
 short generateLabeledSamples(vector<Sentence *> &, vector<Sample *> &,
                              unsigned int, unsigned int, unsigned short [],
                              string &, bool, bool, ofstream &);
@@ -41,13 +48,15 @@ void coTrainCommon(vector<ZMEClassifier> &, vector<Sample *> &, vector<Sample *>
                    unsigned short, unsigned short, unsigned short,
                    double, unsigned short, bool, unsigned short, 
                    unsigned short, unsigned short, string &, 
-                   string &, string &, ofstream &);
+                   string &, string &, const string &, 
+                   ofstream &);
 void coTrainSeparate(vector<ZMEClassifier> &, vector<Sample *> &, vector<Sample *> &,
                      vector<Sentence *> &, vector<Sentence *> &, vector<Sentence *> &,
                      unsigned short, string &, double, bool, unsigned int, 
                      unsigned short, unsigned short, unsigned short, 
                      double, unsigned short, bool, unsigned short, unsigned short, 
-                     unsigned short, string &, string &, string &, ofstream &);
+                     unsigned short, string &, string &, string &, const string &, 
+                     ofstream &);
 unsigned int addToTraining(vector<Sample *> &, vector<Sample *> &, 
                            unsigned int);
 unsigned int moveToTraining(vector<Sample *> &, vector<Sample *> &, 
@@ -83,8 +92,24 @@ static void usage(const char * execName)
       << " <-fs[Feature sets for each view (e.g. -fs 1,3: 1 for view 1 and 3 for view 2)]>" << endl
       << " <-go[Global optimization (0: no; 1: yes)]>" << endl 
       << " <-mi[ME iteration number]>" << endl 
-      << " <-mp[ME parameter estimation method (lbfgs or gis)]>" << endl 
+      << " <-mp[ME parameter estimation method (lbfgs, gis, sgd or perceptron)]>" << endl 
+      << " <-mt[ME training threads (0: maxent trainer; n: built-in parallel trainer with n threads)]>" << endl 
+      << " <-fc[ME feature count cutoff (features seen less are dropped; 0: no cutoff)]>" << endl 
+      << " <-ns[Negative sampling rate per proposition in training (0: use all negatives)]>" << endl 
+      << " <-it[Argument identification threshold of two-stage labeling (0: no identification stage)]>" << endl 
+      << " <-ph[Precompute head words, subcat and governing category of constituents at load time (0: no; 1: yes)]>" << endl 
+      << " <-lt[Number of threads loading sentence-aligned chunks of data in parallel (0 or 1: sequential loading)]>" << endl 
+      << " <-sw[Sweep configuration file (one worker is forked per configuration after loading data and training the base classifier)]>" << endl 
+      << " <-swj[Maximum number of sweep workers running at the same time (0: number of cores)]>" << endl 
+      << " <-swm[Memory budget of sweep workers in MB (0: no limit)]>" << endl 
+      << " <-mf[Metrics file the phase times and counts of each iteration are written into (one JSON record per line)]>" << endl 
+      << " <-fp[Profile the cost of feature extraction per feature type into the sample generation analysis logs (0: no; 1: yes)]>" << endl 
+      << " <-as[Save output props files asynchronously, overlapping the next steps (0: no; 1: yes)]>" << endl 
+      << " <-zo[Compress output props files and selection logs by gzip (0: no; 1: yes)]>" << endl 
+      << " <-fh[Feature hashing bits (0: no hashing; k: 2^k feature buckets)]>" << endl 
+      << " <-hs[Signed feature hashing (0: no; 1: yes)]>" << endl 
       << " <-g[Gaussian parameter]>" << endl 
+      << " <-fe[Fast ME evaluation by built-in scorer (0: no; 1: yes)]>" << endl 
       << " <-sc[Selection criterion(0: no selection;" << endl
       << "                          1: agreement-based;" << endl
       << "                          2: confidence-based)]>" << endl 
@@ -169,7 +194,23 @@ int main(int argc, char ** argv)
  bool vGlobalOpt = false;
  unsigned int vMEIterations = 350;
  string vMEPEMethod = "lbfgs";
+ unsigned short vMEThreads = 0;
+ unsigned int vFeatureCutoff = 0;
+ double vNegativeRate = 0;
+ double vIdThreshold = 0;
+ bool vPrecomputeTrees = false;
+ unsigned short vLoadThreads = 0;
+ string vSweepFile;
+ unsigned short vSweepWorkers = 0;
+ unsigned long vSweepMemory = 0;
+ string vMetricsFile;
+ bool vProfileFeatures = false;
+ bool vAsyncSaving = false;
+ bool vCompressOutput = false;
+ unsigned short vHashingBits = 0;
+ bool vSignedHashing = false;
  double vGaussian = 1;
+ bool vFastEval = false;
  unsigned int vPoolSize = 0;
  unsigned short vSelection = 0;
  unsigned short vCLSelMethod = AGREEMENT_CONFIDENCE;
@@ -189,7 +230,7 @@ const string ctmpStr  = "help";
  
  string tmpLogFile = LOG_COTRAINING_OUTPUT_FILE_PREFIX;
  tmpLogFile += ".2.[" + getLocalTimeStr("YYYY-MM-DD-HH-MM") + "].log";
- ofstream log (tmpLogFile.c_str());
+ AsyncLogFile log (tmpLogFile.c_str());
  if (!log)
   cerr << "Cannot create output log file: " << tmpLogFile
        << endl; 
@@ -289,12 +330,108 @@ const string ctmpStr  = "help";
    continue; 
    }
    
+  if (vcParam[0] == "-mt")
+  { 
+   vMEThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fc")
+  { 
+   vFeatureCutoff = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ns")
+  { 
+   vNegativeRate = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-it")
+  { 
+   vIdThreshold = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ph")
+  { 
+   vPrecomputeTrees = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-lt")
+  { 
+   vLoadThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-sw")
+  { 
+   vSweepFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-swj")
+  { 
+   vSweepWorkers = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-swm")
+  { 
+   vSweepMemory = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-mf")
+  { 
+   vMetricsFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-fp")
+  { 
+   vProfileFeatures = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-as")
+  { 
+   vAsyncSaving = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-zo")
+  { 
+   vCompressOutput = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fh")
+  { 
+   vHashingBits = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-hs")
+  { 
+   vSignedHashing = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-g")
   { 
    vGaussian = strToFloat(vcParam[1]);
    continue;
    }
    
+  if (vcParam[0] == "-fe")
+  { 
+   vFastEval = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-p")
   { 
    vPoolSize = strToInt(vcParam[1]);
@@ -471,9 +608,23 @@ const string ctmpStr  = "help";
   if (vSelection  == 1)
    vSelection = 2;
 
+ if (!vMetricsFile.empty())
+  if (MetricsRecorder::open(vMetricsFile) != 0)
+   return -1;
+ 
+ // the record of iteration 0 covers loading the data and training and 
+ // testing the base classifier(s)
+ MetricsRecorder::beginRecord(0);
+
+ FeatureProfiler::setEnabled(vProfileFeatures);
+ CoNLLSaver::setAsyncSaving(vAsyncSaving);
+ OGzStream::setCompression(vCompressOutput);
+ FeatureHasher::setHashing(vHashingBits, vSignedHashing);
+
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -488,12 +639,14 @@ const string ctmpStr  = "help";
  mout("\nLoading CoNLL labeled training data ...\n", cout, log);
  if (loadCoNLLSentences(vcLabeledSntncs, vLabeledWordsFile, 
                         vLabeledSyntChaFile, vLabeledSyntDepFile,
-                        vLabeledPropsFile, vSeedSize, log) != 0)
+                        vLabeledPropsFile, vSeedSize, 
+                        vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -506,31 +659,38 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLoading CoNLL WSJ development data ...\n", cout, log);
   if (loadCoNLLSentences(vcDevWSJSntncs, vDevWSJWordsFile, vDevWSJSyntChaFile, 
-                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, log) != 0)
+                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLoading CoNLL WSJ test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestWSJSntncs, vTestWSJWordsFile, vTestWSJSyntChaFile,
-                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, log) != 0)
+                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLoading CoNLL Brown test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestBrownSntncs, vTestBrownWordsFile, vTestBrownSyntChaFile,
-                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, log) != 0)
+                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -547,6 +707,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -555,6 +716,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nGenerating WSJ development samples ...\n", cout, log);
   if (generateTestSamples(vcDevWSJSntncs, vFeatureSets, vDevWSJWordsFile, true, false, log) != 0)
    return -1;
@@ -562,6 +724,7 @@ const string ctmpStr  = "help";
   
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nGenerating WSJ test samples ...\n", cout, log);
   if (generateTestSamples(vcTestWSJSntncs, vFeatureSets, vTestWSJWordsFile, true, false, log) != 0)
    return -1;
@@ -569,6 +732,7 @@ const string ctmpStr  = "help";
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nGenerating Brown test samples ...\n", cout, log);
   if (generateTestSamples(vcTestBrownSntncs, vFeatureSets, vTestBrownWordsFile, true, false, log) != 0)
    return -1;
@@ -577,6 +741,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -593,6 +758,11 @@ const string ctmpStr  = "help";
  */
  for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
  {
+  zmeClassifiers[cntView - 1].setFastEvaluation(vFastEval);
+  zmeClassifiers[cntView - 1].setTrainingThreads(vMEThreads);
+  zmeClassifiers[cntView - 1].setFeatureCutoff(vFeatureCutoff);
+  zmeClassifiers[cntView - 1].setNegativeSamplingRate(vNegativeRate);
+  zmeClassifiers[cntView - 1].setIdentificationThreshold(vIdThreshold);
   mout("\nTraining base classifier " + intToStr(cntView) + " (" + getLocalTimeStr() + ") ...\n", cout, log);
   zmeClassifiers[cntView - 1].train(vcLabeledSamples, cntView, cntView, true,
                              1, vMEIterations, vMEPEMethod, vGaussian, true, 
@@ -604,6 +774,7 @@ const string ctmpStr  = "help";
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, log);
+  MemoryAccount::report(log);
   }
 
 
@@ -624,6 +795,7 @@ const string ctmpStr  = "help";
  {
   if (vTesting >= 1)
   {
+   PhaseGuard oPhase("dev");
    mout("\nLabeling development data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcDevWSJSntncs, cntView, vGlobalOpt, log);
    mout("Labeling development data is done! (" +
@@ -637,6 +809,7 @@ const string ctmpStr  = "help";
 
   if (vTesting >= 2)
   {
+   PhaseGuard oPhase("wsj");
    mout("\nLabeling WSJ test data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcTestWSJSntncs, cntView, vGlobalOpt, log);
    mout("Labeling WSJ test data is done! (" +
@@ -650,6 +823,7 @@ const string ctmpStr  = "help";
 
   if (vTesting >= 3)
   {
+   PhaseGuard oPhase("brown");
    mout("\nLabeling Brown test data with base classifier " + intToStr(cntView) + " ...\n", cout, log);
    zmeClassifiers[cntView - 1].classify(vcTestBrownSntncs, cntView, vGlobalOpt, log);
    mout("Labeling Brown test data is done! (" +
@@ -665,6 +839,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLabeling development data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcDevWSJSntncs, CONFIDENECE_ONLY, log);
   mout("\nLabeling development data is done!\n", cout, log);  
@@ -676,6 +851,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLabeling WSJ test data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcTestWSJSntncs, CONFIDENECE_ONLY, log);
   mout("\nLabeling WSJ test data is done!\n", cout, log);  
@@ -687,6 +863,7 @@ const string ctmpStr  = "help";
 
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLabeling Brown test data with selected common labels ...\n", cout, log);
   setSelectedPrdLabeling(vcTestBrownSntncs, CONFIDENECE_ONLY, log);
   mout("\nLabeling Brown test data is done!\n", cout, log);  
@@ -699,6 +876,7 @@ const string ctmpStr  = "help";
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -708,6 +886,9 @@ const string ctmpStr  = "help";
  // if the specified size for unlabeled data is 0, ignore co-training
  if (vUnlabeledSize == 0)
  {
+  CoNLLSaver::waitPending();
+  MetricsRecorder::endRecord();
+  MetricsRecorder::close();
   cout << endl;
   log.close();
   return 0;
@@ -722,14 +903,17 @@ const string ctmpStr  = "help";
  
  vector<Sentence *> vcUnlabeledSntncs;
 
+ MetricsRecorder::beginPhase("unlabeled");
  mout("\nLoading unlabeled training data ...\n", cout, log);
  if (loadUnlabeledSentences(vcUnlabeledSntncs, vUnlabeledDataFile,
-                            vUnlabeledSyntDepFile, vUnlabeledSize, log) != 0)
+                            vUnlabeledSyntDepFile, vUnlabeledSize, 
+                            vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  /**
   *  generating unlabeled training samples for co-training
@@ -740,17 +924,123 @@ const string ctmpStr  = "help";
  if (generateUnlabeledSamples(vcUnlabeledSntncs, vcUnlabeledSamples, vFeatureSets, 
                               vUnlabeledDataFile, false, false, log) != 0)
   return -1;
+ MetricsRecorder::endPhase();
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
+
+ MetricsRecorder::endRecord();
+
 
+/**
+ *  sweeping the configurations
+ * 
+ *  A worker is forked per configuration to continue as a single run with
+ *  the parameters of its configuration, writing its own log and outputs 
+ *  (suffixed by the configuration label); the parent returns after all the
+ *  workers have finished.
+ */
 
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ // the pool selection logs of a configuration are suffixed by its label
+ string vSelectionLogSuffix = ".log";
  
- vStartClk = clock();
- time(&vStartTime);
+ if (!vSweepFile.empty())
+ {
+  vector<SweepConfig> vcSweepConfigs;
+  if (loadSweepConfigs(vSweepFile, vcSweepConfigs) != 0)
+   return -1;
+  
+  // the outputs of the base classifier(s) should be complete before forking
+  CoNLLSaver::waitPending();
+  
+  SweepRunner oSweepRunner(vSweepWorkers, vSweepMemory);
+  // the log is written synchronously while forking, since its writer
+  // thread is not inherited by the workers
+  log.setAsync(false);
+  int vSweepConfig = oSweepRunner.forkWorkers(vcSweepConfigs, log);
+  log.setAsync(true);
+  if (vSweepConfig < 0)
+  {
+   mout("\nSweeping is done! (" + intToStr(oSweepRunner.getFailedCount()) + 
+        " configurations failed)\n", cout, log);
+   cout << endl;
+   MetricsRecorder::close();
+   log.close();
+   return (oSweepRunner.getFailedCount() == 0) ? 0 : -1;
+   }
+  
+  SweepConfig &vConfig = vcSweepConfigs[vSweepConfig];
+  
+  log.close();
+  tmpLogFile.insert(tmpLogFile.size() - 4, "." + vConfig.label);
+  log.open(tmpLogFile.c_str());
+  if (!log)
+   cerr << "Cannot create output log file: " << tmpLogFile
+        << endl; 
+  
+  if (MetricsRecorder::isOpen())
+   if (MetricsRecorder::open(vMetricsFile + "." + vConfig.label) != 0)
+    return -1;
+  
+  for (unsigned short i = 0; i < vConfig.params.size(); i++)
+  {
+   vector<string> &vcSweepParam = vConfig.params[i];
+   log << vcSweepParam[0] << " " << vcSweepParam[1] << endl;
+   
+   if (vcSweepParam[0] == "-c")
+    vCoTrainingMethod = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-p")
+    vPoolSize = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-sc")
+    vSelection = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-cl")
+    vCLSelMethod = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pu")
+    vPoolUsage = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pt")
+    vProbThreshold = strToFloat(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-nt")
+    vNumberThreshold = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-r")
+    vRemoveLabeled = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-si")
+    vSTIterations = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-ls")
+    vLogSelection = strToInt(vcSweepParam[1]);
+   else
+   {
+    cerr << "Parameter " << vcSweepParam[0] << " cannot be swept!" << endl;
+    return -1;
+    }
+   }
+  
+  if (vCoTrainingMethod == 2)
+   if (vSelection  == 1)
+    vSelection = 2;
+  
+  // the outputs of the base classifiers (iteration 0) are written once by
+  // the parent, so they are copied for the configuration to have its
+  // complete series of outputs (view 0 for the common labels)
+  string *vOutputs[] = {&vDevWSJOutput, &vTestWSJOutput, &vTestBrownOutput};
+  for (unsigned short i = 0; i < 3; i++)
+  {
+   string vSuffixedOutput = *vOutputs[i] + "." + vConfig.label;
+   if (vTesting > i)
+    for (unsigned short cntView = 0; cntView <= FEATURE_VIEW_COUNT; cntView++)
+     if (CoNLLSaver::copyProps(*vOutputs[i] + "." + intToStr(cntView) + ".0",
+                               vSuffixedOutput + "." + intToStr(cntView) + ".0") != 0)
+      return -1;
+   *vOutputs[i] = vSuffixedOutput;
+   }
+  vSelectionLogSuffix = "." + vConfig.label + ".log";
+  for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
+   zmeClassifiers[cntView - 1].setTmpFileSuffix("." + vConfig.label);
+  }
+
+
+ Timer oTimer;
   
  mout("\nCo-training started at " + getLocalTimeStr() + " ...\n", cout, log);
  if (vCoTrainingMethod == 1)
@@ -760,7 +1050,7 @@ const string ctmpStr  = "help";
                 vSelection, vCLSelMethod, vPoolUsage, vProbThreshold, 
                 vNumberThreshold, vRemoveLabeled, vSTIterations, 
                 vLogSelection, vTesting, vDevWSJOutput, vTestWSJOutput, 
-                vTestBrownOutput, log);
+                vTestBrownOutput, vSelectionLogSuffix, log);
  else if (vCoTrainingMethod == 2)
   coTrainSeparate(zmeClassifiers, vcLabeledSamples, vcUnlabeledSamples, 
                   vcDevWSJSntncs, vcTestWSJSntncs, vcTestBrownSntncs,
@@ -768,24 +1058,24 @@ const string ctmpStr  = "help";
                   vSelection, vCLSelMethod, vPoolUsage, vProbThreshold, 
                   vNumberThreshold, vRemoveLabeled, vSTIterations,  
                   vLogSelection, vTesting, vDevWSJOutput, vTestWSJOutput, 
-                  vTestBrownOutput, log);
+                  vTestBrownOutput, vSelectionLogSuffix, log);
  
+ CoNLLSaver::waitPending();
  mout("\nCo-training is done at " + getLocalTimeStr() + "! ", cout, log);
- vEndClk = clock();
- mout("(" + floatToStr(((double) (vEndClk - vStartClk)) / (CLOCKS_PER_SEC * 60)), 
-      cout, log);
- time(&vEndTime);
- mout(" min/" + floatToStr(difftime(vEndTime, vStartTime) / 60) + " min)\n",
+ oTimer.stop();
+ mout("(" + floatToStr(oTimer.getCPUTime() / 60), cout, log);
+ mout(" min/" + floatToStr(oTimer.getElapsedTime() / 60) + " min)\n",
       cout, log);
 
- log.close();
+ MetricsRecorder::close();
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  cout << endl;
-
+ log.close();
 }
 
 
@@ -853,7 +1143,8 @@ void logSamples(vector<Sample *> &pSamples)
            << " [" << (*itSample)->getZMEContextStr(1) << "]"
            << endl;
  
-   cout << "\r" << cntSample << " samples logged" << flush;
+   if (Progress::isDue(itSample + 1 == pSamples.end()))
+    cout << "\r" << cntSample << " samples logged" << flush;
    }
   strmLog.close(); 
   }
@@ -863,13 +1154,16 @@ void logSamples(vector<Sample *> &pSamples)
 
 short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile, 
                          string &pSyntFile, string &pDepFile, string &pPropsFile, 
-                         unsigned int pMaxSntnc, ofstream &pLog)
+                         unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                         unsigned short pLoadThreads, ofstream &pLog)
 {
  CoNLLLoader oCoNLLLoader(pWordsFile, 
                           pSyntFile,
                           pDepFile,
                           pPropsFile, 
                           pMaxSntnc);
+ oCoNLLLoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oCoNLLLoader.setThreadCount(pLoadThreads);
 
  if (oCoNLLLoader.loadData(pSentences) == 0)
  {
@@ -895,9 +1189,12 @@ short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile,
 
 short loadUnlabeledSentences(vector<Sentence *> &pSentences, 
                              string &pDataFile, string &pSyntDepFile, 
-                             unsigned int pMaxSntnc, ofstream &pLog)
+                             unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                             unsigned short pLoadThreads, ofstream &pLog)
 {
  ULoader oULoader(pDataFile, pSyntDepFile, pMaxSntnc);
+ oULoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oULoader.setThreadCount(pLoadThreads);
 
  if (oULoader.loadData(pSentences) == 0)
  {
@@ -1118,7 +1415,8 @@ void setSelectedPrdLabeling(vector<Sentence *> &pcLabeledSntncs,
       itSentence++)
  {     
   (*itSentence)->setSelectedPrdLabels(pSelectionMethod, 0);
-  cout << "\r" << (itSentence - pcLabeledSntncs.begin() + 1) << " sentences processed" << flush;
+  if (Progress::isDue(itSentence + 1 == pcLabeledSntncs.end()))
+   cout << "\r" << (itSentence - pcLabeledSntncs.begin() + 1) << " sentences processed" << flush;
   }
  pLog << pcLabeledSntncs.size() << " sentences processed" << flush;
 
@@ -1140,7 +1438,8 @@ void setSelectedPrdLabeling(vector<Sample *> &pcLabeledSamples,
       itSample++)
  {     
   (*itSample)->setSelectedPrdLabel(pSelectionMethod, 0);
-  cout << "\r" << (itSample - pcLabeledSamples.begin() + 1) << " samples processed" << flush;
+  if (Progress::isDue(itSample + 1 == pcLabeledSamples.end()))
+   cout << "\r" << (itSample - pcLabeledSamples.begin() + 1) << " samples processed" << flush;
   }
  pLog << pcLabeledSamples.size() << " samples processed" << flush;
 
@@ -1177,6 +1476,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
                    string &pDevWSJOutput,
                    string &pTestWSJOutput,
                    string &pTestBrownOutput,
+                   const string &pSelectionLogSuffix,
                    ofstream &pLog)
 {
  unsigned vSeedSize = pTrainingSamples.size();
@@ -1243,11 +1543,13 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
   {
    mout("\nIteration " + intToStr(cntIteration) +
         " (Pool " + intToStr(cntPool) + "):\n", cout, pLog);
+   MetricsRecorder::beginRecord(cntIteration);
 
    /**
     *  labeling unlabeled samples (sample-based)
     */
  
+   MetricsRecorder::beginPhase("pool");
    for (unsigned short cntView = 1; cntView <= FEATURE_VIEW_COUNT; cntView++)
    {
     mout("\nLabeling unlabeled samples with classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
@@ -1260,11 +1562,13 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
    mout("\nLabeling unlabeled samples with selected common labels ...\n", cout, pLog);
    setSelectedPrdLabeling(vPool, pCLSelMethod, pLog);
    mout("\nLabeling unlabeled samples is done!\n", cout, pLog);  
+   MetricsRecorder::endPhase();
    
    /**
     *  selecting and adding newly labeled data to training set
     */
  
+   MetricsRecorder::beginPhase("select");
    mout("\nAdding newly labeled data to training set ...\n", cout, pLog);
    
    unsigned int vAddedCount = 0;
@@ -1275,7 +1579,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
                                  pProbThreshold, pNumberThreshold,
                                  DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                  pLogSelection, LOG_POOL_SELECTION_FILE_NAME +
-                                 intToStr(cntIteration) + ".log",
+                                 intToStr(cntIteration) + pSelectionLogSuffix,
                                  pLog);
    else 
     // Note:
@@ -1292,6 +1596,8 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount) +
         " samples)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount);
+   MetricsRecorder::endPhase();
  
    // Only if any new labeled data is added to training set, train a new
    // classifier 
@@ -1336,6 +1642,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     {
      if (pTesting >= 1)
      {
+      PhaseGuard oPhase("dev");
       mout("\nLabeling development data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pDevWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1350,6 +1657,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 2)
      {
+      PhaseGuard oPhase("wsj");
       mout("\nLabeling WSJ test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1364,6 +1672,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 3)
      {
+      PhaseGuard oPhase("brown");
       mout("\nLabeling Brown test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestBrownSntncs, cntView, pGlobalOpt, pLog);
@@ -1389,6 +1698,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
     
     if (pTesting >= 1)
     {
+     PhaseGuard oPhase("dev");
      mout("\nLabeling development data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pDevWSJSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling development data is done!\n", cout, pLog);  
@@ -1399,6 +1709,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 2)
     {
+     PhaseGuard oPhase("wsj");
      mout("\nLabeling WSJ test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestWSJSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling WSJ test data is done!\n", cout, pLog);  
@@ -1409,6 +1720,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 3)
     {
+     PhaseGuard oPhase("brown");
      mout("\nLabeling Brown test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestBrownSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling Brown test data is done!\n", cout, pLog);  
@@ -1455,6 +1767,8 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
    mout("\n", cout, pLog);
 
 
+   MetricsRecorder::endRecord();
+
    /**
     *  Checking stop criterion for looping inside the pool
     */
@@ -1481,6 +1795,7 @@ void coTrainCommon(vector<ZMEClassifier> &pZMEClassifiers,
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, pLog);
+  MemoryAccount::report(pLog);
 
   }
 }
@@ -1522,6 +1837,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                      string &pDevWSJOutput,
                      string &pTestWSJOutput,
                      string &pTestBrownOutput,
+                     const string &pSelectionLogSuffix,
                      ofstream &pLog)
 {
  unsigned short vSeedSize = pTrainingSamples.size();
@@ -1619,11 +1935,13 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
    mout("\nIteration " + intToStr(cntIteration) +
         " (Pool " + intToStr(cntPool1) + " of view 1 and Pool " +
         intToStr(cntPool2) + " of view 2):\n", cout, pLog);
+   MetricsRecorder::beginRecord(cntIteration);
 
    /**
     *  labeling unlabeled samples (sample-based)
     */
  
+   MetricsRecorder::beginPhase("pool");
    mout("\nLabeling unlabeled samples with classifier of view 1 ...\n", cout, pLog);
    pZMEClassifiers[0].classify(vPool1, 1, pGlobalOpt, pLog);
    mout("Labeling unlabeled samples is done! (" +
@@ -1635,11 +1953,13 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
    mout("Labeling unlabeled samples is done! (" +
         floatToStr(pZMEClassifiers[1].getElapsedTime()) + " sec)\n",
         cout, pLog);
+   MetricsRecorder::endPhase();
 
    /**
     *  selecting and adding newly labeled data to training set
     */
  
+   MetricsRecorder::beginPhase("select");
    mout("\nAdding newly labeled data by view 1 to training set of view 2 ...\n", cout, pLog);
    
    unsigned int vAddedCount2 = 0;
@@ -1650,7 +1970,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                                   pProbThreshold, pNumberThreshold,
                                   DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                   pLogSelection, string(LOG_POOL_SELECTION_FILE_NAME) +
-                                  ".1." + intToStr(cntIteration) + ".log",
+                                  ".1." + intToStr(cntIteration) + pSelectionLogSuffix,
                                   pLog);
    else 
     // Note:
@@ -1667,6 +1987,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount2) +
         " sentences)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount2);
  
    mout("\nAdding newly labeled data by view 2 to training set of view 1 ...\n", cout, pLog);
    
@@ -1678,7 +1999,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
                                   pProbThreshold, pNumberThreshold,
                                   DEFAULT_CO_TRAINING_CONVERGENCE_SENTENCE_COUNT,
                                   pLogSelection, string(LOG_POOL_SELECTION_FILE_NAME) +
-                                  ".2." + intToStr(cntIteration) + ".log",
+                                  ".2." + intToStr(cntIteration) + pSelectionLogSuffix,
                                   pLog);
    else 
     //  Refer to the comments for 1st view above.
@@ -1686,6 +2007,8 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount1) +
         " sentences)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount1);
+   MetricsRecorder::endPhase();
  
    
    // Only if any new labeled data is added to both training set, train
@@ -1732,6 +2055,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     {
      if (pTesting >= 1)
      {
+      PhaseGuard oPhase("dev");
       mout("\nLabeling development data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pDevWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1746,6 +2070,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 2)
      {
+      PhaseGuard oPhase("wsj");
       mout("\nLabeling WSJ test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestWSJSntncs, cntView, pGlobalOpt, pLog);
@@ -1760,6 +2085,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
      
      if (pTesting >= 3)
      {
+      PhaseGuard oPhase("brown");
       mout("\nLabeling Brown test data with " + intToStr(cntIteration) +
            "th classifier of view " + intToStr(cntView) + " ...\n", cout, pLog);
       pZMEClassifiers[cntView - 1].classify(pTestBrownSntncs, cntView, pGlobalOpt, pLog);
@@ -1785,6 +2111,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
     
     if (pTesting >= 1)
     {
+     PhaseGuard oPhase("dev");
      mout("\nLabeling development data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pDevWSJSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling development data is done!\n", cout, pLog);  
@@ -1795,6 +2122,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 2)
     {
+     PhaseGuard oPhase("wsj");
      mout("\nLabeling WSJ test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestWSJSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling WSJ test data is done!\n", cout, pLog);   
@@ -1805,6 +2133,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
 
     if (pTesting >= 3)
     {
+     PhaseGuard oPhase("brown");
      mout("\nLabeling Brown test data with selected common labels ...\n", cout, pLog);
      setSelectedPrdLabeling(pTestBrownSntncs, CONFIDENECE_ONLY, pLog);
      mout("\nLabeling Brown test data is done!\n", cout, pLog);  
@@ -1855,6 +2184,8 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
    mout("Data used so far: " + intToStr(vDataUsedSofar) + " sentences for training view 2\n", cout, pLog);
 
 
+   MetricsRecorder::endRecord();
+
    /**
     *  Checking stop criterion for looping inside the pool
     */
@@ -1888,6 +2219,7 @@ void coTrainSeparate(vector<ZMEClassifier> &pZMEClassifiers,
   ///////////////
   mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
        cout, pLog);
+  MemoryAccount::report(pLog);
 
   }
 }
@@ -2055,9 +2387,9 @@ unsigned int selectAndMoveAgreed(vector<Sample *> &pPool,
                                  string &pLogFileName,
                                  ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // sorts to agreed samples come first
  sort(pPool.begin(), pPool.end(), isAgreedLabel);
@@ -2120,7 +2452,7 @@ unsigned int selectAndMoveAgreed(vector<Sample *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -2144,9 +2476,9 @@ unsigned int selectAndMoveConfident(vector<Sample *> &pPool,
                                     string &pLogFileName,
                                     ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // Remember to always set the value of this global variable before using
  // the isMoreLikelyLabeling() and isMoreLikelyLabel() functions to determine
@@ -2224,7 +2556,7 @@ unsigned int selectAndMoveConfident(vector<Sample *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -2251,9 +2583,9 @@ unsigned int selectAndMove(vector<Sample *> &pPool,
                            string &pLogFileName,
                            ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // Remember to always set the value of this global variable before using
  // the isMoreLikelyLabeling() and isMoreLikelyLabel() functions to determine
@@ -2330,7 +2662,7 @@ unsigned int selectAndMove(vector<Sample *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -19,6 +19,8 @@
 #include "Utils.hpp"
 #include "Constants.hpp"
 #include "Classifier.hpp"
+#include "Logging.hpp"
+#include "FeatureHasher.hpp"
 
 using namespace std;
 
@@ -26,7 +28,8 @@ using namespace std;
 void extractSizeSeri(string &, vector<unsigned> &);
 void logSizeSeri(vector<unsigned int> &, ofstream &); 
 short loadCoNLLSentences(vector<Sentence *> &, string &, string &, 
-                         string &, string &, ofstream &);
+                         string &, string &, bool, unsigned short, 
+                         ofstream &);
 void shuffleSentences(vector<Sentence *> &, unsigned short); 
 short generateLabeledSamples(vector<Sentence *> &, unsigned short, 
                              string &, bool, bool, ofstream &);
@@ -50,8 +53,17 @@ static void usage(const char * execName)
       << " <-fs[Feature set to use]>" << endl
       << " <-go[Global optimization (0: no; 1: yes)]>" << endl 
       << " <-mi[ME iteration number]>" << endl 
-      << " <-mp[ME parameter estimation method (lbfgs or gis)]>" << endl 
+      << " <-mp[ME parameter estimation method (lbfgs, gis, sgd or perceptron)]>" << endl 
+      << " <-mt[ME training threads (0: maxent trainer; n: built-in parallel trainer with n threads)]>" << endl 
+      << " <-fc[ME feature count cutoff (features seen less are dropped; 0: no cutoff)]>" << endl 
+      << " <-fh[Feature hashing bits (0: no hashing; k: 2^k feature buckets)]>" << endl 
+      << " <-hs[Signed feature hashing (0: no; 1: yes)]>" << endl 
+      << " <-ns[Negative sampling rate per proposition in training (0: use all negatives)]>" << endl 
+      << " <-it[Argument identification threshold of two-stage labeling (0: no identification stage)]>" << endl 
+      << " <-ph[Precompute head words, subcat and governing category of constituents at load time (0: no; 1: yes)]>" << endl 
+      << " <-lt[Number of threads loading sentence-aligned chunks of data in parallel (0 or 1: sequential loading)]>" << endl 
       << " <-g[Gaussian parameter]>" << endl 
+      << " <-fe[Fast ME evaluation by built-in scorer (0: no; 1: yes)]>" << endl 
       << " <-tst[Testing frameworks (1: development; 2: development & wsj; 3: development, wsj, brown]>" << endl
       << " <-ltw[CoNLL training words file name]>" << endl
       << " <-lts[CoNLL training cfg syntax file name]>" << endl
@@ -108,7 +120,16 @@ int main(int argc, char ** argv)
  bool vGlobalOpt = false;
  unsigned int vMEIterations = 350;
  string vMEPEMethod = "lbfgs";
+ unsigned short vMEThreads = 0;
+ unsigned int vFeatureCutoff = 0;
+ unsigned short vHashingBits = 0;
+ bool vSignedHashing = false;
+ double vNegativeRate = 0;
+ double vIdThreshold = 0;
+ bool vPrecomputeTrees = false;
+ unsigned short vLoadThreads = 0;
  double vGaussian = 1;
+ bool vFastEval = false;
 
  const string ctmpStr  = "help";
  if(argv[1] == ctmpStr.c_str())
@@ -119,7 +140,7 @@ int main(int argc, char ** argv)
  
  string tmpLogFile = LOG_LEARNING_CURVE_OUTPUT_FILE_PREFIX;
  tmpLogFile += ".[" + getLocalTimeStr("YYYY-MM-DD-HH-MM") + "].log";
- ofstream log (tmpLogFile.c_str());
+ AsyncLogFile log (tmpLogFile.c_str());
  if (!log)
   cerr << "Cannot create output log file: " << tmpLogFile
        << endl; 
@@ -191,12 +212,66 @@ int main(int argc, char ** argv)
    continue; 
    }
    
+  if (vcParam[0] == "-mt")
+  { 
+   vMEThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fc")
+  { 
+   vFeatureCutoff = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fh")
+  { 
+   vHashingBits = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-hs")
+  { 
+   vSignedHashing = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ns")
+  { 
+   vNegativeRate = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-it")
+  { 
+   vIdThreshold = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ph")
+  { 
+   vPrecomputeTrees = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-lt")
+  { 
+   vLoadThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-g")
   { 
    vGaussian = strToFloat(vcParam[1]);
    continue;
    }
    
+  if (vcParam[0] == "-fe")
+  { 
+   vFastEval = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-tst")
   { 
    vTesting = strToInt(vcParam[1]);
@@ -312,7 +387,8 @@ int main(int argc, char ** argv)
  mout("\nLoading CoNLL labeled training data ...\n", cout, log);
  if (loadCoNLLSentences(vcLabeledSntncs, vLabeledWordsFile, 
                         vLabeledSyntChaFile, vLabeledSyntDepFile,
-                        vLabeledPropsFile, log) != 0)
+                        vLabeledPropsFile, 
+                        vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  if (vShfl > 0)
@@ -334,7 +410,8 @@ int main(int argc, char ** argv)
  {
   mout("\nLoading CoNLL WSJ development data ...\n", cout, log);
   if (loadCoNLLSentences(vcDevWSJSntncs, vDevWSJWordsFile, vDevWSJSyntChaFile, 
-                         vDevWSJSyntDepFile, vDevWSJPropsFile, log) != 0)
+                         vDevWSJSyntDepFile, vDevWSJPropsFile, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
 
@@ -342,7 +419,8 @@ int main(int argc, char ** argv)
  {
   mout("\nLoading CoNLL WSJ test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestWSJSntncs, vTestWSJWordsFile, vTestWSJSyntChaFile,
-                         vTestWSJSyntDepFile, vTestWSJPropsFile, log) != 0)
+                         vTestWSJSyntDepFile, vTestWSJPropsFile, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
@@ -350,7 +428,8 @@ int main(int argc, char ** argv)
  {
   mout("\nLoading CoNLL Brown test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestBrownSntncs, vTestBrownWordsFile, vTestBrownSyntChaFile,
-                         vTestBrownSyntDepFile, vTestBrownPropsFile, log) != 0)
+                         vTestBrownSyntDepFile, vTestBrownPropsFile, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
@@ -395,7 +474,14 @@ int main(int argc, char ** argv)
  *  indicating the training size.
  */
  
+ FeatureHasher::setHashing(vHashingBits, vSignedHashing);
+ 
  ZMEClassifier zmeClassifier;
+ zmeClassifier.setFastEvaluation(vFastEval);
+ zmeClassifier.setTrainingThreads(vMEThreads);
+ zmeClassifier.setFeatureCutoff(vFeatureCutoff);
+ zmeClassifier.setNegativeSamplingRate(vNegativeRate);
+ zmeClassifier.setIdentificationThreshold(vIdThreshold);
  
  // training with specified sizes of labeled data
 
@@ -607,7 +693,8 @@ void logSamples(vector<Sample *> &pSamples)
            << " [" << (*itSample)->getZMEContextStr(1) << "]"
            << endl;
  
-   cout << "\r" << cntSample << " samples logged" << flush;
+   if (Progress::isDue(itSample + 1 == pSamples.end()))
+    cout << "\r" << cntSample << " samples logged" << flush;
    }
   strmLog.close(); 
   }
@@ -616,6 +703,7 @@ void logSamples(vector<Sample *> &pSamples)
 ///---------------------------------------------------------------------
 short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile, 
                          string &pSyntFile, string &pDepFile, string &pPropsFile, 
+                         bool pPrecomputeTrees, unsigned short pLoadThreads, 
                          ofstream &pLog)
 {
  CoNLLLoader oCoNLLLoader(pWordsFile, 
@@ -623,6 +711,8 @@ short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile,
                           pDepFile,
                           pPropsFile, 
                           0);
+ oCoNLLLoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oCoNLLLoader.setThreadCount(pLoadThreads);
 
  if (oCoNLLLoader.loadData(pSentences) == 0)
  {
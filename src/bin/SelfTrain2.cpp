@@ -14,20 +14,27 @@
 #include "CoNLLLoader.hpp"
 #include "ULoader.hpp"
 #include "CoNLLSaver.hpp"
+#include "GzStream.hpp"
 #include "Sentence.hpp"
 #include "SampleGenerator.hpp"
 #include "Sample.hpp"
 #include "Utils.hpp"
 #include "Constants.hpp"
 #include "Classifier.hpp"
+#include "Sweep.hpp"
+#include "Metrics.hpp"
+#include "FeatureProfiler.hpp"
+#include "FeatureHasher.hpp"
+#include "MemoryAccount.hpp"
+#include "Logging.hpp"
 
 using namespace std;
 
 
 short loadCoNLLSentences(vector<Sentence *> &, string &, string &, string &,
-                         string &, unsigned int, ofstream &);
+                         string &, unsigned int, bool, unsigned short, ofstream &);
 short loadUnlabeledSentences(vector<Sentence *> &, string &, string &, 
-                             unsigned int, ofstream &);
+                             unsigned int, bool, unsigned short, ofstream &);
 short generateLabeledSamples(vector<Sentence *> &, vector<Sample *> &,
                              unsigned int, unsigned int, unsigned short, 
                              string &, bool, bool, ofstream &);
@@ -40,7 +47,8 @@ void selfTrain(ZMEClassifier &, vector<Sample *> &, vector<Sample *> &,
                unsigned short, string &, double, bool, unsigned int, 
                unsigned short, unsigned short, double, unsigned short, 
                bool, unsigned short, unsigned short, unsigned short, 
-               string &, string &, string &, ofstream &);
+               string &, string &, string &, const string &, 
+               ofstream &);
 unsigned int addToTraining(vector<Sample *> &, vector<Sample *> &, 
                            unsigned int);
 unsigned int moveToTraining(vector<Sample *> &, vector<Sample *> &, 
@@ -68,8 +76,24 @@ static void usage(const char * execName)
       << " <-fs[Feature set to use]>" << endl
       << " <-go[Global optimization (0: no; 1: yes)]>" << endl 
       << " <-mi[ME iteration number]>" << endl 
-      << " <-mp[ME parameter estimation method (lbfgs or gis)]>" << endl 
+      << " <-mp[ME parameter estimation method (lbfgs, gis, sgd or perceptron)]>" << endl 
+      << " <-mt[ME training threads (0: maxent trainer; n: built-in parallel trainer with n threads)]>" << endl 
+      << " <-fc[ME feature count cutoff (features seen less are dropped; 0: no cutoff)]>" << endl 
+      << " <-ns[Negative sampling rate per proposition in training (0: use all negatives)]>" << endl 
+      << " <-it[Argument identification threshold of two-stage labeling (0: no identification stage)]>" << endl 
+      << " <-ph[Precompute head words, subcat and governing category of constituents at load time (0: no; 1: yes)]>" << endl 
+      << " <-lt[Number of threads loading sentence-aligned chunks of data in parallel (0 or 1: sequential loading)]>" << endl 
+      << " <-sw[Sweep configuration file (one worker is forked per configuration after loading data and training the base classifier)]>" << endl 
+      << " <-swj[Maximum number of sweep workers running at the same time (0: number of cores)]>" << endl 
+      << " <-swm[Memory budget of sweep workers in MB (0: no limit)]>" << endl 
+      << " <-mf[Metrics file the phase times and counts of each iteration are written into (one JSON record per line)]>" << endl 
+      << " <-fp[Profile the cost of feature extraction per feature type into the sample generation analysis logs (0: no; 1: yes)]>" << endl 
+      << " <-as[Save output props files asynchronously, overlapping the next steps (0: no; 1: yes)]>" << endl 
+      << " <-zo[Compress output props files and selection logs by gzip (0: no; 1: yes)]>" << endl 
+      << " <-fh[Feature hashing bits (0: no hashing; k: 2^k feature buckets)]>" << endl 
+      << " <-hs[Signed feature hashing (0: no; 1: yes)]>" << endl 
       << " <-g[Gaussian parameter]>" << endl 
+      << " <-fe[Fast ME evaluation by built-in scorer (0: no; 1: yes)]>" << endl 
       << " <-sc[Selection criterion to use (0 if no selection)]>" << endl 
       << " <-p[Pool size (0 if not used)]>" << endl
       << " <-pu[Pool usage when selection is used (0: no pool used;" << endl
@@ -146,7 +170,23 @@ int main(int argc, char ** argv)
  bool vGlobalOpt = false;
  unsigned int vMEIterations = 350;
  string vMEPEMethod = "lbfgs";
+ unsigned short vMEThreads = 0;
+ unsigned int vFeatureCutoff = 0;
+ double vNegativeRate = 0;
+ double vIdThreshold = 0;
+ bool vPrecomputeTrees = false;
+ unsigned short vLoadThreads = 0;
+ string vSweepFile;
+ unsigned short vSweepWorkers = 0;
+ unsigned long vSweepMemory = 0;
+ string vMetricsFile;
+ bool vProfileFeatures = false;
+ bool vAsyncSaving = false;
+ bool vCompressOutput = false;
+ unsigned short vHashingBits = 0;
+ bool vSignedHashing = false;
  double vGaussian = 1;
+ bool vFastEval = false;
  unsigned int vPoolSize = 0;
  unsigned short vSelection = 0;
  unsigned short vPoolUsage = 3;
@@ -165,7 +205,7 @@ int main(int argc, char ** argv)
  
  string tmpLogFile = LOG_SELFTRAINING_OUTPUT_FILE_PREFIX;
  tmpLogFile += ".2.[" + getLocalTimeStr("YYYY-MM-DD-HH-MM") + "].log";
- ofstream log (tmpLogFile.c_str());
+ AsyncLogFile log (tmpLogFile.c_str());
  if (!log)
   cerr << "Cannot create output log file: " << tmpLogFile
        << endl; 
@@ -255,12 +295,108 @@ int main(int argc, char ** argv)
    continue; 
    }
    
+  if (vcParam[0] == "-mt")
+  { 
+   vMEThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fc")
+  { 
+   vFeatureCutoff = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ns")
+  { 
+   vNegativeRate = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-it")
+  { 
+   vIdThreshold = strToFloat(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-ph")
+  { 
+   vPrecomputeTrees = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-lt")
+  { 
+   vLoadThreads = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-sw")
+  { 
+   vSweepFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-swj")
+  { 
+   vSweepWorkers = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-swm")
+  { 
+   vSweepMemory = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-mf")
+  { 
+   vMetricsFile = vcParam[1];
+   continue;
+   }
+   
+  if (vcParam[0] == "-fp")
+  { 
+   vProfileFeatures = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-as")
+  { 
+   vAsyncSaving = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-zo")
+  { 
+   vCompressOutput = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-fh")
+  { 
+   vHashingBits = strToInt(vcParam[1]);
+   continue;
+   }
+   
+  if (vcParam[0] == "-hs")
+  { 
+   vSignedHashing = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-g")
   { 
    vGaussian = strToFloat(vcParam[1]);
    continue;
    }
    
+  if (vcParam[0] == "-fe")
+  { 
+   vFastEval = strToInt(vcParam[1]);
+   continue;
+   }
+   
   if (vcParam[0] == "-p")
   { 
    vPoolSize = strToInt(vcParam[1]);
@@ -424,9 +560,23 @@ int main(int argc, char ** argv)
    }
   }
 
+ if (!vMetricsFile.empty())
+  if (MetricsRecorder::open(vMetricsFile) != 0)
+   return -1;
+ 
+ // the record of iteration 0 covers loading the data and training and 
+ // testing the base classifier(s)
+ MetricsRecorder::beginRecord(0);
+
+ FeatureProfiler::setEnabled(vProfileFeatures);
+ CoNLLSaver::setAsyncSaving(vAsyncSaving);
+ OGzStream::setCompression(vCompressOutput);
+ FeatureHasher::setHashing(vHashingBits, vSignedHashing);
+
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -441,12 +591,14 @@ int main(int argc, char ** argv)
  mout("\nLoading CoNLL labeled training data ...\n", cout, log);
  if (loadCoNLLSentences(vcLabeledSntncs, vLabeledWordsFile, 
                         vLabeledSyntChaFile, vLabeledSyntDepFile,
-                        vLabeledPropsFile, vSeedSize, log) != 0)
+                        vLabeledPropsFile, vSeedSize, 
+                        vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -459,31 +611,38 @@ int main(int argc, char ** argv)
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLoading CoNLL WSJ development data ...\n", cout, log);
   if (loadCoNLLSentences(vcDevWSJSntncs, vDevWSJWordsFile, vDevWSJSyntChaFile,
-                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, log) != 0)
+                         vDevWSJSyntDepFile, vDevWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLoading CoNLL WSJ test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestWSJSntncs, vTestWSJWordsFile, vTestWSJSyntChaFile,
-                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, log) != 0)
+                         vTestWSJSyntDepFile, vTestWSJPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLoading CoNLL Brown test data ...\n", cout, log);
   if (loadCoNLLSentences(vcTestBrownSntncs, vTestBrownWordsFile, vTestBrownSyntChaFile,
-                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, log) != 0)
+                         vTestBrownSyntDepFile, vTestBrownPropsFile, 0, 
+                         vPrecomputeTrees, vLoadThreads, log) != 0)
    return -1;
   }
   
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -500,6 +659,7 @@ int main(int argc, char ** argv)
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -508,6 +668,7 @@ int main(int argc, char ** argv)
 
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nGenerating WSJ development samples ...\n", cout, log);
   if (generateTestSamples(vcDevWSJSntncs, vFeatureSet, vDevWSJSyntDepFile, true, false, log) != 0)
    return -1;
@@ -515,6 +676,7 @@ int main(int argc, char ** argv)
   
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nGenerating WSJ test samples ...\n", cout, log);
   if (generateTestSamples(vcTestWSJSntncs, vFeatureSet, vTestWSJSyntDepFile, true, false, log) != 0)
    return -1;
@@ -522,6 +684,7 @@ int main(int argc, char ** argv)
   
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nGenerating Brown test samples ...\n", cout, log);
   if (generateTestSamples(vcTestBrownSntncs, vFeatureSet, vTestBrownWordsFile, true, false, log) != 0)
    return -1;
@@ -530,6 +693,7 @@ int main(int argc, char ** argv)
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -537,6 +701,11 @@ int main(int argc, char ** argv)
  */
  
  ZMEClassifier zmeClassifier;
+ zmeClassifier.setFastEvaluation(vFastEval);
+ zmeClassifier.setTrainingThreads(vMEThreads);
+ zmeClassifier.setFeatureCutoff(vFeatureCutoff);
+ zmeClassifier.setNegativeSamplingRate(vNegativeRate);
+ zmeClassifier.setIdentificationThreshold(vIdThreshold);
  
 /**
  *  Samples are passed to the trainer
@@ -555,6 +724,7 @@ int main(int argc, char ** argv)
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -567,6 +737,7 @@ int main(int argc, char ** argv)
  
  if (vTesting >= 1)
  {
+  PhaseGuard oPhase("dev");
   mout("\nLabeling development data with base classifier ...\n", cout, log);
   zmeClassifier.classify(vcDevWSJSntncs, 1, vGlobalOpt, log);
   mout("Labeling development data is done! (" +
@@ -580,6 +751,7 @@ int main(int argc, char ** argv)
 
  if (vTesting >= 2)
  {
+  PhaseGuard oPhase("wsj");
   mout("\nLabeling WSJ test data with base classifier ...\n", cout, log);
   zmeClassifier.classify(vcTestWSJSntncs, 1, vGlobalOpt, log);
   mout("Labeling WSJ test data is done! (" +
@@ -593,6 +765,7 @@ int main(int argc, char ** argv)
 
  if (vTesting >= 3)
  {
+  PhaseGuard oPhase("brown");
   mout("\nLabeling Brown test data with base classifier ...\n", cout, log);
   zmeClassifier.classify(vcTestBrownSntncs, 1, vGlobalOpt, log);
   mout("Labeling Brown test data is done! (" +
@@ -607,6 +780,7 @@ int main(int argc, char ** argv)
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
 
 /**
@@ -616,6 +790,9 @@ int main(int argc, char ** argv)
  // if the specified size for unlabeled data is 0, ignore self-training
  if (vUnlabeledSize == 0)
  {
+  CoNLLSaver::waitPending();
+  MetricsRecorder::endRecord();
+  MetricsRecorder::close();
   cout << endl;
   log.close();
   return 0;
@@ -630,14 +807,17 @@ int main(int argc, char ** argv)
  
  vector<Sentence *> vcUnlabeledSntncs;
 
+ MetricsRecorder::beginPhase("unlabeled");
  mout("\nLoading unlabeled training data ...\n", cout, log);
  if (loadUnlabeledSentences(vcUnlabeledSntncs, vUnlabeledDataFile,
-                            vUnlabeledSyntDepFile, vUnlabeledSize, log) != 0)
+                            vUnlabeledSyntDepFile, vUnlabeledSize, 
+                            vPrecomputeTrees, vLoadThreads, log) != 0)
   return -1;
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  /**
   *  generating unlabeled training samples for self-training
@@ -648,17 +828,112 @@ int main(int argc, char ** argv)
  if (generateUnlabeledSamples(vcUnlabeledSntncs, vcUnlabeledSamples, vFeatureSet, 
                               vUnlabeledDataFile, false, false, log) != 0)
   return -1;
+ MetricsRecorder::endPhase();
 
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
+
+ MetricsRecorder::endRecord();
 
 
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+/**
+ *  sweeping the configurations
+ * 
+ *  A worker is forked per configuration to continue as a single run with
+ *  the parameters of its configuration, writing its own log and outputs 
+ *  (suffixed by the configuration label); the parent returns after all the
+ *  workers have finished.
+ */
+
+ // the pool selection logs of a configuration are suffixed by its label
+ string vSelectionLogSuffix = ".log";
  
- vStartClk = clock();
- time(&vStartTime);
+ if (!vSweepFile.empty())
+ {
+  vector<SweepConfig> vcSweepConfigs;
+  if (loadSweepConfigs(vSweepFile, vcSweepConfigs) != 0)
+   return -1;
+  
+  // the outputs of the base classifier(s) should be complete before forking
+  CoNLLSaver::waitPending();
+  
+  SweepRunner oSweepRunner(vSweepWorkers, vSweepMemory);
+  // the log is written synchronously while forking, since its writer
+  // thread is not inherited by the workers
+  log.setAsync(false);
+  int vSweepConfig = oSweepRunner.forkWorkers(vcSweepConfigs, log);
+  log.setAsync(true);
+  if (vSweepConfig < 0)
+  {
+   mout("\nSweeping is done! (" + intToStr(oSweepRunner.getFailedCount()) + 
+        " configurations failed)\n", cout, log);
+   cout << endl;
+   MetricsRecorder::close();
+   log.close();
+   return (oSweepRunner.getFailedCount() == 0) ? 0 : -1;
+   }
+  
+  SweepConfig &vConfig = vcSweepConfigs[vSweepConfig];
+  
+  log.close();
+  tmpLogFile.insert(tmpLogFile.size() - 4, "." + vConfig.label);
+  log.open(tmpLogFile.c_str());
+  if (!log)
+   cerr << "Cannot create output log file: " << tmpLogFile
+        << endl; 
+  
+  if (MetricsRecorder::isOpen())
+   if (MetricsRecorder::open(vMetricsFile + "." + vConfig.label) != 0)
+    return -1;
+  
+  for (unsigned short i = 0; i < vConfig.params.size(); i++)
+  {
+   vector<string> &vcSweepParam = vConfig.params[i];
+   log << vcSweepParam[0] << " " << vcSweepParam[1] << endl;
+   
+   if (vcSweepParam[0] == "-p")
+    vPoolSize = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-sc")
+    vSelection = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pu")
+    vPoolUsage = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-pt")
+    vProbThreshold = strToFloat(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-nt")
+    vNumberThreshold = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-r")
+    vRemoveLabeled = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-si")
+    vSTIterations = strToInt(vcSweepParam[1]);
+   else if (vcSweepParam[0] == "-ls")
+    vLogSelection = strToInt(vcSweepParam[1]);
+   else
+   {
+    cerr << "Parameter " << vcSweepParam[0] << " cannot be swept!" << endl;
+    return -1;
+    }
+   }
+  
+  // the outputs of the base classifier (iteration 0) are written once by
+  // the parent, so they are copied for the configuration to have its
+  // complete series of outputs
+  string *vOutputs[] = {&vDevWSJOutput, &vTestWSJOutput, &vTestBrownOutput};
+  for (unsigned short i = 0; i < 3; i++)
+  {
+   string vSuffixedOutput = *vOutputs[i] + "." + vConfig.label;
+   if ((vTesting > i) &&
+       (CoNLLSaver::copyProps(*vOutputs[i] + ".0", vSuffixedOutput + ".0") != 0))
+    return -1;
+   *vOutputs[i] = vSuffixedOutput;
+   }
+  vSelectionLogSuffix = "." + vConfig.label + ".log";
+  zmeClassifier.setTmpFileSuffix("." + vConfig.label);
+  }
+
+
+ Timer oTimer;
   
  mout("\nSelf-training started at " + getLocalTimeStr() + " ...\n", cout, log);
  selfTrain(zmeClassifier, vcLabeledSamples, vcUnlabeledSamples, 
@@ -666,18 +941,20 @@ int main(int argc, char ** argv)
            vMEIterations, vMEPEMethod, vGaussian, vGlobalOpt, vPoolSize,
            vSelection, vPoolUsage, vProbThreshold, vNumberThreshold, 
            vRemoveLabeled, vSTIterations, vLogSelection, vTesting, 
-           vDevWSJOutput, vTestWSJOutput, vTestBrownOutput, log);
+           vDevWSJOutput, vTestWSJOutput, vTestBrownOutput, vSelectionLogSuffix, log);
+ CoNLLSaver::waitPending();
  mout("\nSelf-training is done at " + getLocalTimeStr() + "! ", cout, log);
- vEndClk = clock();
- mout("(" + floatToStr(((double) (vEndClk - vStartClk)) / (CLOCKS_PER_SEC * 60)), 
-      cout, log);
- time(&vEndTime);
- mout(" min/" + floatToStr(difftime(vEndTime, vStartTime) / 60) + " min)\n",
+ oTimer.stop();
+ mout("(" + floatToStr(oTimer.getCPUTime() / 60), cout, log);
+ mout(" min/" + floatToStr(oTimer.getElapsedTime() / 60) + " min)\n",
       cout, log);
 
+ MetricsRecorder::close();
+
  ///////////////
  mout("\nMemory Usage: " + setThousandSeparator(ulongToStr(getMemUsage())) + " Bytes\n",
       cout, log);
+ MemoryAccount::report(log);
 
  cout << endl;
  log.close();
@@ -745,7 +1022,8 @@ void logSamples(vector<Sample *> &pSamples)
            << " [" << (*itSample)->getZMEContextStr(1) << "]"
            << endl;
  
-   cout << "\r" << cntSample << " samples logged" << flush;
+   if (Progress::isDue(itSample + 1 == pSamples.end()))
+    cout << "\r" << cntSample << " samples logged" << flush;
    }
   strmLog.close(); 
   }
@@ -753,13 +1031,16 @@ void logSamples(vector<Sample *> &pSamples)
 
 short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile, 
                          string &pSyntFile, string &pDepFile, string &pPropsFile, 
-                         unsigned int pMaxSntnc, ofstream &pLog)
+                         unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                         unsigned short pLoadThreads, ofstream &pLog)
 {
  CoNLLLoader oCoNLLLoader(pWordsFile, 
                           pSyntFile,
                           pDepFile,
                           pPropsFile, 
                           pMaxSntnc);
+ oCoNLLLoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oCoNLLLoader.setThreadCount(pLoadThreads);
 
  if (oCoNLLLoader.loadData(pSentences) == 0)
  {
@@ -783,9 +1064,12 @@ short loadCoNLLSentences(vector<Sentence *> &pSentences, string &pWordsFile,
 
 short loadUnlabeledSentences(vector<Sentence *> &pSentences, 
                              string &pDataFile,  string &pSyntDepFile,
-                             unsigned int pMaxSntnc, ofstream &pLog)
+                             unsigned int pMaxSntnc, bool pPrecomputeTrees, 
+                             unsigned short pLoadThreads, ofstream &pLog)
 {
  ULoader oULoader(pDataFile, pSyntDepFile, pMaxSntnc);
+ oULoader.setTBTreePrecomputation(pPrecomputeTrees);
+ oULoader.setThreadCount(pLoadThreads);
 
  if (oULoader.loadData(pSentences) == 0)
  {
@@ -1015,6 +1299,7 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
                string &pDevWSJOutput,
                string &pTestWSJOutput,
                string &pTestBrownOutput,
+               const string &pSelectionLogSuffix,
                ofstream &pLog)
 {
  unsigned vSeedSize = pTrainingSamples.size();
@@ -1080,21 +1365,25 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
   {
    mout("\nIteration " + intToStr(cntIteration) +
         " (Pool " + intToStr(cntPool) + "):\n", cout, pLog);
+   MetricsRecorder::beginRecord(cntIteration);
 
    /**
     *  labeling unlabeled samples (sample-based)
     */
  
+   MetricsRecorder::beginPhase("pool");
    mout("\nLabeling unlabeled samples ...\n", cout, pLog);
    unsigned vLabeledCount = pZMEClassifier.classify(vPool, 1, pGlobalOpt, pLog);
    mout("Labeling unlabeled samples is done! (" +
         floatToStr(pZMEClassifier.getElapsedTime()) + " sec)\n",
         cout, pLog);
+   MetricsRecorder::endPhase();
 
    /**
     *  selecting and adding newly labeled data to training set
     */
  
+   MetricsRecorder::beginPhase("select");
    mout("\nAdding newly labeled data to training set ...\n", cout, pLog);
    
    unsigned int vAddedCount = 0;
@@ -1105,7 +1394,7 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
                                  pProbThreshold, pNumberThreshold,
                                  DEFAULT_SELF_TRAINING_CONVERGENCE_SAMPLE_COUNT,
                                  pLogSelection, LOG_POOL_SELECTION_FILE_NAME +
-                                 intToStr(cntIteration) + ".log",
+                                 intToStr(cntIteration) + pSelectionLogSuffix,
                                  pLog);
    else 
     // Note:
@@ -1116,6 +1405,8 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
     
    mout("Adding labeled data is done! (" + intToStr(vAddedCount) +
         " samples)\n", cout, pLog);
+   MetricsRecorder::addCount("added", vAddedCount);
+   MetricsRecorder::endPhase();
  
    // Only if any new labeled data is added to training set, train a new
    // classifier 
@@ -1146,6 +1437,7 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
     
     if (pTesting >= 1)
     {
+     PhaseGuard oPhase("dev");
      mout("\nLabeling development data with " + intToStr(cntIteration) + "th classifier ...\n",
           cout, pLog);
      pZMEClassifier.classify(pDevWSJSntncs, 1, pGlobalOpt, pLog);
@@ -1158,6 +1450,7 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
      
     if (pTesting >= 2)
     {
+     PhaseGuard oPhase("wsj");
      mout("\nLabeling WSJ test data with " + intToStr(cntIteration) + "th classifier ...\n",
           cout, pLog);
      pZMEClassifier.classify(pTestWSJSntncs, 1, pGlobalOpt, pLog);
@@ -1170,6 +1463,7 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
      
     if (pTesting >= 3)
     {
+     PhaseGuard oPhase("brown");
      mout("\nLabeling Brown test data with " + intToStr(cntIteration) + "th classifier ...\n",
           cout, pLog);
      pZMEClassifier.classify(pTestBrownSntncs, 1, pGlobalOpt, pLog);
@@ -1207,6 +1501,8 @@ void selfTrain(ZMEClassifier &pZMEClassifier,
 
    mout("\nData used so far: " + intToStr(vDataUsedSofar) + " samples\n", cout, pLog);
 
+   MetricsRecorder::endRecord();
+
    /**
     *  Checking stop criterion for looping inside the pool
     */
@@ -1375,9 +1671,9 @@ unsigned int selectAndMove(vector<Sample *> &pPool,
                            string &pLogFileName,
                            ofstream &pLog)
 {
- ofstream strmSelection;
+ OGzStream strmSelection;
  if (pLogSelection > 0)
-  strmSelection.open(pLogFileName.c_str());
+  strmSelection.open(pLogFileName);
 
  // Remember to always set the value of this global variable before using
  // the isMoreLikelyLabeling() and isMoreLikelyLabel() functions to determine
@@ -1454,7 +1750,7 @@ unsigned int selectAndMove(vector<Sample *> &pPool,
    }
   }
   
- if (strmSelection.is_open()) 
+ if (strmSelection.isOpen()) 
   strmSelection.close(); 
   
  return vSelectedCount;
@@ -0,0 +1,95 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to ArgLabels.hpp)
+ *
+ */
+
+#include "ArgLabels.hpp"
+#include "Constants.hpp"
+
+
+// flags of label properties
+#define CORE_LABEL_FLAG 1
+#define CONTINUATION_LABEL_FLAG 2
+#define REFERENCE_LABEL_FLAG 4
+
+map<ArgLabel, ArgLabelId> ArgLabelRegistry::ids;
+vector<ArgLabel> ArgLabelRegistry::labels;
+vector<unsigned char> ArgLabelRegistry::flags;
+
+
+/**
+ *  registers the empty label and NULL in this order, so that their ids
+ *  are EMPTY_LABEL_ID and NULL_LABEL_ID
+ */
+void ArgLabelRegistry::initialize()
+{
+ labels.push_back("");
+ flags.push_back(0);
+ ids[""] = EMPTY_LABEL_ID;
+
+ labels.push_back("NULL");
+ flags.push_back(0);
+ ids["NULL"] = NULL_LABEL_ID;
+}
+
+ArgLabelId ArgLabelRegistry::getId(const ArgLabel &pLabel)
+{
+ if (labels.empty())
+  initialize();
+
+ map<ArgLabel, ArgLabelId>::iterator itId = ids.find(pLabel);
+ if (itId != ids.end())
+  return itId->second;
+
+ unsigned char vFlags = 0;
+ for (unsigned short i = 0; !CORE_ARGS[i].empty(); i++)
+  if (pLabel == CORE_ARGS[i])
+   vFlags |= CORE_LABEL_FLAG;
+ if (pLabel.compare(0, 2, "C-") == 0)
+  vFlags |= CONTINUATION_LABEL_FLAG;
+ if (pLabel.compare(0, 2, "R-") == 0)
+  vFlags |= REFERENCE_LABEL_FLAG;
+
+ ArgLabelId vId = labels.size();
+ labels.push_back(pLabel);
+ flags.push_back(vFlags);
+ ids[pLabel] = vId;
+
+ return vId;
+}
+
+const ArgLabel &ArgLabelRegistry::getLabel(ArgLabelId pId)
+{
+ if (labels.empty())
+  initialize();
+
+ return labels[pId];
+}
+
+unsigned short ArgLabelRegistry::getCount()
+{
+ return labels.size();
+}
+
+bool ArgLabelRegistry::isArgument(ArgLabelId pId)
+{
+ return (pId != EMPTY_LABEL_ID) && (pId != NULL_LABEL_ID);
+}
+
+bool ArgLabelRegistry::isCore(ArgLabelId pId)
+{
+ return (flags[pId] & CORE_LABEL_FLAG) != 0;
+}
+
+bool ArgLabelRegistry::isContinuation(ArgLabelId pId)
+{
+ return (flags[pId] & CONTINUATION_LABEL_FLAG) != 0;
+}
+
+bool ArgLabelRegistry::isReference(ArgLabelId pId)
+{
+ return (flags[pId] & REFERENCE_LABEL_FLAG) != 0;
+}
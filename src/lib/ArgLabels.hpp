@@ -0,0 +1,52 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Registry of argument labels
+ *
+ *  Each ArgLabel is registered once and mapped to a small integer id
+ *  (ArgLabelId), and its properties (core, continuation, and reference
+ *  argument) are computed at registration, so that the labels can be
+ *  stored and compared as integers.
+ *
+ *  The empty label and NULL are always registered with EMPTY_LABEL_ID and
+ *  NULL_LABEL_ID (see Constants.hpp).
+ *
+ */
+
+#ifndef ARGLABELS_HPP
+#define ARGLABELS_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "Types.hpp"
+
+using namespace std;
+
+
+class ArgLabelRegistry
+{
+ private:
+
+  static map<ArgLabel, ArgLabelId> ids;
+  static vector<ArgLabel> labels;
+  static vector<unsigned char> flags;
+
+  static void initialize();
+
+ public:
+
+  // returns the id of the label, registering it if it is new
+  static ArgLabelId getId(const ArgLabel &);
+  static const ArgLabel &getLabel(ArgLabelId);
+  static unsigned short getCount();
+
+  static bool isArgument(ArgLabelId);
+  static bool isCore(ArgLabelId);
+  static bool isContinuation(ArgLabelId);
+  static bool isReference(ArgLabelId);
+};
+
+#endif /* ARGLABELS_HPP */
@@ -12,6 +12,7 @@
 #include "Sentence.hpp"
 #include "TBTree.hpp"
 #include "DataAnalysis.hpp"
+#include "MemoryAccount.hpp"
 
 
 Argument::Argument(Proposition * const & pProp, 
@@ -23,6 +24,7 @@ Argument::Argument(Proposition * const & pProp,
  wordSpan.end = 0;
  label = pLabel;
  argCnstnt = NULL;
+ MemoryAccount::add(MEM_ARGUMENTS, 1, sizeof(Argument) + pLabel.size());
  }
 
 Proposition *Argument::getProp()
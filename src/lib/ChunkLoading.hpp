@@ -0,0 +1,166 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Parallel loading of sentence-aligned chunks of the data, shared by the
+ *  loaders (CoNLLLoader and ULoader)
+ *
+ *  The data is split into chunks of (almost) equal number of sentences, one
+ *  per thread, and each chunk is loaded by a separate loader in a thread,
+ *  so that each thread has its own scratch (tree stack, etc.) and data
+ *  analysis. The chunk boundaries are found by skipping the sentences of
+ *  the first file without parsing them. The first chunk is loaded by the
+ *  calling thread, and the results are merged in the order of the chunks,
+ *  so that the sentences are in the same order as loaded sequentially.
+ *
+ *  A loader provides the following to be loaded in chunks:
+ *   - Loader *createChunkLoader(int pSentenceCount, int pSkippedLines):
+ *     a new loader of the same files loading pSentenceCount sentences,
+ *     which adds pSkippedLines to the line numbers it reports
+ *   - int loadChunk(const size_t pStarts[], vector<Sentence *> &): loads
+ *     the sentences starting at the given offsets of the files
+ *   - void mergeChunkLoader(Loader &): adds the counts (and analysis) of
+ *     a chunk loader
+ *
+ */
+
+#ifndef CHUNKLOADING_HPP
+#define CHUNKLOADING_HPP
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+#include <pthread.h>
+
+#include "CoNLLReader.hpp"
+#include "Sentence.hpp"
+
+using namespace std;
+
+
+// a chunk of sentences loaded by a worker thread with its own loader
+template <class Loader>
+struct ChunkLoadWorker
+{
+ Loader *loader;
+ vector<size_t> starts;
+ int sentenceCount;
+ int skippedLines;
+ vector<Sentence *> sentences;
+ int result;
+};
+
+template <class Loader>
+void *runChunkLoadWorker(void *pWorker)
+{
+ ChunkLoadWorker<Loader> *vWorker = (ChunkLoadWorker<Loader> *) pWorker;
+ vWorker->result = vWorker->loader->loadChunk(&vWorker->starts[0],
+                                              vWorker->sentences);
+ return NULL;
+}
+
+/**
+ *  loads up to pMaxSentences sentences (all if 0) of the files opened by
+ *  pReaders in at most pThreadCount chunks, appending them to pSentences
+ *
+ *  The merging stops at the first chunk failed to load (whose sentences
+ *  loaded before the failure are kept like when loading sequentially),
+ *  and the sentences of the next chunks are discarded.
+ */
+template <class Loader>
+int loadChunksParallel(Loader &pLoader,
+                       CoNLLReader pReaders[],
+                       unsigned short pFileCount,
+                       int pMaxSentences,
+                       unsigned short pThreadCount,
+                       vector<Sentence *> &pSentences)
+{
+ int vSentenceCount = 0;
+ while (((pMaxSentences == 0) || (vSentenceCount < pMaxSentences)) &&
+        pReaders[0].skipSentence())
+  vSentenceCount++;
+
+ unsigned short vChunkCount = pThreadCount;
+ if (vSentenceCount < vChunkCount)
+  vChunkCount = (vSentenceCount == 0) ? 1 : vSentenceCount;
+
+ vector<ChunkLoadWorker<Loader> > vWorkers (vChunkCount);
+ vector<pthread_t> vThreads (vChunkCount);
+
+ for (unsigned short t = 0; t < vChunkCount; t++)
+ {
+  vWorkers[t].starts.resize(pFileCount);
+  vWorkers[t].sentenceCount =
+   (int) ((long long) vSentenceCount * (t + 1) / vChunkCount) -
+   (int) ((long long) vSentenceCount * t / vChunkCount);
+  vWorkers[t].skippedLines = 0;
+  vWorkers[t].result = 0;
+  }
+
+ // finding the start of each chunk in the 1st file, counting the lines
+ // before it; since the lines of the files are aligned, the chunks start
+ // at the same lines of the other files (even if a sentence of them is 
+ // malformed, which is then reported by its chunk like loading sequentially)
+ vector<StrRef> tmpLines;
+ StrRef tmpLine;
+ for (unsigned short f = 0; f < pFileCount; f++)
+ {
+  int cntLine = 0;
+  pReaders[f].seek(0);
+  for (unsigned short t = 0; t < vChunkCount; t++)
+  {
+   for (; cntLine < vWorkers[t].skippedLines; cntLine++)
+    pReaders[f].readLine(tmpLine);
+   
+   vWorkers[t].starts[f] = pReaders[f].tell();
+   if (f > 0)
+    continue;
+   
+   // each sentence is followed by a blank line
+   vWorkers[t].skippedLines = cntLine;
+   for (int i = 0; i < vWorkers[t].sentenceCount; i++)
+   {
+    pReaders[f].readSentence(tmpLines);
+    cntLine += tmpLines.size() + 1;
+    }
+   }
+  }
+
+ for (unsigned short t = 0; t < vChunkCount; t++)
+  vWorkers[t].loader = pLoader.createChunkLoader(vWorkers[t].sentenceCount,
+                                                 vWorkers[t].skippedLines);
+
+ for (unsigned short t = 1; t < vChunkCount; t++)
+  if (pthread_create(&vThreads[t], NULL, runChunkLoadWorker<Loader>,
+                     &vWorkers[t]) != 0)
+  {
+   cerr << "Creating loading thread failed!" << endl;
+   exit(EXIT_FAILURE);
+   }
+
+ runChunkLoadWorker<Loader>(&vWorkers[0]);
+
+ for (unsigned short t = 1; t < vChunkCount; t++)
+  pthread_join(vThreads[t], NULL);
+
+ int vResult = 0;
+ for (unsigned short t = 0; t < vChunkCount; t++)
+ {
+  if (vResult == 0)
+  {
+   pSentences.insert(pSentences.end(), vWorkers[t].sentences.begin(),
+                     vWorkers[t].sentences.end());
+   pLoader.mergeChunkLoader(*vWorkers[t].loader);
+   vResult = vWorkers[t].result;
+   }
+  else
+   for (unsigned i = 0; i < vWorkers[t].sentences.size(); i++)
+    delete vWorkers[t].sentences[i];
+
+  delete vWorkers[t].loader;
+  }
+
+ return vResult;
+}
+
+#endif /* CHUNKLOADING_HPP */
@@ -8,6 +8,9 @@
 
 #include <fstream>
 #include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
 
 #include "maxentmodel.hpp"
 
@@ -15,11 +18,21 @@
 #include "Sample.hpp"
 #include "Sentence.hpp"
 #include "Utils.hpp"
+#include "Metrics.hpp"
+#include "Logging.hpp"
+#include "FeatureHasher.hpp"
+#include "Constants.hpp"
 
 
 ZMEClassifier::ZMEClassifier()
 {
  no = -1;
+ fastEval = false;
+ trainingThreads = 0;
+ featureCutoff = 0;
+ negativeRate = 0;
+ idThreshold = 0;
+ incrementalTraining = true;
  cpuUsage = 0;
  elapsedTime = 0;
 }
@@ -29,6 +42,278 @@ double ZMEClassifier::getElapsedTime()
  return elapsedTime;
 }
 
+void ZMEClassifier::setFastEvaluation(bool pFastEval)
+{
+ fastEval = pFastEval;
+}
+
+void ZMEClassifier::setTrainingThreads(unsigned short pTrainingThreads)
+{
+ trainingThreads = pTrainingThreads;
+}
+
+void ZMEClassifier::setFeatureCutoff(unsigned pFeatureCutoff)
+{
+ featureCutoff = pFeatureCutoff;
+}
+
+void ZMEClassifier::setNegativeSamplingRate(double pNegativeRate)
+{
+ negativeRate = pNegativeRate;
+}
+
+void ZMEClassifier::setIdentificationThreshold(double pIdThreshold)
+{
+ idThreshold = pIdThreshold;
+}
+
+void ZMEClassifier::setTmpFileSuffix(const string &pSuffix)
+{
+ tmpFileSuffix = pSuffix;
+}
+
+void ZMEClassifier::setIncrementalTraining(bool pIncremental)
+{
+ incrementalTraining = pIncremental;
+}
+
+/**
+ *  returns the probability of the context being an argument by the 
+ *  identification model (1 if the identification stage is not used)
+ */
+double ZMEClassifier::getArgProb(vector<string> &pContext)
+{
+ if (idThreshold <= 0)
+  return 1;
+ 
+ vector<pair<ArgLabel, double> > vIdLabels;
+ evalModel(zmeIdModel, pContext, vIdLabels, false);
+ for (vector<pair<ArgLabel, double> >::iterator itLabel = vIdLabels.begin(); 
+      itLabel < vIdLabels.end(); 
+      itLabel++)
+  if (itLabel->first == "ARG")
+   return itLabel->second;
+ 
+ return 0;
+}
+
+/**
+ *  evaluates the given model for the context; the negative features of 
+ *  signed hashing are given to it as the buckets with value -1
+ */
+void ZMEClassifier::evalModel(maxent::MaxentModel &pZMEModel,
+                              vector<string> &pContext,
+                              vector<pair<ArgLabel, double> > &pPrdLabels,
+                              bool pSort)
+{
+ if (!FeatureHasher::isSigned())
+ {
+  pZMEModel.eval_all(pContext, pPrdLabels, pSort);
+  return;
+  }
+ 
+ vector<pair<string, float> > vValuedContext;
+ FeatureHasher::getValuedContext(pContext, vValuedContext);
+ pZMEModel.eval_all(vValuedContext, pPrdLabels, pSort);
+}
+
+/**
+ *  predicts the labels of the sample for the feature view: the samples not
+ *  identified as argument by the identification stage are labeled NULL 
+ *  with the identification confidence, and the rest are labeled by the
+ *  scorer (for the interned context of the sample) or zmeModel
+ */
+void ZMEClassifier::evalSample(Sample &pSample, 
+                               unsigned short pFeatureView,
+                               vector<pair<ArgLabel, double> > &pPrdLabels)
+{
+ bool vByScorer = fastEval && zmeScorer.isLoaded();
+ 
+ // the feature strings are only needed by maxent
+ vector<string> vContext;
+ if ((idThreshold > 0) || !vByScorer)
+  pSample.getZMEContext(vContext, pFeatureView);
+ 
+ double vArgProb = getArgProb(vContext);
+ if (vArgProb < idThreshold)
+  pPrdLabels.assign(1, pair<ArgLabel, double>("NULL", 1 - vArgProb));
+ else if (vByScorer)
+ {
+  vector<double> vProbs;
+  zmeScorer.evalAll(pSample.getZMEContextIds(pFeatureView), vProbs);
+  zmeScorer.getTopLabels(vProbs, PRD_LABEL_TOP_K, pPrdLabels);
+  }
+ else
+  evalModel(zmeModel, vContext, pPrdLabels, true);
+}
+
+/**
+ *  Randomly keeps ceil(n * negativeRate) of the n negative samples of a 
+ *  proposition and returns the weight of each kept sample (n / kept), so
+ *  that the total weight of negatives of the proposition is preserved. 
+ *  Sampling per proposition (rather than capping the total number) keeps
+ *  negatives from all parts of the data.
+ */
+double ZMEClassifier::selectNegatives(vector<Sample *> &pNegatives)
+{
+ if ((negativeRate <= 0) || (negativeRate >= 1) || pNegatives.empty())
+  return 1;
+ 
+ unsigned vCount = pNegatives.size();
+ unsigned vKept = (unsigned) ceil(vCount * negativeRate);
+ 
+ random_shuffle(pNegatives.begin(), pNegatives.end());
+ pNegatives.resize(vKept);
+ 
+ return (double) vCount / vKept;
+}
+
+/**
+ *  returns true if the models are trained by the parallel trainer, i.e.
+ *  when its threads are set or the method is only provided by it
+ */
+bool ZMEClassifier::usesPMETrainer(const string &pMethod)
+{
+ return (trainingThreads > 0) || PMETrainer::isOnlineMethod(pMethod);
+}
+
+/**
+ *  Applies the feature cutoff to the merged training events, logs the
+ *  reductions of the event space, and adds the weighted events to 
+ *  the given model or the parallel trainer. The event space is cleared afterward
+ *  to release its memory before training.
+ */
+void ZMEClassifier::addEvents(MEEventSpace &pEventSpace, 
+                              PMETrainer &pPMETrainer, 
+                              maxent::MaxentModel &pZMEModel,
+                              const string &pMethod,
+                              ofstream &pLog)
+{
+ bool vByPMETrainer = usesPMETrainer(pMethod);
+ 
+ pEventSpace.applyCutoff();
+ 
+ mout("\n" + intToStr(pEventSpace.getAddedCount()) + " events merged into " + 
+      intToStr(pEventSpace.getEventCount()) + " distinct events\n", cout, pLog);
+ mout(intToStr(pEventSpace.getDroppedFeatureCount()) + " of " + 
+      intToStr(pEventSpace.getFeatureCount()) + " features dropped by cutoff " +
+      intToStr(featureCutoff) + "\n", cout, pLog);
+ 
+ if (vByPMETrainer)
+  pPMETrainer.beginAddEvent();
+ else
+  pZMEModel.begin_add_event();
+ 
+ vector<string> vContext;
+ for (map<MEEvent, double>::const_iterator itEvent = pEventSpace.begin(); 
+      itEvent != pEventSpace.end(); 
+      itEvent++)
+ {
+  pEventSpace.getContext(itEvent->first.first, vContext);
+  if (vByPMETrainer)
+   pPMETrainer.addEvent(vContext, itEvent->first.second, itEvent->second);
+  // maxent only accepts integer counts, so the weights of sampled 
+  // negatives are rounded; the negative features of signed hashing are
+  // given as the buckets with value -1
+  else if (FeatureHasher::isSigned())
+  {
+   vector<pair<string, float> > vValuedContext;
+   FeatureHasher::getValuedContext(vContext, vValuedContext);
+   pZMEModel.add_event(vValuedContext, itEvent->first.second, 
+                       (size_t) (itEvent->second + 0.5));
+   }
+  else
+   pZMEModel.add_event(vContext, itEvent->first.second, 
+                      (size_t) (itEvent->second + 0.5));
+  }
+ 
+ pEventSpace.clear();
+ 
+ if (vByPMETrainer)
+  pPMETrainer.endAddEvent();
+ else
+  pZMEModel.end_add_event();
+}
+
+/**
+ *  Trains the given model either by itself or by the parallel trainer. In  
+ *  the latter case, the trained model is saved into the given file and 
+ *  then loaded into the model, so that the rest of the classifier is unaware
+ *  of the backend used. The online methods start from the model last saved
+ *  (pLastPMEModelFile) if any, unless incremental training is unset.
+ */
+void ZMEClassifier::trainModel(PMETrainer &pPMETrainer,
+                               maxent::MaxentModel &pZMEModel,
+                               const size_t &pIteration,
+                               const string &pMethod,
+                               const double &pGaussian,
+                               const string &pPMEModelFile,
+                               string &pLastPMEModelFile,
+                               ofstream &pLog)
+{
+ // neither maxent nor the parallel trainer can train GIS with the negative
+ // values of signed hashing
+ if ((pMethod == "gis") && FeatureHasher::isSigned())
+ {
+  cerr << "GIS can't be used with signed feature hashing!" << endl;
+  exit(EXIT_FAILURE);
+  }
+ 
+ if (!usesPMETrainer(pMethod))
+ {
+  pZMEModel.train(pIteration, pMethod, pGaussian);
+  return;
+  }
+ 
+ if (PMETrainer::isOnlineMethod(pMethod) && incrementalTraining && 
+     !pLastPMEModelFile.empty() &&
+     (pPMETrainer.loadWeights(pLastPMEModelFile) == 0))
+  mout("\nUpdating the previous model (" + pLastPMEModelFile + ")\n", 
+       cout, pLog);
+ 
+ if ((pPMETrainer.train(pIteration, pMethod, pGaussian) != 0) ||
+     (pPMETrainer.save(pPMEModelFile) != 0))
+ {
+  cerr << "Training by parallel trainer failed!" << endl;
+  exit(EXIT_FAILURE);
+  }
+ 
+ pLog << endl << "Parallel trainer: " << pPMETrainer.getEventCount() << " events, " 
+      << pPMETrainer.getFeatureCount() << " features, " 
+      << pPMETrainer.getParamCount() << " parameters, ";
+ if (PMETrainer::isOnlineMethod(pMethod))
+  pLog << pMethod;
+ else
+  pLog << trainingThreads << " threads";
+ pLog << " (" << pPMETrainer.getElapsedTime() << " sec)" << endl;
+  
+ pZMEModel.load(pPMEModelFile);
+ pLastPMEModelFile = pPMEModelFile;
+}
+
+/**
+ *  Loads the weights of the trained model into the built-in scorer. If the
+ *  model has not been saved by train(), it is saved into a scorer model 
+ *  file to be loaded from. On failure, the classifier falls back to 
+ *  zmeModel.eval_all().
+ */
+void ZMEClassifier::loadScorer(bool pModelSaved, 
+                               const string &pModelFile, 
+                               ofstream &pLog)
+{
+ string vModelFile = pModelFile;
+ 
+ if (!pModelSaved)
+ {
+  vModelFile = ZME_SCORER_MODEL_FILE + tmpFileSuffix;
+  zmeModel.save(vModelFile);
+  }
+  
+ if (zmeScorer.load(vModelFile) != 0)
+  mout("\nLoading the model into scorer failed; eval_all() is used instead!\n", 
+       cout, pLog);
+}
+
 /**
  *  This version of train() accepts a vector of example training sentences
  *  and extract samples of propositions of each sentence and train by those
@@ -59,14 +344,17 @@ void ZMEClassifier::train(vector<Sentence *> &pSentences,
                           const string &pModelFile,
                           ofstream &pLog)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("train");
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
   
  maxent::verbose = pVerbose;
- zmeModel.begin_add_event();
+ PMETrainer oPMETrainer (trainingThreads, pVerbose);
+ MEEventSpace oEventSpace (featureCutoff);
+ // events of the identification model (labels collapsed into ARG / NULL)
+ PMETrainer oIdPMETrainer (trainingThreads, pVerbose);
+ MEEventSpace oIdEventSpace (featureCutoff);
 
  unsigned int cntSamples = 0;
  vector<Sentence *>::iterator itSentence;
@@ -82,55 +370,101 @@ void ZMEClassifier::train(vector<Sentence *> &pSentences,
        itProp++)
   {
    vector<Sample *> vSamples;
+   vector<Sample *> vNegatives;
    
    (*itProp)->getSamples(vSamples);	     
    for (vector<Sample *>::iterator itSample = vSamples.begin(); 
         itSample < vSamples.end(); 
         itSample++)
    {
-    vector<string> context;
-    (*itSample)->getZMEContext(context, pContextView);
-   
+    ArgLabel vLabel;
     if (pGold)
-     zmeModel.add_event(context, (*itSample)->getGoldArgLabel(), 1);
+     vLabel = (*itSample)->getGoldArgLabel();
     else
      // When self-training, a portion of samples have only gold labels
      // (labeled data). So, the gold label should be used instead of 
      // predicted one which does not exist. getPrdOrGoldArgLabel() does
      // it.
-     zmeModel.add_event(context, (*itSample)->getPrdOrGoldArgLabel(pLabelView), 1);
+     vLabel = (*itSample)->getPrdOrGoldArgLabel(pLabelView);
+    
+    // negatives are added after sampling
+    if ((negativeRate > 0) && (vLabel == "NULL"))
+    {
+     vNegatives.push_back(*itSample);
+     continue;
+     }
+    
+    vector<string> context;
+    (*itSample)->getZMEContext(context, pContextView);
+    oEventSpace.addEvent(context, vLabel, 1);
+    if (idThreshold > 0)
+     oIdEventSpace.addEvent(context, (vLabel == "NULL") ? "NULL" : "ARG", 1);
+    
+    cntSamples++;   
+    }
+   
+   double vWeight = selectNegatives(vNegatives);
+   for (vector<Sample *>::iterator itSample = vNegatives.begin(); 
+        itSample < vNegatives.end(); 
+        itSample++)
+   {
+    vector<string> context;
+    (*itSample)->getZMEContext(context, pContextView);
+    oEventSpace.addEvent(context, "NULL", vWeight);
+    if (idThreshold > 0)
+     oIdEventSpace.addEvent(context, "NULL", vWeight);
     
     cntSamples++;   
     }
    } 
 
-  cout << "\r" << itSentence - pSentences.begin() + 1 << " sentences processed ("
-               << cntSamples << " events added)          " << flush;
+  if (Progress::isDue())
+   cout << "\r" << itSentence - pSentences.begin() + 1 << " sentences processed ("
+                << cntSamples << " events added)          " << flush;
   } 
  
+ cout << "\r" << itSentence - pSentences.begin() << " sentences processed ("
+              << cntSamples << " events added)          " << flush;
  pLog << itSentence - pSentences.begin() << " sentences processed ("
                << cntSamples << " events added)          " << flush;
+ MetricsRecorder::addCount("events", cntSamples);
 
  if (pVerbose == 1)
   cout << endl;
- zmeModel.end_add_event();
+ addEvents(oEventSpace, oPMETrainer, zmeModel, pMethod, pLog);
 
  // training model
- zmeModel.train(pIteration, pMethod, pGaussian);
+ trainModel(oPMETrainer, zmeModel, pIteration, pMethod, pGaussian, 
+            PME_TRAINING_MODEL_FILE + intToStr(pContextView) + tmpFileSuffix, 
+            pmeModelFile, pLog);
  no++;
 
+ // training identification model
+ if (idThreshold > 0)
+ {
+  mout("\nTraining argument identification model ...\n", cout, pLog);
+  addEvents(oIdEventSpace, oIdPMETrainer, zmeIdModel, pMethod, pLog);
+  trainModel(oIdPMETrainer, zmeIdModel, pIteration, pMethod, pGaussian, 
+             PME_TRAINING_MODEL_FILE + intToStr(pContextView) + ".id" + 
+             tmpFileSuffix, pmeIdModelFile, pLog);
+  }
+
  //saving training model
  if (pSaveModel)
  {
   mout("\nSaving trained model of view " + intToStr(pContextView) + " ...\n", cout, pLog);
   zmeModel.save(pModelFile + intToStr(pContextView));
+  if (idThreshold > 0)
+   zmeIdModel.save(pModelFile + intToStr(pContextView) + ".id");
   mout("Saving trained model is done!\n", cout, pLog);
   }
  
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ if (fastEval)
+  loadScorer(pSaveModel, pModelFile + intToStr(pContextView), pLog);
+ 
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 }
 
 
@@ -154,14 +488,17 @@ void ZMEClassifier::train(vector<Sample *> &pSamples,
                           const string &pModelFile,
                           ofstream &pLog)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("train");
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
   
  maxent::verbose = pVerbose;
- zmeModel.begin_add_event();
+ PMETrainer oPMETrainer (trainingThreads, pVerbose);
+ MEEventSpace oEventSpace (featureCutoff);
+ // events of the identification model (labels collapsed into ARG / NULL)
+ PMETrainer oIdPMETrainer (trainingThreads, pVerbose);
+ MEEventSpace oIdEventSpace (featureCutoff);
 
  // adding samples to events
  vector<Sample *>::iterator itSample;
@@ -169,45 +506,78 @@ void ZMEClassifier::train(vector<Sample *> &pSamples,
       itSample < pSamples.end(); 
       itSample++)
  {
-  vector<string> context;
-  (*itSample)->getZMEContext(context, pContextView);
-   
+  ArgLabel vLabel;
   if (pGold)
-   zmeModel.add_event(context, (*itSample)->getGoldArgLabel(), 1);
+   vLabel = (*itSample)->getGoldArgLabel();
   else
    // When self-training, a portion of samples have only gold labels
    // (labeled data). So, the gold label should be used instead of 
    // predicted one which does not exist. getPrdOrGoldArgLabel() does
    // it.
-   zmeModel.add_event(context, (*itSample)->getPrdOrGoldArgLabel(pLabelView), 1);
+   vLabel = (*itSample)->getPrdOrGoldArgLabel(pLabelView);
+  
+  // samples are not grouped by proposition here, so each negative is kept
+  // with the probability of the sampling rate and weighted by its inverse
+  double vWeight = 1;
+  if ((negativeRate > 0) && (negativeRate < 1) && (vLabel == "NULL"))
+  {
+   if (uniformDeviate(rand()) >= negativeRate)
+    continue;
+   vWeight = 1 / negativeRate;
+   }
   
-  cout << "\r" << itSample - pSamples.begin() + 1
-               << " samples added" << flush;
+  vector<string> context;
+  (*itSample)->getZMEContext(context, pContextView);
+  oEventSpace.addEvent(context, vLabel, vWeight);
+  if (idThreshold > 0)
+   oIdEventSpace.addEvent(context, (vLabel == "NULL") ? "NULL" : "ARG", vWeight);
+  
+  if (Progress::isDue())
+   cout << "\r" << itSample - pSamples.begin() + 1
+                << " samples added" << flush;
   }
 
+ cout << "\r" << itSample - pSamples.begin() << " samples added" << flush;
  pLog << itSample - pSamples.begin()
      << " samples added" << flush;
+ MetricsRecorder::addCount("events", itSample - pSamples.begin());
 
  if (pVerbose == 1)
   cout << endl;
- zmeModel.end_add_event();
+ addEvents(oEventSpace, oPMETrainer, zmeModel, pMethod, pLog);
 
  // training model
- zmeModel.train(pIteration, pMethod, pGaussian);
+ trainModel(oPMETrainer, zmeModel, pIteration, pMethod, pGaussian, 
+            PME_TRAINING_MODEL_FILE + intToStr(pContextView) + tmpFileSuffix, 
+            pmeModelFile, pLog);
  no++;
 
+ // training identification model
+ if (idThreshold > 0)
+ {
+  mout("\nTraining argument identification model ...\n", cout, pLog);
+  addEvents(oIdEventSpace, oIdPMETrainer, zmeIdModel, pMethod, pLog);
+  trainModel(oIdPMETrainer, zmeIdModel, pIteration, pMethod, pGaussian, 
+             PME_TRAINING_MODEL_FILE + intToStr(pContextView) + ".id" + 
+             tmpFileSuffix, pmeIdModelFile, pLog);
+  }
+
  //saving training model
  if (pSaveModel)
  {
   mout("\nSaving trained model ...\n", cout, pLog);
   zmeModel.save(pModelFile);
+  if (idThreshold > 0)
+   zmeIdModel.save(pModelFile + ".id");
   mout("Saving trained model is done!\n", cout, pLog);
   }
  
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ if (fastEval)
+  loadScorer(pSaveModel, pModelFile, pLog);
+ 
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 }
 
 /**
@@ -218,6 +588,13 @@ void ZMEClassifier::train(vector<Sample *> &pSamples,
  *  The benefit is that any sentence- or proposition-based post-processing
  *  for optimization is made possible
  * 
+ *  Before evaluating the model, the sentences whose predictions for this
+ *  view have already been made by the current no of the classifier are 
+ *  excluded, and only the remaining (dirty) sentences are relabeled; inside 
+ *  a dirty sentence, the propositions labeled by the current model are 
+ *  skipped too. This avoids relabeling the whole pool in bootstrapping 
+ *  iterations when the labeled sentences are not removed from it.
+ * 
  *  returns the number of sentences labeled
  */
 unsigned ZMEClassifier::classify(vector<Sentence *> &pSentences,
@@ -225,69 +602,88 @@ unsigned ZMEClassifier::classify(vector<Sentence *> &pSentences,
                                  bool pCheckConstraints, 
                                  ofstream &pLog)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("label");
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
   
- unsigned int cntSamples = 0, cntIgnored = 0;
+ // collecting sentences which have not been labeled by this no of the 
+ // classifier
+ vector<Sentence *> vDirtySentences;
+ for (vector<Sentence *>::iterator itSentence = pSentences.begin(); 
+      itSentence < pSentences.end(); 
+      itSentence++)
+  if (!(*itSentence)->isLabeledBy(pFeatureView, no))
+   vDirtySentences.push_back(*itSentence);
+
+ unsigned int cntSamples = 0;
+ unsigned int cntIgnored = pSentences.size() - vDirtySentences.size();
  vector<Sentence *>::iterator itSentence;
  
- for (itSentence = pSentences.begin(); 
-      itSentence < pSentences.end(); 
+ for (itSentence = vDirtySentences.begin(); 
+      itSentence < vDirtySentences.end(); 
       itSentence++)
  {
-  bool vIgnore = false;
-  
   vector<Proposition *> vProps;
   
   (*itSentence)->getProps(vProps);
   for (vector<Proposition *>::iterator itProp = vProps.begin(); 
-       (itProp < vProps.end()) && (!vIgnore); 
+       itProp < vProps.end(); 
        itProp++)
   {
+   if ((*itProp)->isLabeledBy(pFeatureView, no))
+    continue;
+   
    vector<Sample *> vSamples;
+   vector<Sample *> vLabelingSamples;
    
    (*itProp)->getSamples(vSamples);	     
    for (vector<Sample *>::iterator itSample = vSamples.begin(); 
-        (itSample < vSamples.end()) && (!vIgnore); 
+        itSample < vSamples.end(); 
         itSample++)
-   {
-    vector<string> vContext;
-    (*itSample)->getZMEContext(vContext, pFeatureView);
+    // the sample may have been labeled individually by this no of the
+    // classifier (via the other version of classify())
+    if (!(*itSample)->isLabeledBy(pFeatureView, no))
+     vLabelingSamples.push_back(*itSample);
    
-    vector<pair<ArgLabel, double> > vPrdLabels;          
-    zmeModel.eval_all(vContext, vPrdLabels);
-    
-    // if this sample was not labeled becasue it has been previously labeled
-    // with this no of the classifier, do not continue labeling this sentence
-    if (!(*itSample)->setPrdArgLabels(vPrdLabels, pFeatureView, no, pCheckConstraints))
-     vIgnore = true;
+   vector< vector<pair<ArgLabel, double> > > vPrdLabels (vLabelingSamples.size());          
+   for (unsigned i = 0; i < vLabelingSamples.size(); i++)
+    evalSample(*vLabelingSamples[i], pFeatureView, vPrdLabels[i]);
     
-    cntSamples++;   
-    }
+   // global constraints are resolved for the whole proposition after all
+   // its samples are labeled
+   for (unsigned i = 0; i < vLabelingSamples.size(); i++)
+    vLabelingSamples[i]->setPrdArgLabels(vPrdLabels[i], pFeatureView, no, false);
+   
+   if (pCheckConstraints)
+    (*itProp)->resolveConstraints(pFeatureView);
+   
+   cntSamples += vLabelingSamples.size();   
+   
+   (*itProp)->setClassifierNo(pFeatureView, no);
    } 
 
-  if (vIgnore)
-   cntIgnored++;
-  
-  cout << "\r" << itSentence - pSentences.begin() + 1 << " sentences processed ("
-               << cntSamples << " samples)          " << flush;
+  if (Progress::isDue())
+   cout << "\r" << itSentence - vDirtySentences.begin() + 1 << " sentences processed ("
+                << cntSamples << " samples)          " << flush;
   } 
  
- cout << endl << itSentence - pSentences.begin() - cntIgnored << " sentences labeled";
+ cout << "\r" << vDirtySentences.size() << " sentences processed ("
+              << cntSamples << " samples)          " << flush;
+ cout << endl << vDirtySentences.size() << " sentences labeled";
  cout << endl << cntIgnored << " sentences ignored relabeling" << endl;
 
- pLog << itSentence - pSentences.begin() - cntIgnored << " sentences labeled" << endl;
+ pLog << vDirtySentences.size() << " sentences labeled" << endl;
  pLog << cntIgnored << " sentences ignored relabeling" << endl;
 
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ MetricsRecorder::addCount("sentences", vDirtySentences.size());
+ MetricsRecorder::addCount("samples", cntSamples);
+
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
  
- return itSentence - pSentences.begin() - cntIgnored;
+ return vDirtySentences.size();
 }
 
 /**
@@ -299,11 +695,10 @@ unsigned ZMEClassifier::classify(vector<Sample *> &pSamples,
                                  bool pCheckConstraints, 
                                  ofstream &pLog)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("label");
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
   
  unsigned int cntSamples = 0, cntIgnored = 0;
 
@@ -311,32 +706,37 @@ unsigned ZMEClassifier::classify(vector<Sample *> &pSamples,
       itSample < pSamples.end(); 
       itSample++)
  {
-  vector<string> vContext;
-  (*itSample)->getZMEContext(vContext, pFeatureView);
- 
-  vector<pair<ArgLabel, double> > vPrdLabels;          
-  zmeModel.eval_all(vContext, vPrdLabels);
-  // if the sample is not labeled (due to no change in the classifier which
-  // had assigned the previous label), increase the number of samples ignored 
+  // if the sample has already been labeled by this no of the classifier
+  // (no change in the classifier which had assigned the previous label), 
+  // do not evaluate the model and increase the number of samples ignored 
   // labeling
-  if (!(*itSample)->setPrdArgLabels(vPrdLabels, pFeatureView, no, pCheckConstraints))
+  if ((*itSample)->isLabeledBy(pFeatureView, no))
    cntIgnored++;
+  else
+  {
+   vector<pair<ArgLabel, double> > vPrdLabels;          
+   evalSample(**itSample, pFeatureView, vPrdLabels);
+   (*itSample)->setPrdArgLabels(vPrdLabels, pFeatureView, no, pCheckConstraints);
+   }
     
   cntSamples++;   
 
-  cout << "\r" << cntSamples << " samples processed          " << flush;
+  if (Progress::isDue())
+   cout << "\r" << cntSamples << " samples processed          " << flush;
   }
 
+ cout << "\r" << cntSamples << " samples processed          " << flush;
  cout << endl << cntSamples - cntIgnored << " samples labeled";
  cout << endl << cntIgnored << " samples ignored labeling" << endl;
 
  pLog << cntSamples - cntIgnored << " samples labeled" << endl;
  pLog << cntIgnored << " samples ignored labeling" << endl;
 
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ MetricsRecorder::addCount("samples", cntSamples - cntIgnored);
+
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 
  return cntSamples - cntIgnored;
 }
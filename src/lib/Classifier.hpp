@@ -14,6 +14,10 @@
 
 #include "maxentmodel.hpp"
 
+#include "Scorer.hpp"
+#include "Trainer.hpp"
+#include "EventSpace.hpp"
+
 using namespace std;
 
 
@@ -26,6 +30,48 @@ class ZMEClassifier
   
   maxent::MaxentModel zmeModel;
   
+  // binary argument identification model (ARG vs. NULL) used as the first 
+  // stage of labeling when the identification threshold is set; only the
+  // samples whose ARG probability reaches the threshold are labeled by
+  // zmeModel and the others are labeled NULL
+  maxent::MaxentModel zmeIdModel;
+  double idThreshold;
+  
+  // built-in scorer used instead of zmeModel.eval_all() when fast 
+  // evaluation is set; it is loaded with the weights of zmeModel after
+  // each training
+  ZMEScorer zmeScorer;
+  bool fastEval;
+  
+  // number of threads of the built-in parallel trainer used instead of 
+  // zmeModel.train() (0 for using zmeModel.train()); the model trained by
+  // it is loaded back into zmeModel
+  unsigned short trainingThreads;
+  
+  // the files the models were last saved into by the parallel trainer 
+  // (empty if not yet); the online methods (sgd and perceptron) start from
+  // their weights, so that retraining with newly selected samples updates
+  // the previous model instead of training from scratch
+  string pmeModelFile;
+  string pmeIdModelFile;
+  // false for always training the online methods from scratch (e.g. when
+  // benchmarking repeated trainings)
+  bool incrementalTraining;
+  
+  // features seen less than this in training events are dropped (0 or 1 
+  // for no cutoff)
+  unsigned featureCutoff;
+  
+  // rate of negative (NULL) samples of each proposition used in training
+  // (0 or 1 for using all); the selected ones are weighted to compensate
+  // for the unselected ones
+  double negativeRate;
+  
+  // added to the names of the files the models are temporarily saved into 
+  // (for the scorer and by the parallel trainer), so that processes running
+  // at the same time (e.g. sweep workers) do not overwrite each other's
+  string tmpFileSuffix;
+  
   // the number of times the classifier has been trained in a bootstrapping
   // process (-1 for initialization, 0 for the base classifier, and so on)
   unsigned no;
@@ -33,11 +79,34 @@ class ZMEClassifier
   double cpuUsage;
   double elapsedTime;
   
+  void loadScorer(bool, const string &, ofstream &);
+  
+  // dispatch adding events and training to zmeModel or the parallel trainer
+  bool usesPMETrainer(const string &);
+  void addEvents(MEEventSpace &, PMETrainer &, maxent::MaxentModel &, 
+                 const string &, ofstream &);
+  double selectNegatives(vector<Sample *> &);
+  double getArgProb(vector<string> &);
+  void evalModel(maxent::MaxentModel &, vector<string> &, 
+                 vector<pair<ArgLabel, double> > &, bool);
+  void evalSample(Sample &, unsigned short, 
+                  vector<pair<ArgLabel, double> > &);
+  void trainModel(PMETrainer &, maxent::MaxentModel &, const size_t &, 
+                  const string &, const double &, const string &, string &,
+                  ofstream &);
+  
  public:
 
   ZMEClassifier();
   
   double getElapsedTime();
+  void setFastEvaluation(bool);
+  void setTrainingThreads(unsigned short);
+  void setFeatureCutoff(unsigned);
+  void setNegativeSamplingRate(double);
+  void setIdentificationThreshold(double);
+  void setTmpFileSuffix(const string &);
+  void setIncrementalTraining(bool);
 
   // train() is provided in 2 versions: one accepts a vector of sentences
   // and extracts samples of propositions of each sentence and train by 
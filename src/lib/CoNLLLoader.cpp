@@ -9,12 +9,15 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
-#include <time.h>
 
 #include "Constants.hpp"
 #include "CoNLLLoader.hpp"
+#include "CoNLLReader.hpp"
+#include "ChunkLoading.hpp"
 #include "Sentence.hpp"
 #include "Utils.hpp"
+#include "Metrics.hpp"
+#include "Logging.hpp"
 #include "TBTree.hpp"
 #include "DTree.hpp"
 #include "DataAnalysis.hpp"
@@ -23,6 +26,9 @@
 using namespace std;
 
 
+// words, syntCha, syntDep, and props files
+#define CONLL_FILE_COUNT 4
+
 CoNLLLoader::CoNLLLoader(string &pWords, 
                          string &pSyntCha,
                          string &pSyntDep,
@@ -41,6 +47,11 @@ CoNLLLoader::CoNLLLoader(string &pWords,
  loadedPropsCount = 0;
  loadedArgsCount = 0;
  
+ precomputeTBTrees = false;
+ threadCount = 1;
+ displayProgress = true;
+ skippedLines = 0;
+ 
  cpuUsage = 0;
  elapsedTime = 0;
    
@@ -57,6 +68,16 @@ double CoNLLLoader::getElapsedTime()
  return elapsedTime;
 }
 
+void CoNLLLoader::setTBTreePrecomputation(bool pPrecompute)
+{
+ precomputeTBTrees = pPrecompute;
+}
+
+void CoNLLLoader::setThreadCount(unsigned short pThreadCount)
+{
+ threadCount = (pThreadCount == 0) ? 1 : pThreadCount;
+}
+
 
 /**
  *  @ 19.11.2009
@@ -70,46 +91,141 @@ double CoNLLLoader::getElapsedTime()
  *  maxSentences attribute of the class, unless it is set to 0 in which 
  *  case all sentences will be loaded.
  * 
+ *  If more than one thread is set, the sentences are loaded in parallel
+ *  (see loadDataParallel()).
+ * 
  */
 int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
 {
- string tmpWordForm, tmpSynt, tmpDep, tmpProps, tmpLemma;
- vector<string> tmpvcSynt, tmpvcDep, tmpvcProps;
- int cntLine = 0;
- int cntSentence = 0;
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("load");
+ int vResult;
  
- vStartClk = clock();
- time(&vStartTime);
-  
- ifstream strmWords (words.c_str());
- if(! strmWords)
+ oTimer.start();
+ 
+ if (threadCount > 1)
+  vResult = loadDataParallel(pSentences);
+ else
  {
-  cerr << "Can't open file: " << words << endl;
-  return -1;
+  CoNLLReader vReaders[CONLL_FILE_COUNT];
+  if (openFiles(vReaders) != 0)
+   return -1;
+  
+  vResult = loadSentences(vReaders, pSentences);
   }
+ 
+ lemmaCache.clear();
+ MetricsRecorder::addCount("sentences", pSentences.size());
+ 
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
+ 
+ return vResult;
+}
 
- ifstream strmSyntCha (syntCha.c_str());
- if(! strmSyntCha)
- {
-  cerr << "Can't open file: " << syntCha << endl;
+/**
+ *  loads the sentences in sentence-aligned chunks, one per thread, each by
+ *  a separate loader (see ChunkLoading.hpp)
+ */
+int CoNLLLoader::loadDataParallel(vector<Sentence *> & pSentences)
+{
+ CoNLLReader vReaders[CONLL_FILE_COUNT];
+ if (openFiles(vReaders) != 0)
   return -1;
-  }
+ 
+ int vResult = loadChunksParallel(*this, vReaders, CONLL_FILE_COUNT, 
+                                  maxSentences, threadCount, pSentences);
+ 
+ if (displayProgress && (vResult == 0))
+  cout << "\r" << loadedSentencesCount << " sentences loaded" << flush;
+ 
+ return vResult;
+}
 
- ifstream strmSyntDep (syntDep.c_str());
- if(! strmSyntDep)
- {
-  cerr << "Can't open file: " << syntDep << endl;
-  return -1;
-  }
+CoNLLLoader *CoNLLLoader::createChunkLoader(int pSentenceCount, 
+                                            int pSkippedLines)
+{
+ CoNLLLoader *vLoader = new CoNLLLoader (words, syntCha, syntDep, props, 
+                                         pSentenceCount);
+ vLoader->setTBTreePrecomputation(precomputeTBTrees);
+ vLoader->displayProgress = false;
+ vLoader->skippedLines = pSkippedLines;
+ 
+ return vLoader;
+}
 
- ifstream strmProps (props.c_str());
- if(! strmProps)
- {
-  cerr << "Can't open file: " << props << endl;
+void CoNLLLoader::mergeChunkLoader(CoNLLLoader &pLoader)
+{
+ loadedSentencesCount += pLoader.loadedSentencesCount;
+ loadedWordsCount += pLoader.loadedWordsCount;
+ loadedCnstntCount += pLoader.loadedCnstntCount;
+ loadedPropsCount += pLoader.loadedPropsCount;
+ loadedArgsCount += pLoader.loadedArgsCount;
+ dataAnalysis->merge(*pLoader.dataAnalysis);
+}
+
+/**
+ *  loads the chunk of sentences starting at the given offsets of the files
+ *  (called by the worker threads)
+ */
+int CoNLLLoader::loadChunk(const size_t pStarts[], vector<Sentence *> &pSentences)
+{
+ CoNLLReader vReaders[CONLL_FILE_COUNT];
+ if (openFiles(vReaders) != 0)
   return -1;
-  }
+ 
+ for (unsigned short f = 0; f < CONLL_FILE_COUNT; f++)
+  vReaders[f].seek(pStarts[f]);
+ 
+ return loadSentences(vReaders, pSentences);
+}
+
+/**
+ *  returns the lemma of the word from the cache of the loader, extracting
+ *  it (see extractLemma()) only for a new pair of word form and POS; each
+ *  loading thread has its own loader, so the cache needs no lock
+ */
+const string &CoNLLLoader::getLemma(const string &pWordForm, const string &pPOS)
+{
+ pair<string, string> vKey (pWordForm, pPOS);
+ map<pair<string, string>, string>::iterator itLemma = lemmaCache.find(vKey);
+ if (itLemma == lemmaCache.end())
+  itLemma = lemmaCache.insert(make_pair(vKey, 
+                                        extractLemma(pWordForm, pPOS))).first;
+ 
+ return itLemma->second;
+}
+
+short CoNLLLoader::openFiles(CoNLLReader pReaders[])
+{
+ const string *vFiles[CONLL_FILE_COUNT] = {&words, &syntCha, &syntDep, &props};
+ 
+ for (unsigned short f = 0; f < CONLL_FILE_COUNT; f++)
+  if (pReaders[f].open(*vFiles[f]) != 0)
+  {
+   cerr << "Can't open file: " << *vFiles[f] << endl;
+   return -1;
+   }
+ 
+ return 0;
+}
+
+/**
+ *  reads the sentences from the opened files (words, syntCha, syntDep, and
+ *  props in this order) up to maxSentences
+ */
+int CoNLLLoader::loadSentences(CoNLLReader pReaders[], 
+                               vector<Sentence *> & pSentences)
+{
+ StrRef tmpWordForm, tmpSynt, tmpDep, tmpProps;
+ vector<StrRef> tmpvcSynt, tmpvcDep, tmpvcProps;
+ int cntLine = 0;
+ int cntSentence = 0;
+ CoNLLReader &strmWords = pReaders[0];
+ CoNLLReader &strmSyntCha = pReaders[1];
+ CoNLLReader &strmSyntDep = pReaders[2];
+ CoNLLReader &strmProps = pReaders[3];
  
  // looping to read sentences
  while (!(strmWords.eof() || strmSyntCha.eof()))
@@ -119,10 +235,10 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
    break;
   
   // reading the 1st line (in CoNLL format) of a sentence from files
-  getline(strmWords, tmpWordForm);
-  getline(strmSyntCha, tmpSynt);
-  getline(strmSyntDep, tmpDep);
-  getline(strmProps, tmpProps);
+  strmWords.readLine(tmpWordForm);
+  strmSyntCha.readLine(tmpSynt);
+  strmSyntDep.readLine(tmpDep);
+  strmProps.readLine(tmpProps);
   
   // If the 1st line of a sentence is empty, there is a blank line at the
   // begining of the sentence, which is not allowed, or it is the last line
@@ -142,7 +258,7 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
   { 
    Word * tmpWord = new Word ();
    // loading word form; word lemma is set after reading its POS
-   tmpWord->setWordForm(trim(tmpWordForm));
+   tmpWord->setWordForm(trim(tmpWordForm).str());
    
    // loading propositions and their arguments of the sentence
    tmpvcProps.clear();
@@ -157,7 +273,8 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
    // the related constituent to the proposition predicate
    tmpvcSynt.clear();
    tokenize(tmpSynt, tmpvcSynt, " \t\n\r");
-   tmpWord->setWordLemma(extractLemma(tmpWord->getWordForm(), tmpvcSynt.at(0)));
+   tmpWord->setWordLemma(getLemma(tmpWord->getWordForm(), 
+                                   tmpvcSynt.at(0).str()));
    appendToTBTree(*(pSentences.back()), tmpvcSynt.at(0), tmpvcSynt.at(1), 
                   pSentences.back()->getLength(),
                   ((tmpvcProps[0]) != "-"));
@@ -166,13 +283,13 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
    tmpvcDep.clear();
    tokenize(tmpDep, tmpvcDep, " \t\n\r");
    tmpHeadIdxs.push_back(strToInt(tmpvcDep[0]));
-   appendToDTree(*(pSentences.back()), tmpWord, tmpvcDep[1]);
+   appendToDTree(*(pSentences.back()), tmpWord, tmpvcDep[1].str());
    
    // reading the next lines (in CoNLL format) of a sentence from files
-   getline(strmWords, tmpWordForm);
-   getline(strmSyntCha, tmpSynt);
-   getline(strmSyntDep, tmpDep);
-   getline(strmProps, tmpProps);
+   strmWords.readLine(tmpWordForm);
+   strmSyntCha.readLine(tmpSynt);
+   strmSyntDep.readLine(tmpDep);
+   strmProps.readLine(tmpProps);
    cntLine++;
    }
   
@@ -180,21 +297,21 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
   if ((isEmptyLine(tmpWordForm)) && (!isEmptyLine(tmpSynt)))
   {
    cerr << "\nThere is a mismatch between word file and syntax file in line "
-        << cntLine << endl;
+        << skippedLines + cntLine << endl;
    return -1;
    }
   
   if ((isEmptyLine(tmpWordForm)) && (!isEmptyLine(tmpProps)))
   {
    cerr << "\nThere is a mismatch between word file and props file in line "
-        << cntLine << endl;
+        << skippedLines + cntLine << endl;
    return -1;
    }
 
   if ((isEmptyLine(tmpWordForm)) && (!isEmptyLine(tmpDep)))
   {
    cerr << "\nThere is a mismatch between word file and dependency file in line "
-        << cntLine << endl;
+        << skippedLines + cntLine << endl;
    return -1;
    }
 
@@ -202,9 +319,13 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
   //  to after completing the reading if it
   pSentences.back()->setDTreeHeads(tmpHeadIdxs);
   
+  if (precomputeTBTrees)
+   pSentences.back()->precomputeTBTree();
+  
   cntSentence++;
   
-  cout << "\r" << cntSentence << " sentences loaded" << flush;
+  if (displayProgress && Progress::isDue())
+   cout << "\r" << cntSentence << " sentences loaded" << flush;
   /*
   cout << endl;
   cout << cntSentence << "- ";
@@ -221,13 +342,11 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
   //getchar();
  }
  
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
-
- loadedSentencesCount = cntSentence;
- loadedWordsCount = cntLine - cntSentence;
+ if (displayProgress)
+  cout << "\r" << cntSentence << " sentences loaded" << flush;
+ 
+ loadedSentencesCount += cntSentence;
+ loadedWordsCount += cntLine - cntSentence;
  
  return 0;
 };
@@ -256,7 +375,7 @@ int CoNLLLoader::loadData(vector<Sentence *> & pSentences)
  *  to search is substantially more than number of arguments
  */
 void CoNLLLoader::appendToProps(Sentence &pCurrSentence,
-                                const vector<string> &propsLine, 
+                                const vector<StrRef> &propsLine, 
                                 const WordIdx &pWord)
 {
  string tmpLabel = "";
@@ -280,13 +399,13 @@ void CoNLLLoader::appendToProps(Sentence &pCurrSentence,
  if (propsLine.at(0) != "-")
  { 
   predRead++;
-  pCurrSentence.setPropPredLemma(predRead, propsLine.at(0));
+  pCurrSentence.setPropPredLemma(predRead, propsLine.at(0).str());
   pCurrSentence.setPropPredWord(predRead, pWord);
   }
  
  for (unsigned int cntrProp=1; cntrProp <= propCount; cntrProp++)
   for (unsigned int cntrTagChr=0; 
-       cntrTagChr < propsLine[cntrProp].size(); 
+       cntrTagChr < propsLine[cntrProp].size; 
        cntrTagChr++)
    if (propsLine[cntrProp][cntrTagChr] == '*')
    {
@@ -332,7 +451,7 @@ void CoNLLLoader::appendToProps(Sentence &pCurrSentence,
                                      pWord); 
     }
    else if (propsLine[cntrProp][cntrTagChr] != '(')
-    tmpLabel.append(propsLine[cntrProp].substr(cntrTagChr,1)); 
+    tmpLabel += propsLine[cntrProp][cntrTagChr]; 
 };
 
 /**
@@ -354,8 +473,8 @@ void CoNLLLoader::appendToProps(Sentence &pCurrSentence,
  * 
  */
 void CoNLLLoader::appendToTBTree(Sentence &pCurrSentence,
-                                 const string &pPOS, 
-                                 const string &pTagStr, 
+                                 const StrRef &pPOS, 
+                                 const StrRef &pTagStr, 
                                  const WordIdx pWord,
                                  const bool &pIsPredicate)
 {
@@ -365,7 +484,7 @@ void CoNLLLoader::appendToTBTree(Sentence &pCurrSentence,
  if (pWord == 1)
   tmpTBStack.clear();
  
- for (unsigned int i=0; i < pTagStr.size(); i++)
+ for (unsigned int i=0; i < pTagStr.size; i++)
   if (pTagStr[i] == '(')
   {
    if (!tmpTag.empty())
@@ -427,7 +546,7 @@ void CoNLLLoader::appendToTBTree(Sentence &pCurrSentence,
     // with firstWord = lastWord but not pushed back to stack, since 
     // it will not be needed to be assigned as parent for some others.
     TBTree *tbTreeNode = new TBTree (pCurrSentence, *tmpTBStack.back(), 
-                                     pPOS, pWord);
+                                     pPOS.str(), pWord);
     
     loadedCnstntCount++;
     tbTreeNode->setLastWord(pWord);
@@ -449,7 +568,7 @@ void CoNLLLoader::appendToTBTree(Sentence &pCurrSentence,
    tmpTBStack.pop_back();
    }
   else
-   tmpTag.append(pTagStr.substr(i,1)); 
+   tmpTag += pTagStr[i]; 
 };
 
 /**
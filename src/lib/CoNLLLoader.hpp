@@ -17,7 +17,9 @@
 
 #include <vector>
 #include <string>
+#include <map>
 #include "Sentence.hpp"
+#include "CoNLLReader.hpp"
 
 using namespace std;
 
@@ -59,15 +61,39 @@ class CoNLLLoader
   // reading whole the sentence
   vector<WordIdx> tmpHeadIdxs;
   
+  // lemmas extracted so far by word form and POS, so that WordNet, which
+  // is called under a lock shared by all loading threads, is only asked 
+  // for new words (see getLemma())
+  map<pair<string, string>, string> lemmaCache;
+  
+  // whether to precompute head words, subcat, etc. of the tree constituents
+  // of each sentence after loading it (see TBTree::precompute())
+  bool precomputeTBTrees;
+  
+  // number of threads loading sentence-aligned chunks of the data in
+  // parallel (see loadDataParallel())
+  unsigned short threadCount;
+  // whether to display the number of sentences loaded so far (off for the
+  // loaders of the chunks)
+  bool displayProgress;
+  // number of the lines of the files before the chunk loaded by the loader
+  // (added to the line numbers reported)
+  int skippedLines;
+  
   double cpuUsage;
   double elapsedTime;
   
   DataAnalysis *dataAnalysis;
 
-  void appendToTBTree(Sentence &, const string &, 
-                      const string &, const WordIdx, const bool &);
+  void appendToTBTree(Sentence &, const StrRef &, 
+                      const StrRef &, const WordIdx, const bool &);
   void appendToDTree(Sentence &, WordPtr &, const string &);
-  void appendToProps(Sentence &, const vector<string> &, const WordIdx &);
+  void appendToProps(Sentence &, const vector<StrRef> &, const WordIdx &);
+  
+  const string &getLemma(const string &, const string &);
+  short openFiles(CoNLLReader []);
+  int loadSentences(CoNLLReader [], vector<Sentence *> &);
+  int loadDataParallel(vector<Sentence *> &);
 
  public:
 
@@ -75,8 +101,15 @@ class CoNLLLoader
   ~CoNLLLoader();
   
   double getElapsedTime();
+  void setTBTreePrecomputation(bool);
+  void setThreadCount(unsigned short);
 
   int loadData(vector<Sentence *> &);  
+  // called by loadChunksParallel() to create the loader of a chunk, load
+  // the chunk in a worker thread, and merge the loader into this one
+  CoNLLLoader *createChunkLoader(int, int);
+  int loadChunk(const size_t [], vector<Sentence *> &);
+  void mergeChunkLoader(CoNLLLoader &);
   void logLoadedData();
   void logDataAnalysis();
 };
@@ -0,0 +1,299 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to CoNLLReader.hpp)
+ *
+ */
+
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+
+#include "CoNLLReader.hpp"
+#include "Constants.hpp"
+
+
+bool StrRef::operator==(const char *pStr) const
+{
+ return (strlen(pStr) == size) && (strncmp(data, pStr, size) == 0);
+}
+
+/**
+ *  writes the characters honoring the width of the stream like strings
+ */
+ostream &operator<<(ostream &pStrm, const StrRef &pStr)
+{
+ streamsize vWidth = pStrm.width();
+ pStrm.width(0);
+ if (vWidth > (streamsize) pStr.size)
+ {
+  if ((pStrm.flags() & ios::adjustfield) == ios::left)
+  {
+   pStrm.write(pStr.data, pStr.size);
+   for (streamsize i = pStr.size; i < vWidth; i++)
+    pStrm.put(pStrm.fill());
+   return pStrm;
+   }
+  
+  for (streamsize i = pStr.size; i < vWidth; i++)
+   pStrm.put(pStrm.fill());
+  }
+  
+ return pStrm.write(pStr.data, pStr.size);
+}
+
+void tokenize(const StrRef &pInput,
+              vector<StrRef> &pvcTokens,
+              const string &pSeparators)
+{
+ size_t vStart = 0;
+ while (vStart < pInput.size)
+ {
+  if (pSeparators.find(pInput[vStart]) != string::npos)
+  {
+   vStart++;
+   continue;
+   }
+
+  size_t vEnd = vStart + 1;
+  while ((vEnd < pInput.size) && (pSeparators.find(pInput[vEnd]) == string::npos))
+   vEnd++;
+  pvcTokens.push_back(StrRef(pInput.data + vStart, vEnd - vStart));
+  vStart = vEnd;
+  }
+}
+
+bool isEmptyLine(const StrRef &pInput)
+{
+ return trim(pInput).empty();
+}
+
+StrRef trim(const StrRef &pInput)
+{
+ size_t vStart = 0;
+ size_t vEnd = pInput.size;
+
+ while ((vStart < vEnd) && (pInput[vStart] == ' '))
+  vStart++;
+ while ((vEnd > vStart) && (pInput[vEnd - 1] == ' '))
+  vEnd--;
+
+ return StrRef(pInput.data + vStart, vEnd - vStart);
+}
+
+/**
+ *  parses a decimal integer, returning -1 if it is not a number (like 
+ *  strToInt)
+ */
+long strToInt(const StrRef &pStr)
+{
+ size_t i = 0;
+ while ((i < pStr.size) && isspace(pStr[i]))
+  i++;
+
+ bool vNegative = false;
+ if ((i < pStr.size) && ((pStr[i] == '-') || (pStr[i] == '+')))
+  vNegative = (pStr[i++] == '-');
+
+ if ((i == pStr.size) || !isdigit(pStr[i]))
+  return -1;
+
+ long vInt = 0;
+ for (; (i < pStr.size) && isdigit(pStr[i]); i++)
+  vInt = vInt * 10 + (pStr[i] - '0');
+
+ return vNegative ? -vInt : vInt;
+}
+
+
+CoNLLReader::CoNLLReader()
+{
+ buffer = NULL;
+ size = 0;
+ pos = 0;
+ reachedEOF = false;
+ mapped = false;
+}
+
+CoNLLReader::~CoNLLReader()
+{
+ close();
+}
+
+/**
+ *  maps the file into memory; if it cannot be mapped (e.g. it is a pipe),
+ *  it is read into memory at once
+ * 
+ *  If the file does not exist, the compressed one (with 
+ *  COMPRESSED_FILE_SUFFIX) is opened instead, and a compressed file is 
+ *  decompressed into memory at once.
+ */
+short CoNLLReader::open(const string &pFileName)
+{
+ close();
+ fileName = pFileName;
+
+ int vFD = ::open(fileName.c_str(), O_RDONLY);
+ if (vFD < 0)
+ {
+  fileName = pFileName + COMPRESSED_FILE_SUFFIX;
+  vFD = ::open(fileName.c_str(), O_RDONLY);
+  if (vFD < 0)
+   return -1;
+  }
+
+ // checking the gzip magic number
+ unsigned char vMagic[2];
+ if ((pread(vFD, vMagic, 2, 0) == 2) && (vMagic[0] == 0x1f) && (vMagic[1] == 0x8b))
+ {
+  ::close(vFD);
+  return readCompressed();
+  }
+
+ struct stat vStat;
+ if ((fstat(vFD, &vStat) == 0) && S_ISREG(vStat.st_mode))
+ {
+  size = vStat.st_size;
+  if (size == 0)
+  {
+   ::close(vFD);
+   buffer = "";
+   return 0;
+   }
+
+  void *vMap = mmap(NULL, size, PROT_READ, MAP_PRIVATE, vFD, 0);
+  if (vMap != MAP_FAILED)
+  {
+   madvise(vMap, size, MADV_SEQUENTIAL);
+   ::close(vFD);
+   buffer = (const char *) vMap;
+   mapped = true;
+   return 0;
+   }
+  }
+ ::close(vFD);
+
+ ifstream strmInput(fileName.c_str(), ios::binary);
+ if (!strmInput)
+  return -1;
+ fallbackBuffer.assign(istreambuf_iterator<char>(strmInput), 
+                       istreambuf_iterator<char>());
+ size = fallbackBuffer.size();
+ buffer = size ? &fallbackBuffer[0] : "";
+
+ return 0;
+}
+
+short CoNLLReader::readCompressed()
+{
+ gzFile vFile = gzopen(fileName.c_str(), "rb");
+ if (vFile == NULL)
+  return -1;
+
+ char vChunk[65536];
+ int vCount;
+ while ((vCount = gzread(vFile, vChunk, sizeof(vChunk))) > 0)
+  fallbackBuffer.insert(fallbackBuffer.end(), vChunk, vChunk + vCount);
+
+ if ((gzclose(vFile) != Z_OK) || (vCount < 0))
+ {
+  fallbackBuffer.clear();
+  return -1;
+  }
+
+ size = fallbackBuffer.size();
+ buffer = size ? &fallbackBuffer[0] : "";
+
+ return 0;
+}
+
+void CoNLLReader::close()
+{
+ if (mapped)
+  munmap((void *) buffer, size);
+
+ fallbackBuffer.clear();
+ buffer = NULL;
+ size = 0;
+ pos = 0;
+ reachedEOF = false;
+ mapped = false;
+}
+
+bool CoNLLReader::isOpen()
+{
+ return buffer != NULL;
+}
+
+bool CoNLLReader::eof()
+{
+ return reachedEOF;
+}
+
+bool CoNLLReader::readLine(StrRef &pLine)
+{
+ if (pos >= size)
+ {
+  reachedEOF = true;
+  pLine = StrRef(buffer, 0);
+  return false;
+  }
+
+ const char *vStart = buffer + pos;
+ const char *vEnd = (const char *) memchr(vStart, '\n', size - pos);
+ if (vEnd)
+  pos = vEnd - buffer + 1;
+ else
+ {
+  // the last line is not terminated
+  vEnd = buffer + size;
+  pos = size;
+  reachedEOF = true;
+  }
+
+ // removing the "\r" of CRLF line endings
+ if ((vEnd > vStart) && (*(vEnd - 1) == '\r'))
+  vEnd--;
+
+ pLine = StrRef(vStart, vEnd - vStart);
+ return true;
+}
+
+bool CoNLLReader::readSentence(vector<StrRef> &pLines)
+{
+ pLines.clear();
+
+ StrRef vLine;
+ while (readLine(vLine) && !isEmptyLine(vLine))
+  pLines.push_back(vLine);
+
+ return !pLines.empty();
+}
+
+bool CoNLLReader::skipSentence()
+{
+ StrRef vLine;
+ if (!readLine(vLine) || isEmptyLine(vLine))
+  return false;
+
+ while (readLine(vLine) && !isEmptyLine(vLine));
+
+ return true;
+}
+
+size_t CoNLLReader::tell()
+{
+ return pos;
+}
+
+void CoNLLReader::seek(size_t pPos)
+{
+ pos = (pPos < size) ? pPos : size;
+ reachedEOF = false;
+}
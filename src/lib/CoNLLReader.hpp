@@ -0,0 +1,97 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Memory-mapped reader of CoNLL files
+ *
+ *  The whole file is mapped into memory once and lines and their columns
+ *  are returned as StrRefs pointing into the mapped buffer, so nothing is
+ *  copied while reading; the strings are copied (by StrRef::str()) only
+ *  when they are stored (e.g. word forms and tags).
+ *
+ *  Compressed (gzip) files are decompressed into memory instead.
+ *
+ *  Lines are split on "\n" only, and a trailing "\r" is removed from each
+ *  line, so files with CRLF line endings are read like LF ones (unlike
+ *  getline(), which keeps the "\r"). Otherwise the reader behaves like 
+ *  getline() on an ifstream: reading past the last line returns an empty
+ *  line, and eof() becomes true when a read reaches the end of the file.
+ *
+ */
+
+#ifndef CONLLREADER_HPP
+#define CONLLREADER_HPP
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+
+// a reference to characters of the mapped file (not null-terminated)
+struct StrRef
+{
+ const char *data;
+ size_t size;
+
+ StrRef() : data(NULL), size(0) {}
+ StrRef(const char *pData, size_t pSize) : data(pData), size(pSize) {}
+
+ bool empty() const { return size == 0; }
+ char operator[](size_t pIdx) const { return data[pIdx]; }
+ string str() const { return string(data, size); }
+ bool operator==(const char *) const;
+ bool operator!=(const char *pStr) const { return !(*this == pStr); }
+};
+
+ostream &operator<<(ostream &, const StrRef &);
+
+// counterparts of the Utils functions of the same name for StrRefs
+void tokenize(const StrRef &, vector<StrRef> &, const string &);
+bool isEmptyLine(const StrRef &);
+StrRef trim(const StrRef &);
+long strToInt(const StrRef &);
+
+
+class CoNLLReader
+{
+ private:
+
+  string fileName;
+  const char *buffer;
+  size_t size;
+  size_t pos;
+  bool reachedEOF;
+  // whether buffer is mapped (or read into fallbackBuffer when mapping is 
+  // not possible, e.g. for pipes)
+  bool mapped;
+  vector<char> fallbackBuffer;
+
+  short readCompressed();
+
+ public:
+
+  CoNLLReader();
+  ~CoNLLReader();
+
+  short open(const string &);
+  void close();
+  bool isOpen();
+  bool eof();
+
+  // reads the next line; returns false (and an empty line) at the end
+  bool readLine(StrRef &);
+  // reads the lines up to the next blank line (or the end of file), 
+  // returning false if there was no line
+  bool readSentence(vector<StrRef> &);
+  // the same as readSentence() without collecting the lines
+  bool skipSentence();
+
+  // offset of the next line to read, which can be passed to seek() (e.g.
+  // to read a chunk of sentences by another reader of the same file)
+  size_t tell();
+  void seek(size_t);
+};
+
+#endif /* CONLLREADER_HPP */
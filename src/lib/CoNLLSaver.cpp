@@ -8,8 +8,46 @@
 
 #include <fstream>
 #include <iostream>
+#include <cstdlib>
 
 #include "CoNLLSaver.hpp"
+#include "Constants.hpp"
+#include "GzStream.hpp"
+#include "Metrics.hpp"
+
+
+bool CoNLLSaver::asyncSaving = false;
+bool CoNLLSaver::writerPending = false;
+pthread_t CoNLLSaver::pendingWriter;
+
+// a formatted props file handed to a writer thread in asynchronous saving
+struct PropsWriteJob
+{
+ OGzStream *strm;
+ string file;
+ string buffer;
+};
+
+static void *runPropsWriter(void *pJob)
+{
+ PropsWriteJob *vJob = (PropsWriteJob *) pJob;
+ 
+ vJob->strm->write(vJob->buffer.data(), vJob->buffer.size());
+ vJob->strm->close();
+ if (vJob->strm->fail())
+  cerr << "\nCan't write output file: " << vJob->file << endl;
+ 
+ delete vJob->strm;
+ delete vJob;
+ 
+ return NULL;
+}
+
+static void appendPadding(string &pBuffer, size_t pLength, size_t pWidth)
+{
+ if (pLength < pWidth)
+  pBuffer.append(pWidth - pLength, ' ');
+}
 
 
 CoNLLSaver::CoNLLSaver(string &pPropsFile)
@@ -28,96 +66,222 @@ double CoNLLSaver::getElapsedTime()
 }
 
 /**
- *  iterates sentences and gathers two kind of data for each to write
- *  in output props file (labeled data):
+ *  formats the rows of the sentence in CoNLL props format and appends them
+ *  to the buffer:
  * 
- *  1. a vector of strings representing predicates of the sentence according
- *     to 1st column of CoNLL props file (elements are "-" or a lemma) 
+ *  1. the first column contains the lemma of the predicate in the row of
+ *     each predicate and "-" in other rows, left aligned in 10 characters
  *  
- *  2. some vectors of strings , one for each proposition, representing 
- *     arguments of each proposition according to CoNLL props file (elements
- *     are startinig of argument, ending the argument, or "*")
+ *  2. the next columns, one for each proposition, contain the predicate 
+ *     and predicted arguments of the proposition in start/end format (e.g. 
+ *     "(A0*", "*)", or "*"), right aligned in 16 characters
+ * 
+ *  The cells are only marked (see Proposition::getSEMarks()) and then 
+ *  written from the labels, so no string is created per cell.
+ */
+void CoNLLSaver::formatSentence(Sentence *pSentence, unsigned short pFeatureView)
+{
+ short vLength = pSentence->getLength();
+ 
+ pSentence->getProps(props);
+ 
+ if (seKinds.size() < props.size())
+ {
+  seKinds.resize(props.size());
+  seLabels.resize(props.size());
+  }
+ 
+ // the last proposition of each predicate word gives the lemma of the row
+ predPropIdxs.assign(vLength, -1);
+ 
+ for (unsigned short cntProp = 0; cntProp < props.size(); cntProp++)
+ {
+  predPropIdxs.at(props[cntProp]->getPredWordIdx() - 1) = cntProp;
+  props[cntProp]->getSEMarks(seKinds[cntProp], seLabels[cntProp], pFeatureView);
+  }
+ 
+ for (short cntRow = 0; cntRow < vLength; cntRow++)
+ {
+  // writing first column (predicates)
+  string tmpLemma;
+  if (predPropIdxs[cntRow] != -1)
+   tmpLemma = props[predPropIdxs[cntRow]]->getPredLemma();
+  
+  if (tmpLemma.empty())
+   tmpLemma = "-";
+  
+  buffer += tmpLemma;
+  appendPadding(buffer, tmpLemma.size(), 10);
+  
+  // writing proposition columns (arguments in start/end format)
+  for (unsigned short cntCol = 0; cntCol < props.size(); cntCol++)
+  {
+   const string *vLabel = seLabels[cntCol][cntRow];
+   
+   switch (seKinds[cntCol][cntRow])
+   {
+    case SE_START:
+     appendPadding(buffer, vLabel->size() + 3, 16);
+     buffer += '(';
+     buffer += *vLabel;
+     buffer += "* ";
+     break;
+    case SE_SINGLE:
+     appendPadding(buffer, vLabel->size() + 3, 16);
+     buffer += '(';
+     buffer += *vLabel;
+     buffer += "*)";
+     break;
+    case SE_END:
+     appendPadding(buffer, 2, 16);
+     buffer += "*)";
+     break;
+    default:
+     appendPadding(buffer, 2, 16);
+     buffer += "* ";
+     }
+   }
+  
+  buffer += "     \n";
+  }
+ 
+ buffer += '\n';
+}
+
+/**
+ *  formats sentences into the buffer and writes it to the output props file
+ *  (labeled data) whenever it reaches PROPS_WRITE_BUFFER_SIZE (compressed 
+ *  when OGzStream compression is set)
  * 
- *  each row of the ouput file is written by iteratively choosing and writing
- *  these elements 
+ *  In asynchronous saving, the whole file is formatted here (so the 
+ *  sentences may be changed after returning) and then written by a thread
+ *  which should be waited for by waitPending() before the file is read.
+ *  The previous file is waited for first, so at most one file is pending
+ *  and a file being written is never opened again.
  */
 int CoNLLSaver::saveProps(vector<Sentence *> &pSentences, unsigned short pFeatureView)
 {
  int cntSentence = 0;
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("save");
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
+ 
+ waitPending();
   
- ofstream strmProps (propsFile.c_str());
- if(!strmProps)
+ OGzStream *strmProps = new OGzStream;
+ if (!strmProps->open(propsFile))
  {
   cerr << "\nCan't create output file: " << propsFile << endl;
+  delete strmProps;
   return -1;
   }
  
+ buffer.clear();
+ 
  // iterating sentences
  for (vector<Sentence *>::iterator itSentence = pSentences.begin(); 
       itSentence < pSentences.end(); 
       itSentence++, cntSentence++)
  {  
-  // getting predicates column vector
-  vector<string> vPredTemplate;
-  (*itSentence)->getPredTemplate(vPredTemplate);
+  formatSentence(*itSentence, pFeatureView);
   
-  // getting argument columns vectors (in start/end format (SE))
-  vector< vector<string> > vArgSEStrs;
-  (*itSentence)->getPropsArgsSEStrs(vArgSEStrs, pFeatureView);
+  if (!asyncSaving && (buffer.size() >= PROPS_WRITE_BUFFER_SIZE))
+  {
+   strmProps->write(buffer.data(), buffer.size());
+   buffer.clear();
+   }
+  }  
+ 
+ cout << "\r" << cntSentence << " sentences processed" << flush;
+ 
+ int vResult = 0;
+ 
+ if (asyncSaving)
+ {
+  PropsWriteJob *vJob = new PropsWriteJob;
+  vJob->strm = strmProps;
+  vJob->file = propsFile;
+  vJob->buffer.swap(buffer);
   
-  short vColCount = (*itSentence)->getPropCount() + 1;
+  if (pthread_create(&pendingWriter, NULL, runPropsWriter, vJob) != 0)
+  {
+   cerr << "Creating writing thread failed!" << endl;
+   exit(EXIT_FAILURE);
+   }
   
-  // looping for writing rows
-  for (short cntRow = 0; cntRow < (*itSentence)->getLength(); cntRow++)
+  writerPending = true;
+  }
+ else
+ {
+  strmProps->write(buffer.data(), buffer.size());
+  buffer.clear();
+  
+  strmProps->close();
+  if (strmProps->fail())
   {
-   string tmpStr;
-   
-   // writing first column (predicates)
-   if (vPredTemplate[cntRow].empty())
-   {
-    strmProps.width(10); strmProps << left 
-                                   << "-";
-    }
-   else
-   {
-    strmProps.width(10); strmProps << left 
-                                   << vPredTemplate[cntRow];
-    }
-   
-   // looping for writing proposition columns (arguments in start/end format)
-   for (short cntCol = 1; cntCol < vColCount; cntCol++)
-   {
-    if (vArgSEStrs[cntCol-1][cntRow].empty())
-    {
-     strmProps.width(16); strmProps << right 
-                                    << "* ";
-     }
-    else
-    {
-     strmProps.width(16); strmProps << right
-                                    << vArgSEStrs[cntCol-1][cntRow];
-     } 
-    }
-   strmProps << "     " << endl;
+   cerr << "\nCan't write output file: " << propsFile << endl;
+   vResult = -1;
    }
   
-  strmProps << endl;
-  cout << "\r" << cntSentence + 1 << " sentences processed" << flush;
-  }  
+  delete strmProps;
+  }
   
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 
  savedSentencesCount = cntSentence;
 
- return 0;
+ return vResult;
 }
 
+void CoNLLSaver::setAsyncSaving(bool pAsyncSaving)
+{
+ // making sure that the last file is complete even if the program returns
+ // without waiting for them
+ static bool vRegistered = false;
+ if (pAsyncSaving && !vRegistered)
+ {
+  atexit(waitPending);
+  vRegistered = true;
+  }
+ 
+ asyncSaving = pAsyncSaving;
+}
+
+void CoNLLSaver::waitPending()
+{
+ if (!writerPending)
+  return;
+ 
+ pthread_join(pendingWriter, NULL);
+ writerPending = false;
+}
 
+
+/**
+ *  The files are copied as they are, so when the output is compressed, the
+ *  compressed files (with COMPRESSED_FILE_SUFFIX) are copied
+ */
+int CoNLLSaver::copyProps(const string &pPropsFile, const string &pCopyFile)
+{
+ waitPending();
+ 
+ string vSuffix = OGzStream::isCompressing() ? COMPRESSED_FILE_SUFFIX : "";
+ 
+ ifstream strmProps ((pPropsFile + vSuffix).c_str(), ios::binary);
+ ofstream strmCopy ((pCopyFile + vSuffix).c_str(), ios::binary);
+ if (!strmProps || !strmCopy)
+ {
+  cerr << "Can't copy " << pPropsFile + vSuffix << " into " 
+       << pCopyFile + vSuffix << endl;
+  return -1;
+  }
+ 
+ if (strmProps.peek() != EOF)
+  strmCopy << strmProps.rdbuf();
+ strmCopy.close();
+ 
+ return strmCopy ? 0 : -1;
+}
@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <string>
+#include <pthread.h>
 #include "Sentence.hpp"
 
 using namespace std;
@@ -27,6 +28,22 @@ class CoNLLSaver
   double cpuUsage;
   double elapsedTime;
   
+  // formatted rows not written yet, and the propositions and cells of the
+  // sentence being formatted (kept to be reused for all sentences)
+  string buffer;
+  vector<Proposition *> props;
+  vector< vector<unsigned char> > seKinds;
+  vector< vector<const string *> > seLabels;
+  vector<short> predPropIdxs;
+  
+  // when set, the file is written in a separate thread after formatting, 
+  // so that saving overlaps the next steps of the caller
+  static bool asyncSaving;
+  static bool writerPending;
+  static pthread_t pendingWriter;
+  
+  void formatSentence(Sentence *, unsigned short);
+  
  public:
 
   CoNLLSaver(string &);
@@ -34,6 +51,15 @@ class CoNLLSaver
   double getElapsedTime();
 
   int saveProps(vector<Sentence *> &, unsigned short);  
+  
+  static void setAsyncSaving(bool);
+  
+  // waits for the file still being written by asynchronous saving
+  static void waitPending();
+  
+  // copies a saved props file (e.g. of the base classifier for each sweep
+  // configuration), returning 0 on success and -1 on failure
+  static int copyProps(const string &, const string &);
 };
 
 #endif /* CONLLSAVER_HPP */
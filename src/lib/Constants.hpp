@@ -34,6 +34,7 @@
 #define DEFAULT_CONLL_DEV_WSJ_PROPS_NAME "devel.24.props"
 
 #define DEFAULT_CONLL_TEST_OUTPUT_PATH "../../output"
+#define BENCHMARK_OUTPUT_PROPS_FILE "../../output/benchmark.props"
 
 #define MAX_TRAIN_POSITIVE 0    // 0 = all 
 #define MAX_TRAIN_NEGATIVE 0    // 0 = all 
@@ -49,10 +50,32 @@
 #define LOG_SELFTRAINING_OUTPUT_FILE_PREFIX "../../log/SelfTraining"
 #define LOG_COTRAINING_OUTPUT_FILE_PREFIX "../../log/CoTraining"
 #define LOG_LEARNING_CURVE_OUTPUT_FILE_PREFIX "../../log/LCurve"
+#define LOG_BENCHMARK_OUTPUT_FILE_PREFIX "../../log/Benchmark"
 
 #define ZME_TRAINING_SAMPLES_FILE "../../learning/ZMETrain"
 #define ZME_TRAINING_MODEL_FILE "../../learning/ZMEModel"
+#define ZME_SCORER_MODEL_FILE "../../learning/ZMEScorerModel"
 #define ZME_TEST_SAMPLES_FILE "../../learning/ZMETest"
+#define PME_TRAINING_MODEL_FILE "../../learning/PMEModel"
+
+// parameters of the built-in parallel ME trainer (see Trainer.hpp): the 
+// number of corrections kept by L-BFGS and the relative change of the 
+// objective function below which the training is considered converged
+#define PME_LBFGS_HISTORY 5
+#define PME_CONVERGENCE_EPSILON 1E-05
+// parameters of the online methods of the built-in trainer (sgd and 
+// perceptron): the base learning rate of SGD (scaled for each parameter by
+// AdaGrad) and the seed of shuffling the events in each pass
+#define PME_SGD_LEARNING_RATE 0.1
+#define PME_SHUFFLE_SEED 20100405
+
+// the maximum number of bits of the buckets of feature hashing (see 
+// FeatureHasher.hpp)
+#define MAX_FEATURE_HASHING_BITS 30
+
+// classifier no of the samples and propositions not labeled yet; distinct
+// from the no of an untrained classifier (-1)
+#define UNLABELED_CLASSIFIER_NO -2
 
 // the minumum number of sentences that should be selected by selection
 // criteria to consider there is room for further improvment
@@ -194,6 +217,15 @@
 #define TRIAL_F 200		               // to conveniently try a new feature
 #define E_O_F 0                        // end of features signal in the feature constant array (below)
 
+// dependency scope of the features:
+// The features listed in PROP_SCOPE_FEATURES depend only on the proposition
+// (predicate) and not on the candidate constituent, so they are extracted
+// once per proposition and shared by all its samples and feature views.
+// The other features are extracted for each sample.
+#define SAMPLE_SCOPE 0
+#define PROP_SCOPE 1
+const unsigned short PROP_SCOPE_FEATURES [] = {PL_F, PP_F, PV_F, PS_F, PF_F, PR_F, PCRP_F, PCPP_F, PSRP_F, PSPP_F, PPSRP_F, PPSPP_F, CPI_F, E_O_F};
+
 //  set 1 (CG) : complete constituent-based feature set (16 features: constituent-based + general features)
 //  set 2 (C)  : pure constituent-based feature set (10 features)
 //  set 3 (D)  : pure dependency-based feature set (17 features)
@@ -225,6 +257,96 @@ const std::string AUX_VERBS[] = {"be", "am", "is", "was", "are", "were", "been",
                                  
 const std::string CORE_ARGS[] = {"A0", "A1", "A2", "A3", "A4", "A5", "AA", ""};
 
+// head rule variants for NAC and WHNP (see HeadRules.hpp)
+#define CONLL_HEAD_VARIANT 1           // Surdeanu et al. (2008)
+#define JN_HEAD_VARIANT 2              // Johansson & Nugues (2007)
+
+// the maximum number of distinct syntactic tags (see HeadRules.hpp)
+#define MAX_SYNT_TAG_COUNT 1024
+
+/**
+ *  Head and content rules
+ * 
+ *  Each rule is a pair of parent tags (separated by space) and its steps 
+ *  (separated by ";") tried in order until one finds a child:
+ *   <TAGS : for each tag in order, scans children from right to left
+ *   >TAGS : for each tag in order, scans children from left to right
+ *   <[TAGS], >[TAGS] : scans children once for any of the tags
+ *   <![TAGS], >![TAGS] : scans children once for none of the tags
+ *  A tag may be a pattern: "NN*" (prefix), "*-PRD*" (infix), or "*" (any)
+ *  
+ *  The head rules are from Surdeanu et al. (2008); if no rule fires, the
+ *  first child is the head. The content rules are from Surdeanu et al. 
+ *  (2003); if no rule fires, the content child is the head child.
+ */
+const std::string HEAD_RULES [][2] = {{"ADJP", "<NNS QP NN $ ADVP JJ VBN VBG ADJP JJR NP JJS DT FW RBR RBS SBAR RB"},
+                                      {"ADVP", ">RB RBR RBS FW ADVP TO CD JJR JJ IN NP JJS NN"},
+                                      {"CONJP", ">CC RB IN"},
+                                      {"FRAG", ">[NN* NP]; >[W*]; >[SBAR]; >[PP IN]; >[ADJP JJ]; >ADVP RB"},
+                                      {"INTJ", "<[*]"},
+                                      {"LST", ">LS :"},
+                                      {"NAC WHNP", "<[NN* NX]; <JJR CD JJ JJS RB QP NP"},
+                                      {"NP NX", "<[NN* NX]; <JJR CD JJ JJS RB QP NP"},
+                                      {"PP WHPP", ">IN TO VBG VBN RP FW"},
+                                      {"PRN", ">[S*]; >[N*]; >[W*]; >[PP IN]; >[ADJP JJ*]; >[ADVP RB*]"},
+                                      {"PRT", ">[RP]"},
+                                      {"QP", "<$ IN NNS NN JJ RB DT CD NCD QP JJR JJS"},
+                                      {"RRC", ">VP NP ADVP ADJP PP"},
+                                      {"S", "<[VP]; <[*-PRD*]; <S SBAR ADJP UCP NP"},
+                                      {"SBAR", "<S SQ SINV SBAR FRAG IN DT"},
+                                      {"SBARQ", "<SQ S SINV SBARQ FRAG"},
+                                      {"SINV", "<VBZ VBD VBP VB MD VP; <[*-PRD*]; <S SINV ADJP NP"},
+                                      {"SQ", "<VBZ VBD VBP VB MD; <[*-PRD*]; <VP SQ"},
+                                      {"UCP", ">[*]"},
+                                      {"VP", ">VBD VBN MD VBZ VB VBG VBP VP; >[*-PRD*]; >ADJP NN NNS NP"},
+                                      {"WHADJP", "<CC WRB JJ ADJP"},
+                                      {"WHADVP", ">CC WRB"},
+                                      {"X", ">[*]"},
+                                      {"", ""}};
+                                      
+// the rules replacing the above ones in Johansson & Nugues (2007) variant
+const std::string JN_HEAD_RULES [][2] = {{"NAC", "<[NN*]; <NP NAC EX $ CD QP PRP VBG JJ JJS JJR ADJP FW"},
+                                         {"WHNP", "<[NN*]; <WDT WP WD$ WHADJP WHPP WHNP"},
+                                         {"", ""}};
+
+const std::string CONTENT_RULES [][2] = {{"PP", "<[*]"},
+                                         {"SBAR", ">[S*]"},
+                                         {"VP", ">[VP]"},
+                                         {"ADVP", "<![IN TO]"},
+                                         {"ADJP", "<[JJ* V* N* ADJP]"},
+                                         {"", ""}};
+
+// ids of the labels registered first in ArgLabelRegistry: the empty label
+// (not labeled) and NULL (non-argument)
+#define EMPTY_LABEL_ID 0
+#define NULL_LABEL_ID 1
+
+// number of the most probable predicted labels kept for each view of a 
+// sample
+#define PRD_LABEL_TOP_K 3
+
+// kinds of the cells of a proposition column in CoNLL props start/end format
+#define SE_NONE 0                      // "*"
+#define SE_START 1                     // "(A0*"
+#define SE_SINGLE 2                    // "(A0*)"
+#define SE_END 3                       // "*)"
+
+// size of the formatted props buffered before writing them to the file 
+#define PROPS_WRITE_BUFFER_SIZE 4194304
+
+// compressed output files (refer to GzStream.hpp)
+#define COMPRESSED_FILE_SUFFIX ".gz"
+#define GZ_COMPRESSION_LEVEL 6
+#define GZ_STREAM_BUFFER_SIZE 262144
+
+// intervals of progress lines (seconds) when the output is a terminal and
+// when it is redirected (refer to Logging.hpp)
+#define PROGRESS_TTY_INTERVAL 0.2
+#define PROGRESS_NON_TTY_INTERVAL 30
+
+// size of the buffer of asynchronous log files handed to their writer
+#define ASYNC_LOG_BUFFER_SIZE 65536
+
 const std::string WH[] = {"what", "which", "who", "how", "whose", "whom",
                           "when", "where", "why", ""};
 
@@ -13,6 +13,7 @@
 #include "DTree.hpp"
 #include "Utils.hpp"
 #include "Constants.hpp"
+#include "MemoryAccount.hpp"
 
 
 /**
@@ -30,6 +31,7 @@ DTree::DTree(Sentence &pSentence)
  sentence = &pSentence;
  word = NULL;
  parent = NULL;
+ MemoryAccount::add(MEM_DEP_NODES, 1, sizeof(DTree));
 }
 
 /**
@@ -41,6 +43,7 @@ DTree::DTree(Sentence &pSentence, WordPtr &pWord, const string &pDepRel)
  word = pWord;
  parent = NULL;
  depRel = pDepRel;
+ MemoryAccount::add(MEM_DEP_NODES, 1, sizeof(DTree) + pDepRel.size());
 }
 
 void DTree::setParent(DTNode &pParent)
@@ -74,6 +74,31 @@ void DataAnalysis::addPredCntCompound(Proposition * const &pProp)
  predsCntCompound.push_back(pProp);
 }
 
+void DataAnalysis::merge(const DataAnalysis &pAnalysis)
+{
+ sntncsAnalyzed += pAnalysis.sntncsAnalyzed;
+ propsAnalyzed += pAnalysis.propsAnalyzed;
+ cnttntsAnalyzed += pAnalysis.cnttntsAnalyzed;
+ argsAnalyzed += pAnalysis.argsAnalyzed;
+
+ argsNoMatch.insert(argsNoMatch.end(), 
+                    pAnalysis.argsNoMatch.begin(), pAnalysis.argsNoMatch.end());
+ argsOnLeaf.insert(argsOnLeaf.end(), 
+                   pAnalysis.argsOnLeaf.begin(), pAnalysis.argsOnLeaf.end());
+ argsNoPointBack.insert(argsNoPointBack.end(), 
+                        pAnalysis.argsNoPointBack.begin(), 
+                        pAnalysis.argsNoPointBack.end());
+ cnstntsNoPointBack.insert(cnstntsNoPointBack.end(), 
+                           pAnalysis.cnstntsNoPointBack.begin(), 
+                           pAnalysis.cnstntsNoPointBack.end());
+ predsDscntCompound.insert(predsDscntCompound.end(), 
+                           pAnalysis.predsDscntCompound.begin(), 
+                           pAnalysis.predsDscntCompound.end());
+ predsCntCompound.insert(predsCntCompound.end(), 
+                         pAnalysis.predsCntCompound.begin(), 
+                         pAnalysis.predsCntCompound.end());
+}
+
 /**
  *  Logs the result of analysis of data loaded from corpora
  */
@@ -59,6 +59,9 @@ class DataAnalysis
   void addCnstntNoPointBack(TBTree * const &);
   void addPredDscntCompound(Proposition * const &);
   void addPredCntCompound(Proposition * const &);
+  // appends the analysis of another part of data (e.g. a chunk loaded by
+  // another thread)
+  void merge(const DataAnalysis &);
   
   void logDataAnalysis(string &);
   void logArgsOnLeaf(ostream &);
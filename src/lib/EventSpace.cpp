@@ -0,0 +1,210 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to EventSpace.hpp)
+ *
+ */
+
+#include "EventSpace.hpp"
+#include "MemoryAccount.hpp"
+
+
+/**
+ *  approximate bytes of a merged event: the map node, the feature ids
+ *  and the label
+ */
+static long getEventBytes(const MEEvent &pEvent)
+{
+ return sizeof(pair<MEEvent, double>) + 4 * sizeof(void *) + 
+        pEvent.first.size() * sizeof(unsigned) + pEvent.second.size();
+}
+
+/**
+ *  approximate bytes of an interned feature: its map node, its string in
+ *  the map and the feature table, and its occurrence count
+ */
+static long getFeatureBytes(const string &pFeature)
+{
+ return sizeof(pair<string, unsigned>) + 4 * sizeof(void *) + 
+        2 * (sizeof(string) + pFeature.size()) + sizeof(unsigned);
+}
+
+
+MEEventSpace::MEEventSpace(unsigned pCutoff)
+{
+ cutoff = pCutoff;
+ addedCount = 0;
+ droppedFeatureCount = 0;
+ accountedBytes = 0;
+}
+
+MEEventSpace::~MEEventSpace()
+{
+ releaseEvents();
+}
+
+void MEEventSpace::addEvent(const vector<string> &pContext,
+                            const ArgLabel &pLabel,
+                            double pCount)
+{
+ long vBytes = 0;
+
+ MEEvent vEvent;
+ vEvent.first.reserve(pContext.size());
+ vEvent.second = pLabel;
+ for (vector<string>::const_iterator itFeature = pContext.begin();
+      itFeature < pContext.end();
+      itFeature++)
+ {
+  pair<map<string, unsigned>::iterator, bool> vFeature = 
+   featureIds.insert(make_pair(*itFeature, features.size()));
+  if (vFeature.second)
+  {
+   features.push_back(*itFeature);
+   vBytes += getFeatureBytes(*itFeature);
+   }
+  vEvent.first.push_back(vFeature.first->second);
+  }
+
+ // raw occurrences, regardless of the weight of the event
+ if (cutoff > 1)
+ {
+  featureOccurrences.resize(features.size(), 0);
+  for (vector<unsigned>::iterator itId = vEvent.first.begin();
+       itId < vEvent.first.end();
+       itId++)
+   featureOccurrences[*itId]++;
+  }
+
+ pair<map<MEEvent, double>::iterator, bool> vInserted = 
+  events.insert(make_pair(vEvent, 0.0));
+
+ if (vInserted.second)
+ {
+  vBytes += getEventBytes(vInserted.first->first);
+  MemoryAccount::add(MEM_EVENTS, 1, vBytes);
+  }
+ else if (vBytes > 0)
+  MemoryAccount::add(MEM_EVENTS, 0, vBytes);
+ accountedBytes += vBytes;
+
+ vInserted.first->second += pCount;
+ addedCount++;
+}
+
+void MEEventSpace::accountEvents()
+{
+ for (map<MEEvent, double>::iterator itEvent = events.begin();
+      itEvent != events.end();
+      itEvent++)
+  accountedBytes += getEventBytes(itEvent->first);
+
+ for (vector<string>::iterator itFeature = features.begin();
+      itFeature < features.end();
+      itFeature++)
+  accountedBytes += getFeatureBytes(*itFeature);
+
+ MemoryAccount::add(MEM_EVENTS, events.size(), accountedBytes);
+}
+
+void MEEventSpace::releaseEvents()
+{
+ MemoryAccount::add(MEM_EVENTS, -(long) events.size(), -accountedBytes);
+ accountedBytes = 0;
+}
+
+/**
+ *  Removes the features occurring in less than cutoff added events from
+ *  the contexts; the events whose contexts become identical are merged
+ *  again. The feature ids are kept, so the dropped features remain in the
+ *  feature table. Nothing is done (not even counting) for a cutoff of 0 or 1.
+ */
+void MEEventSpace::applyCutoff()
+{
+ droppedFeatureCount = 0;
+
+ if (cutoff <= 1)
+  return;
+
+ for (vector<unsigned>::iterator itCount = featureOccurrences.begin();
+      itCount < featureOccurrences.end();
+      itCount++)
+  if (*itCount < cutoff)
+   droppedFeatureCount++;
+
+ if (droppedFeatureCount == 0)
+  return;
+
+ map<MEEvent, double> vEvents;
+ for (map<MEEvent, double>::iterator itEvent = events.begin();
+      itEvent != events.end();
+      itEvent++)
+ {
+  const vector<unsigned> &vContext = itEvent->first.first;
+  MEEvent vFilteredEvent;
+  vFilteredEvent.second = itEvent->first.second;
+  for (vector<unsigned>::const_iterator itId = vContext.begin();
+       itId < vContext.end();
+       itId++)
+   if (featureOccurrences[*itId] >= cutoff)
+    vFilteredEvent.first.push_back(*itId);
+
+  vEvents[vFilteredEvent] += itEvent->second;
+  }
+
+ releaseEvents();
+ events.swap(vEvents);
+ accountEvents();
+}
+
+unsigned MEEventSpace::getAddedCount()
+{
+ return addedCount;
+}
+
+unsigned MEEventSpace::getEventCount()
+{
+ return events.size();
+}
+
+unsigned MEEventSpace::getFeatureCount()
+{
+ return features.size();
+}
+
+unsigned MEEventSpace::getDroppedFeatureCount()
+{
+ return droppedFeatureCount;
+}
+
+map<MEEvent, double>::const_iterator MEEventSpace::begin()
+{
+ return events.begin();
+}
+
+map<MEEvent, double>::const_iterator MEEventSpace::end()
+{
+ return events.end();
+}
+
+void MEEventSpace::getContext(const vector<unsigned> &pFeatureIds,
+                              vector<string> &pContext)
+{
+ pContext.clear();
+ for (vector<unsigned>::const_iterator itId = pFeatureIds.begin();
+      itId < pFeatureIds.end();
+      itId++)
+  pContext.push_back(features[*itId]);
+}
+
+void MEEventSpace::clear()
+{
+ releaseEvents();
+ events.clear();
+ featureIds.clear();
+ features.clear();
+ featureOccurrences.clear();
+ addedCount = 0;
+ droppedFeatureCount = 0;
+}
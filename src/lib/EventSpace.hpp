@@ -0,0 +1,80 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Event space to collect training events before passing them to a ME
+ *  trainer
+ *
+ *  The features are interned as they are added, and identical (context, 
+ *  label) events are merged on their feature ids into one weighted event
+ *  (many NULL samples share the same context), so that each feature string
+ *  is stored once. Features occurring in less than a cutoff number of added
+ *  events can be dropped before training.
+ *
+ */
+
+#ifndef EVENTSPACE_HPP
+#define EVENTSPACE_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "Types.hpp"
+
+using namespace std;
+
+
+// an event as the ids of its context features and its label
+typedef pair<vector<unsigned>, ArgLabel> MEEvent;
+
+class MEEventSpace
+{
+ private:
+
+  // interned features and the number of added events containing each one
+  // (counted only when a feature cutoff is to be applied)
+  map<string, unsigned> featureIds;
+  vector<string> features;
+  vector<unsigned> featureOccurrences;
+
+  // merged events paired with their weight (count)
+  map<MEEvent, double> events;
+
+  unsigned cutoff;
+  unsigned addedCount;
+  unsigned droppedFeatureCount;
+
+  // bytes of the events and features added to the memory account
+  long accountedBytes;
+
+  void accountEvents();
+  void releaseEvents();
+
+ public:
+
+  // features occurring in less than the given number of added events are
+  // dropped by applyCutoff() (none if it is 0 or 1)
+  MEEventSpace(unsigned);
+  ~MEEventSpace();
+
+  void addEvent(const vector<string> &, const ArgLabel &, double);
+  // drops the features occurring less than the cutoff and merges the 
+  // events which become identical
+  void applyCutoff();
+
+  // number of events added before merging
+  unsigned getAddedCount();
+  // number of distinct (merged) events
+  unsigned getEventCount();
+  unsigned getFeatureCount();
+  unsigned getDroppedFeatureCount();
+
+  map<MEEvent, double>::const_iterator begin();
+  map<MEEvent, double>::const_iterator end();
+  // fills the feature strings of the given event context
+  void getContext(const vector<unsigned> &, vector<string> &);
+  void clear();
+};
+
+#endif /* EVENTSPACE_HPP */
@@ -0,0 +1,98 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to FeatureHasher.hpp)
+ *
+ */
+
+#include <iostream>
+
+#include "FeatureHasher.hpp"
+#include "Constants.hpp"
+
+
+unsigned short FeatureHasher::bits = 0;
+bool FeatureHasher::signedHashing = false;
+
+void FeatureHasher::setHashing(unsigned short pBits, bool pSigned)
+{
+ if (pBits > MAX_FEATURE_HASHING_BITS)
+ {
+  cerr << "Feature hashing bits is limited to " << MAX_FEATURE_HASHING_BITS 
+       << "!" << endl;
+  pBits = MAX_FEATURE_HASHING_BITS;
+  }
+
+ bits = pBits;
+ signedHashing = (pBits > 0) && pSigned;
+}
+
+bool FeatureHasher::isHashing()
+{
+ return bits > 0;
+}
+
+bool FeatureHasher::isSigned()
+{
+ return signedHashing;
+}
+
+/**
+ *  The name, '=' and the value (i.e. the feature string without hashing)
+ *  are hashed by 64-bit FNV-1a followed by the finalizer of MurmurHash3 to
+ *  mix its bits; the bucket is taken from the low bits and the sign from
+ *  the highest one.
+ */
+string FeatureHasher::hash(const string &pName, const string &pValue)
+{
+ unsigned long long vHash = 14695981039346656037ULL;
+
+ for (string::const_iterator itChar = pName.begin(); itChar < pName.end(); itChar++)
+  vHash = (vHash ^ (unsigned char) *itChar) * 1099511628211ULL;
+ vHash = (vHash ^ (unsigned char) '=') * 1099511628211ULL;
+ for (string::const_iterator itChar = pValue.begin(); itChar < pValue.end(); itChar++)
+  vHash = (vHash ^ (unsigned char) *itChar) * 1099511628211ULL;
+
+ vHash ^= vHash >> 33;
+ vHash *= 0xff51afd7ed558ccdULL;
+ vHash ^= vHash >> 33;
+ vHash *= 0xc4ceb9fe1a85ec53ULL;
+ vHash ^= vHash >> 33;
+
+ unsigned vBucket = (unsigned) (vHash & ((1ULL << bits) - 1));
+
+ // the digits are written backward from the end of the buffer
+ char vDigits[16];
+ char *vStart = vDigits + sizeof(vDigits);
+ do
+ {
+  *--vStart = '0' + vBucket % 10;
+  vBucket /= 10;
+  } while (vBucket > 0);
+
+ if (signedHashing && (vHash >> 63))
+  *--vStart = '-';
+
+ return string(vStart, vDigits + sizeof(vDigits));
+}
+
+bool FeatureHasher::isNegative(const string &pFeature)
+{
+ return signedHashing && !pFeature.empty() && (pFeature[0] == '-');
+}
+
+void FeatureHasher::getValuedContext(const vector<string> &pContext,
+                                     vector<pair<string, float> > &pValuedContext)
+{
+ pValuedContext.clear();
+ pValuedContext.reserve(pContext.size());
+
+ for (vector<string>::const_iterator itFeature = pContext.begin();
+      itFeature < pContext.end();
+      itFeature++)
+  if (isNegative(*itFeature))
+   pValuedContext.push_back(make_pair(itFeature->substr(1), -1.0f));
+  else
+   pValuedContext.push_back(make_pair(*itFeature, 1.0f));
+}
@@ -0,0 +1,62 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Feature hashing (hashing trick) of the contexts of the classifier
+ *
+ *  When hashing is set, Sample::getZMEContext() gives the bucket of each
+ *  feature (its type and value) among 2^bits buckets instead of the 
+ *  feature string, for both training and classification, so that the
+ *  features of the models, and so their memory and size, are bounded
+ *  however many lexicalized features (e.g. words and paths) the data has.
+ *
+ *  With signed hashing, another bit of the hash gives each feature the
+ *  value +1 or -1, so that the features colliding in a bucket tend to 
+ *  cancel out rather than add up. The negative features are written with
+ *  a leading '-' (e.g. "-1234"), which the parallel trainer, the scorer 
+ *  and the classifier (for maxent) turn into the value -1 of the bucket.
+ *  GIS does not support negative values, so it can't be used with signed
+ *  hashing (ZMEClassifier rejects it before training by either backend).
+ *
+ *  The hashing should be set before any context is generated and not 
+ *  changed afterward, since the models are only valid for the hashing 
+ *  they are trained with.
+ *
+ */
+
+#ifndef FEATUREHASHER_HPP
+#define FEATUREHASHER_HPP
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+
+class FeatureHasher
+{
+ private:
+
+  // 0 for no hashing
+  static unsigned short bits;
+  static bool signedHashing;
+
+ public:
+
+  // sets the number of bits of the buckets (0 for no hashing, up to 
+  // MAX_FEATURE_HASHING_BITS) and whether the features are signed
+  static void setHashing(unsigned short, bool);
+  static bool isHashing();
+  static bool isSigned();
+
+  // returns the hashed feature of the given feature name and value
+  static string hash(const string &, const string &);
+  // returns true if the feature is a negative one of signed hashing
+  static bool isNegative(const string &);
+  // converts the hashed features of a context into the bucket - value
+  // pairs accepted by maxent
+  static void getValuedContext(const vector<string> &, 
+                               vector<pair<string, float> > &);
+};
+
+#endif /* FEATUREHASHER_HPP */
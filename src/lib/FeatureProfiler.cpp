@@ -0,0 +1,106 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to FeatureProfiler.hpp)
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+
+#include "FeatureProfiler.hpp"
+
+
+bool FeatureProfiler::enabled = false;
+string FeatureProfiler::names[PROFILED_FEATURE_TYPE_COUNT];
+unsigned long FeatureProfiler::callCounts[PROFILED_FEATURE_TYPE_COUNT];
+double FeatureProfiler::times[PROFILED_FEATURE_TYPE_COUNT];
+unsigned long FeatureProfiler::byteCounts[PROFILED_FEATURE_TYPE_COUNT];
+
+
+void FeatureProfiler::setEnabled(bool pEnabled)
+{
+ enabled = pEnabled;
+ reset();
+}
+
+bool FeatureProfiler::isEnabled()
+{
+ return enabled;
+}
+
+void FeatureProfiler::addCall(unsigned short pFeatureType,
+                              const string &pName,
+                              double pTime,
+                              size_t pBytes)
+{
+ if (pFeatureType >= PROFILED_FEATURE_TYPE_COUNT)
+  return;
+
+ if (callCounts[pFeatureType] == 0)
+  names[pFeatureType] = pName;
+
+ callCounts[pFeatureType]++;
+ times[pFeatureType] += pTime;
+ byteCounts[pFeatureType] += pBytes;
+}
+
+void FeatureProfiler::reset()
+{
+ for (unsigned short i = 0; i < PROFILED_FEATURE_TYPE_COUNT; i++)
+ {
+  callCounts[i] = 0;
+  times[i] = 0;
+  byteCounts[i] = 0;
+  }
+}
+
+/**
+ *  Each row contains the rank, name and id of the feature type, the number
+ *  of extractions, total time (ms), average time per extraction (ns), share
+ *  of the total time of all feature types, and total and average bytes of
+ *  the values
+ */
+void FeatureProfiler::report(ostream &pStream)
+{
+ vector<pair<double, unsigned short> > vRanking;
+ double vTotalTime = 0;
+
+ for (unsigned short i = 0; i < PROFILED_FEATURE_TYPE_COUNT; i++)
+  if (callCounts[i] != 0)
+  {
+   vRanking.push_back(pair<double, unsigned short>(times[i], i));
+   vTotalTime += times[i];
+   }
+
+ sort(vRanking.rbegin(), vRanking.rend());
+
+ pStream << "Feature extraction cost (" << vRanking.size()
+         << " feature types, " << vTotalTime * 1e3 << " ms):" << endl
+         << endl
+         << setw(5) << "rank" << setw(12) << "feature" << setw(6) << "id"
+         << setw(12) << "calls" << setw(12) << "total ms"
+         << setw(10) << "ns/call" << setw(8) << "share"
+         << setw(14) << "bytes" << setw(10) << "B/call" << endl;
+
+ for (unsigned short i = 0; i < vRanking.size(); i++)
+ {
+  unsigned short vType = vRanking[i].second;
+
+  pStream << setw(5) << i + 1 << setw(12) << names[vType] << setw(6) << vType
+          << setw(12) << callCounts[vType]
+          << setw(12) << fixed << setprecision(3) << times[vType] * 1e3
+          << setw(10) << setprecision(0) << times[vType] * 1e9 / callCounts[vType]
+          << setw(7) << setprecision(1)
+          << (vTotalTime > 0 ? times[vType] * 100 / vTotalTime : 0) << "%"
+          << setw(14) << byteCounts[vType]
+          << setw(10) << setprecision(1)
+          << (double) byteCounts[vType] / callCounts[vType] << endl;
+  pStream.unsetf(ios_base::floatfield);
+  pStream << setprecision(6);
+  }
+
+ pStream << endl;
+}
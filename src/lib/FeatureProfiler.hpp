@@ -0,0 +1,57 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Profiler of the cost of feature extraction per feature type
+ *
+ *  When enabled, Sample::extractFeatures() adds the time taken to extract
+ *  each feature and the length of its value to the totals of its feature
+ *  type, so that the cost of the features in a feature set can be compared
+ *  (e.g. cheap PT_F against PATH_F which walks the tree). The sample
+ *  generators reset the totals at the beginning of generation and report
+ *  them ranked by total time into their analysis logs.
+ *
+ *  The totals are not locked and the features must be extracted by one
+ *  thread at a time while profiling.
+ *
+ */
+
+#ifndef FEATUREPROFILER_HPP
+#define FEATUREPROFILER_HPP
+
+#include <iostream>
+#include <string>
+
+#include "Constants.hpp"
+
+using namespace std;
+
+
+// feature types are numbered up to TRIAL_F
+#define PROFILED_FEATURE_TYPE_COUNT (TRIAL_F + 1)
+
+class FeatureProfiler
+{
+ private:
+
+  static bool enabled;
+
+  static string names[PROFILED_FEATURE_TYPE_COUNT];
+  static unsigned long callCounts[PROFILED_FEATURE_TYPE_COUNT];
+  static double times[PROFILED_FEATURE_TYPE_COUNT];
+  static unsigned long byteCounts[PROFILED_FEATURE_TYPE_COUNT];
+
+ public:
+
+  static void setEnabled(bool);
+  static bool isEnabled();
+
+  // adds an extraction of the given feature type and name, taking the given
+  // time (in seconds) and producing a value of the given length
+  static void addCall(unsigned short, const string &, double, size_t);
+  static void reset();
+  // writes the feature types extracted so far ranked by total time
+  static void report(ostream &);
+};
+
+#endif /* FEATUREPROFILER_HPP */
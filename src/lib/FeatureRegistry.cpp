@@ -0,0 +1,39 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to FeatureRegistry.hpp)
+ *
+ */
+
+#include "FeatureRegistry.hpp"
+#include "FeatureHasher.hpp"
+
+
+map<string, unsigned> FeatureRegistry::ids;
+
+
+unsigned FeatureRegistry::getId(const string &pFeature)
+{
+ return ids.insert(make_pair(pFeature, (unsigned) ids.size())).first->second;
+}
+
+unsigned FeatureRegistry::getCount()
+{
+ return ids.size();
+}
+
+void FeatureRegistry::getContextIds(const vector<string> &pContext,
+                                    vector<unsigned> &pFeatureIds)
+{
+ pFeatureIds.clear();
+ pFeatureIds.reserve(pContext.size());
+
+ for (vector<string>::const_iterator itFeature = pContext.begin();
+      itFeature < pContext.end();
+      itFeature++)
+  if (FeatureHasher::isNegative(*itFeature))
+   pFeatureIds.push_back(getId(itFeature->substr(1)) | NEGATIVE_FEATURE_ID_FLAG);
+  else
+   pFeatureIds.push_back(getId(*itFeature));
+}
@@ -0,0 +1,49 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Registry of the context features of the classifier
+ *
+ *  Each feature string (e.g. "PT=NP", or the bucket of a hashed feature) is
+ *  registered once and mapped to an integer id, so that the context of a
+ *  sample is interned once (see Sample::getZMEContextIds()) and then scored
+ *  by any model loaded into ZMEScorer without looking up the strings again.
+ *
+ *  The negative features of signed hashing (see FeatureHasher.hpp) are 
+ *  given the id of their bucket flagged by NEGATIVE_FEATURE_ID_FLAG.
+ *
+ */
+
+#ifndef FEATUREREGISTRY_HPP
+#define FEATUREREGISTRY_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+
+using namespace std;
+
+
+// flag of the interned ids of the negative features of signed hashing, 
+// whose weights are subtracted
+#define NEGATIVE_FEATURE_ID_FLAG 0x80000000U
+
+
+class FeatureRegistry
+{
+ private:
+
+  static map<string, unsigned> ids;
+
+ public:
+
+  // returns the id of the feature, registering it if it is new
+  static unsigned getId(const string &);
+  static unsigned getCount();
+
+  // converts a context to the interned feature ids, flagging the negative
+  // ones
+  static void getContextIds(const vector<string> &, vector<unsigned> &);
+};
+
+#endif /* FEATUREREGISTRY_HPP */
@@ -0,0 +1,271 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to GzStream.hpp)
+ *
+ */
+
+#include <unistd.h>
+
+#include "GzStream.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+
+
+GzStreamBuf::GzStreamBuf()
+{
+ file = NULL;
+ writing = false;
+ buffer = new char[GZ_STREAM_BUFFER_SIZE];
+}
+
+GzStreamBuf::~GzStreamBuf()
+{
+ close();
+ delete [] buffer;
+}
+
+bool GzStreamBuf::open(const string &pFileName, const char *pMode)
+{
+ close();
+
+ file = gzopen(pFileName.c_str(), pMode);
+ if (file == NULL)
+  return false;
+
+ gzbuffer(file, GZ_STREAM_BUFFER_SIZE);
+
+ writing = (pMode[0] == 'w') || (pMode[0] == 'a');
+ if (writing)
+  setp(buffer, buffer + GZ_STREAM_BUFFER_SIZE);
+ else
+  setg(buffer, buffer, buffer);
+
+ return true;
+}
+
+bool GzStreamBuf::close()
+{
+ if (file == NULL)
+  return true;
+
+ bool vSucceeded = true;
+ if (writing && (flushBuffer() < 0))
+  vSucceeded = false;
+
+ if (gzclose(file) != Z_OK)
+  vSucceeded = false;
+
+ file = NULL;
+ setp(NULL, NULL);
+ setg(NULL, NULL, NULL);
+
+ return vSucceeded;
+}
+
+bool GzStreamBuf::isOpen()
+{
+ return file != NULL;
+}
+
+/**
+ *  compresses the buffered characters, returning their count or -1 on
+ *  failure
+ */
+int GzStreamBuf::flushBuffer()
+{
+ int vCount = pptr() - pbase();
+ if (vCount == 0)
+  return 0;
+
+ if (gzwrite(file, pbase(), vCount) != vCount)
+  return -1;
+
+ pbump(-vCount);
+ return vCount;
+}
+
+GzStreamBuf::int_type GzStreamBuf::overflow(int_type pChar)
+{
+ if ((file == NULL) || !writing)
+  return traits_type::eof();
+
+ if (flushBuffer() < 0)
+  return traits_type::eof();
+
+ if (!traits_type::eq_int_type(pChar, traits_type::eof()))
+ {
+  *pptr() = traits_type::to_char_type(pChar);
+  pbump(1);
+  }
+
+ return traits_type::not_eof(pChar);
+}
+
+GzStreamBuf::int_type GzStreamBuf::underflow()
+{
+ if (gptr() < egptr())
+  return traits_type::to_int_type(*gptr());
+
+ if ((file == NULL) || writing)
+  return traits_type::eof();
+
+ int vCount = gzread(file, buffer, GZ_STREAM_BUFFER_SIZE);
+ if (vCount <= 0)
+  return traits_type::eof();
+
+ setg(buffer, buffer, buffer + vCount);
+ return traits_type::to_int_type(*gptr());
+}
+
+/**
+ *  large blocks (e.g. the buffer of CoNLLSaver) are compressed directly
+ *  instead of being copied into the buffer
+ */
+streamsize GzStreamBuf::xsputn(const char *pChars, streamsize pCount)
+{
+ if (pCount < epptr() - pptr())
+  return streambuf::xsputn(pChars, pCount);
+
+ if ((file == NULL) || !writing || (flushBuffer() < 0))
+  return 0;
+
+ int vCount = gzwrite(file, pChars, pCount);
+ return vCount > 0 ? vCount : 0;
+}
+
+int GzStreamBuf::sync()
+{
+ if (writing && (file != NULL) && (flushBuffer() < 0))
+  return -1;
+
+ return 0;
+}
+
+
+IGzStream::IGzStream() : istream(NULL)
+{
+ init(&gzBuf);
+}
+
+IGzStream::IGzStream(const string &pFileName) : istream(NULL)
+{
+ init(&gzBuf);
+ open(pFileName);
+}
+
+/**
+ *  zlib reads an uncompressed file as it is, so only the name of the file
+ *  has to be figured out
+ */
+bool IGzStream::open(const string &pFileName)
+{
+ string vFileName = pFileName;
+ if ((access(vFileName.c_str(), F_OK) != 0) &&
+     (access((vFileName + COMPRESSED_FILE_SUFFIX).c_str(), F_OK) == 0))
+  vFileName += COMPRESSED_FILE_SUFFIX;
+
+ clear();
+ if (!gzBuf.open(vFileName, "rb"))
+ {
+  setstate(ios::failbit);
+  return false;
+  }
+
+ return true;
+}
+
+void IGzStream::close()
+{
+ if (!gzBuf.close())
+  setstate(ios::failbit);
+}
+
+
+bool OGzStream::compression = false;
+
+OGzStream::OGzStream() : ostream(NULL)
+{
+ compressed = false;
+ init(&plainBuf);
+}
+
+OGzStream::~OGzStream()
+{
+ close();
+}
+
+/**
+ *  opens the file, or its compressed counterpart (with the suffix) when
+ *  compression is set
+ */
+bool OGzStream::open(const string &pFileName)
+{
+ close();
+ clear();
+
+ compressed = compression;
+ if (compressed)
+ {
+  rdbuf(&gzBuf);
+  if (!gzBuf.open(pFileName + COMPRESSED_FILE_SUFFIX,
+                  ("wb" + intToStr(GZ_COMPRESSION_LEVEL)).c_str()))
+  {
+   setstate(ios::failbit);
+   return false;
+   }
+  }
+ else
+ {
+  rdbuf(&plainBuf);
+  if (plainBuf.open(pFileName.c_str(), ios::out | ios::trunc) == NULL)
+  {
+   setstate(ios::failbit);
+   return false;
+   }
+  }
+
+ return true;
+}
+
+void OGzStream::close()
+{
+ bool vSucceeded = compressed ? gzBuf.close() :
+                                (!plainBuf.is_open() || (plainBuf.close() != NULL));
+ if (!vSucceeded)
+  setstate(ios::failbit);
+}
+
+bool OGzStream::isOpen()
+{
+ return compressed ? gzBuf.isOpen() : plainBuf.is_open();
+}
+
+bool OGzStream::isCompressed()
+{
+ return compressed;
+}
+
+void OGzStream::setCompression(bool pCompression)
+{
+ compression = pCompression;
+}
+
+bool OGzStream::isCompressing()
+{
+ return compression;
+}
+
+
+string stripCompressedSuffix(const string &pFileName)
+{
+ string vSuffix = COMPRESSED_FILE_SUFFIX;
+
+ if ((pFileName.size() > vSuffix.size()) &&
+     (pFileName.compare(pFileName.size() - vSuffix.size(), vSuffix.size(),
+                        vSuffix) == 0))
+  return pFileName.substr(0, pFileName.size() - vSuffix.size());
+
+ return pFileName;
+}
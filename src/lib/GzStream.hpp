@@ -0,0 +1,103 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Streams of gzip-compressed files
+ *
+ *  OGzStream writes the output files of the executables (props files and
+ *  selection logs). When compression is set (by setCompression(), for all
+ *  the streams opened afterward), the file is written through zlib with
+ *  COMPRESSED_FILE_SUFFIX appended to its name; otherwise it is a plain
+ *  file stream.
+ *
+ *  IGzStream reads a file whether it is compressed or not, and when the
+ *  file does not exist, tries the compressed one (with the suffix), so
+ *  the readers can be given the names of the uncompressed files.
+ *
+ */
+
+#ifndef GZSTREAM_HPP
+#define GZSTREAM_HPP
+
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <zlib.h>
+
+using namespace std;
+
+
+// streambuf reading or writing a gzip file through a buffer
+class GzStreamBuf : public streambuf
+{
+ private:
+
+  gzFile file;
+  bool writing;
+  char *buffer;
+
+  int flushBuffer();
+
+ protected:
+
+  virtual int_type overflow(int_type);
+  virtual int_type underflow();
+  virtual streamsize xsputn(const char *, streamsize);
+  virtual int sync();
+
+ public:
+
+  GzStreamBuf();
+  ~GzStreamBuf();
+
+  // opens the file by the mode of gzopen() (e.g. "rb" or "wb6")
+  bool open(const string &, const char *);
+  bool close();
+  bool isOpen();
+};
+
+
+class IGzStream : public istream
+{
+ private:
+
+  GzStreamBuf gzBuf;
+
+ public:
+
+  IGzStream();
+  IGzStream(const string &);
+
+  bool open(const string &);
+  void close();
+};
+
+
+class OGzStream : public ostream
+{
+ private:
+
+  filebuf plainBuf;
+  GzStreamBuf gzBuf;
+  bool compressed;
+
+  static bool compression;
+
+ public:
+
+  OGzStream();
+  ~OGzStream();
+
+  bool open(const string &);
+  void close();
+  bool isOpen();
+  bool isCompressed();
+
+  static void setCompression(bool);
+  static bool isCompressing();
+};
+
+// returns the file name without COMPRESSED_FILE_SUFFIX if it has it
+string stripCompressedSuffix(const string &);
+
+#endif /* GZSTREAM_HPP */
@@ -0,0 +1,278 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to HeadRules.hpp)
+ *
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <pthread.h>
+
+#include "HeadRules.hpp"
+#include "TBTree.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+
+
+map<string, SyntTagId> * volatile HeadRules::tagIds = new map<string, SyntTagId>;
+vector<map<string, SyntTagId> *> HeadRules::replacedTagIds;
+vector<string> HeadRules::tags;
+unsigned HeadRules::tagPatternMasks[MAX_SYNT_TAG_COUNT];
+vector<string> HeadRules::patterns;
+vector<HeadRule> HeadRules::headRules;
+vector<HeadRule> HeadRules::contentRules;
+unsigned short HeadRules::variant = CONLL_HEAD_VARIANT;
+
+static pthread_once_t compileOnce = PTHREAD_ONCE_INIT;
+// serializes registering the tags
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+SyntTagId HeadRules::getTagId(const string &pTag)
+{
+ pthread_once(&compileOnce, initialize);
+
+ const map<string, SyntTagId> *vIds = tagIds;
+ map<string, SyntTagId>::const_iterator itId = vIds->find(pTag);
+ if (itId != vIds->end())
+  return itId->second;
+
+ pthread_mutex_lock(&registryLock);
+ SyntTagId vId = registerTag(pTag);
+ pthread_mutex_unlock(&registryLock);
+
+ return vId;
+}
+
+/**
+ *  registers the tag unless another thread has done it meanwhile (the
+ *  caller holds the registry lock)
+ * 
+ *  The mask of the tag is set and the map with the tag is filled before 
+ *  it replaces the current map, so a thread finding the tag in the map
+ *  sees its mask as well.
+ */
+SyntTagId HeadRules::registerTag(const string &pTag)
+{
+ map<string, SyntTagId>::iterator itId = tagIds->find(pTag);
+ if (itId != tagIds->end())
+  return itId->second;
+
+ if (tags.size() == MAX_SYNT_TAG_COUNT)
+ {
+  cerr << "Too many syntactic tags (more than " << MAX_SYNT_TAG_COUNT 
+       << ")!" << endl;
+  exit(EXIT_FAILURE);
+  }
+
+ unsigned vMask = 0;
+ for (unsigned short cntPattern = 0; cntPattern < patterns.size(); cntPattern++)
+  if (isPatternMatched(patterns[cntPattern], pTag))
+   vMask |= (1 << cntPattern);
+
+ SyntTagId vId = tags.size();
+ tags.push_back(pTag);
+ tagPatternMasks[vId] = vMask;
+
+ map<string, SyntTagId> *vOldIds = tagIds;
+ map<string, SyntTagId> *vIds = new map<string, SyntTagId> (*vOldIds);
+ (*vIds)[pTag] = vId;
+ __sync_synchronize();
+ tagIds = vIds;
+ replacedTagIds.push_back(vOldIds);
+
+ return vId;
+}
+
+void HeadRules::setVariant(unsigned short pVariant)
+{
+ pthread_once(&compileOnce, initialize);
+
+ pthread_mutex_lock(&registryLock);
+ variant = pVariant;
+ compile();
+ pthread_mutex_unlock(&registryLock);
+}
+
+void HeadRules::initialize()
+{
+ pthread_mutex_lock(&registryLock);
+ compile();
+ pthread_mutex_unlock(&registryLock);
+}
+
+/**
+ *  compiles the rule tables; the rules of the J&N variant replace the 
+ *  ones of the same parent tags
+ */
+void HeadRules::compile()
+{
+ headRules.clear();
+ contentRules.clear();
+
+ compileRules(HEAD_RULES, headRules);
+ if (variant == JN_HEAD_VARIANT)
+  compileRules(JN_HEAD_RULES, headRules);
+ compileRules(CONTENT_RULES, contentRules);
+}
+
+void HeadRules::compileRules(const string pTable[][2], vector<HeadRule> &pRules)
+{
+ for (unsigned short cntRule = 0; !pTable[cntRule][0].empty(); cntRule++)
+ {
+  HeadRule vRule;
+  compileRule(pTable[cntRule][1], vRule);
+
+  vector<string> vParentTags;
+  tokenize(pTable[cntRule][0], vParentTags, " ");
+  for (unsigned short cntTag = 0; cntTag < vParentTags.size(); cntTag++)
+  {
+   SyntTagId vParentId = registerTag(vParentTags[cntTag]);
+   if (vParentId >= pRules.size())
+    pRules.resize(vParentId + 1);
+   pRules[vParentId] = vRule;
+   }
+  }
+}
+
+void HeadRules::compileRule(const string &pSteps, HeadRule &pRule)
+{
+ vector<string> vSteps;
+ tokenize(pSteps, vSteps, ";");
+
+ for (unsigned short cntStep = 0; cntStep < vSteps.size(); cntStep++)
+ {
+  string vStep = trim(vSteps[cntStep]);
+  if (vStep.empty())
+   continue;
+
+  HeadRuleStep vRuleStep;
+  vRuleStep.rightToLeft = (vStep[0] == '<');
+  vStep.erase(0, 1);
+
+  vRuleStep.negated = (!vStep.empty() && (vStep[0] == '!'));
+  if (vRuleStep.negated)
+   vStep.erase(0, 1);
+
+  vRuleStep.anyOf = (!vStep.empty() && (vStep[0] == '['));
+  if (vRuleStep.anyOf)
+   vStep = vStep.substr(1, vStep.find(']') - 1);
+
+  vector<string> vTags;
+  tokenize(vStep, vTags, " ");
+  for (unsigned short cntTag = 0; cntTag < vTags.size(); cntTag++)
+   vRuleStep.tags.push_back(compileTag(vTags[cntTag]));
+
+  pRule.push_back(vRuleStep);
+  }
+}
+
+/**
+ *  returns the tag id, or for a pattern, its index as a negative number;
+ *  the masks of the tags registered so far are updated for a new pattern
+ */
+int HeadRules::compileTag(const string &pTag)
+{
+ if (pTag.find('*') == string::npos)
+  return registerTag(pTag);
+
+ unsigned short cntPattern = 0;
+ while ((cntPattern < patterns.size()) && (patterns[cntPattern] != pTag))
+  cntPattern++;
+
+ if (cntPattern == patterns.size())
+ {
+  patterns.push_back(pTag);
+  for (SyntTagId cntTag = 0; cntTag < tags.size(); cntTag++)
+   if (isPatternMatched(pTag, tags[cntTag]))
+    tagPatternMasks[cntTag] |= (1 << cntPattern);
+  }
+
+ return -cntPattern - 1;
+}
+
+bool HeadRules::isPatternMatched(const string &pPattern, const string &pTag)
+{
+ if (pPattern == "*")
+  return true;
+
+ bool vAnyPrefix = (pPattern[0] == '*');
+ bool vAnySuffix = (pPattern[pPattern.size() - 1] == '*');
+ string vFixed = pPattern.substr(vAnyPrefix ? 1 : 0,
+                                 pPattern.size() - vAnyPrefix - vAnySuffix);
+
+ if (vAnyPrefix && vAnySuffix)
+  return pTag.find(vFixed) != string::npos;
+ else if (vAnySuffix)
+  return pTag.compare(0, vFixed.size(), vFixed) == 0;
+ else if (vAnyPrefix)
+  return (pTag.size() >= vFixed.size()) &&
+         (pTag.compare(pTag.size() - vFixed.size(), vFixed.size(), vFixed) == 0);
+ else
+  return pTag == vFixed;
+}
+
+bool HeadRules::isTagMatched(SyntTagId pTagId, int pRuleTag)
+{
+ if (pRuleTag >= 0)
+  return pTagId == pRuleTag;
+ else
+  return (tagPatternMasks[pTagId] & (1 << (-pRuleTag - 1))) != 0;
+}
+
+/**
+ *  the rules are compiled before any tag id is returned (see getTagId()),
+ *  and only read afterwards, so they are applied without any lock
+ */
+short HeadRules::applyRule(vector<HeadRule> &pRules, SyntTagId pParentTag,
+                           const vector<TBTree *> &pChildren)
+{
+ if (pParentTag >= pRules.size())
+  return -1;
+
+ short vLastChild = pChildren.size() - 1;
+ HeadRule &vRule = pRules[pParentTag];
+
+ for (HeadRule::iterator itStep = vRule.begin(); itStep < vRule.end(); itStep++)
+ {
+  // a priority list is scanned once for each tag, and an any-of list once
+  // for all tags
+  unsigned short vScans = itStep->anyOf ? 1 : itStep->tags.size();
+  for (unsigned short cntScan = 0; cntScan < vScans; cntScan++)
+   for (short cntChild = 0; cntChild <= vLastChild; cntChild++)
+   {
+    short vChild = itStep->rightToLeft ? (vLastChild - cntChild) : cntChild;
+    SyntTagId vChildTag = pChildren[vChild]->getSyntTagId();
+
+    bool vMatched = false;
+    if (itStep->anyOf)
+    {
+     for (vector<int>::iterator itTag = itStep->tags.begin();
+          !vMatched && (itTag < itStep->tags.end());
+          itTag++)
+      vMatched = isTagMatched(vChildTag, *itTag);
+     }
+    else
+     vMatched = isTagMatched(vChildTag, itStep->tags[cntScan]);
+
+    if (vMatched != itStep->negated)
+     return vChild;
+    }
+  }
+
+ return -1;
+}
+
+short HeadRules::findHeadChild(SyntTagId pParentTag,
+                               const vector<TBTree *> &pChildren)
+{
+ return applyRule(headRules, pParentTag, pChildren);
+}
+
+short HeadRules::findContentChild(SyntTagId pParentTag,
+                                  const vector<TBTree *> &pChildren)
+{
+ return applyRule(contentRules, pParentTag, pChildren);
+}
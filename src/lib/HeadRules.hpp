@@ -0,0 +1,95 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Table-driven head and content rules
+ *
+ *  The rules in HEAD_RULES, JN_HEAD_RULES, and CONTENT_RULES (see 
+ *  Constants.hpp) are compiled once into per-tag lists of steps over 
+ *  integer tag ids, so that finding the head or content child of a 
+ *  constituent is a linear scan of its children with integer compares.
+ *
+ *  Syntactic tags are registered here as they are loaded (see TBTree), and
+ *  for each tag it is computed once which of the tag patterns used in the
+ *  rules (e.g. "NN*") it matches.
+ *
+ *  Trees are built and precomputed by several loading threads, so the
+ *  rules are compiled once (by the first thread getting a tag id) and then
+ *  only read, and a tag is looked up without any lock: the tag map is 
+ *  copied when a tag is registered (under a mutex, which is rare after the
+ *  first sentences) and the copy replaces it, while the readers keep using
+ *  the map they have got.
+ *
+ */
+
+#ifndef HEADRULES_HPP
+#define HEADRULES_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+
+#include "Types.hpp"
+#include "Constants.hpp"
+
+using namespace std;
+
+
+// a step of a rule: an item of tags is a tag id if not negative, and the 
+// index of a tag pattern (-index - 1) otherwise
+struct HeadRuleStep
+{
+ bool rightToLeft;
+ // whether children are scanned once for any of the tags (or none of them
+ // if negated) instead of once for each tag in order of priority
+ bool anyOf;
+ bool negated;
+ vector<int> tags;
+};
+
+typedef vector<HeadRuleStep> HeadRule;
+
+class HeadRules
+{
+ private:
+
+  // the current tag map, and the replaced ones which may still be read
+  static map<string, SyntTagId> * volatile tagIds;
+  static vector<map<string, SyntTagId> *> replacedTagIds;
+  static vector<string> tags;
+  // bit i is set if the tag matches patterns[i]; an array, since it is
+  // read by other threads while a tag is appended
+  static unsigned tagPatternMasks[MAX_SYNT_TAG_COUNT];
+  static vector<string> patterns;
+
+  // rules indexed by parent tag id
+  static vector<HeadRule> headRules;
+  static vector<HeadRule> contentRules;
+  static unsigned short variant;
+
+  static SyntTagId registerTag(const string &);
+  static void initialize();
+  static void compile();
+  static void compileRules(const string [][2], vector<HeadRule> &);
+  static void compileRule(const string &, HeadRule &);
+  static int compileTag(const string &);
+  static bool isPatternMatched(const string &, const string &);
+  static bool isTagMatched(SyntTagId, int);
+  static short applyRule(vector<HeadRule> &, SyntTagId, 
+                         const vector<TBTree *> &);
+
+ public:
+
+  // returns the id of the tag, registering it if it is new
+  static SyntTagId getTagId(const string &);
+  // selects CONLL_HEAD_VARIANT (default) or JN_HEAD_VARIANT for NAC and 
+  // WHNP head rules; must be called before any tree is built
+  static void setVariant(unsigned short);
+
+  // return the index of the head/content child among the given children 
+  // of a constituent with the given tag, or -1 if no rule fires
+  static short findHeadChild(SyntTagId, const vector<TBTree *> &);
+  static short findContentChild(SyntTagId, const vector<TBTree *> &);
+};
+
+#endif /* HEADRULES_HPP */
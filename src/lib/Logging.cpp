@@ -0,0 +1,256 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to Logging.hpp)
+ *
+ */
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "Logging.hpp"
+#include "Constants.hpp"
+#include "Metrics.hpp"
+
+
+short Progress::tty = -1;
+double Progress::lastReportTime = 0;
+
+bool Progress::isTTY()
+{
+ if (tty == -1)
+  tty = isatty(fileno(stdout)) ? 1 : 0;
+
+ return tty == 1;
+}
+
+bool Progress::isDue(bool pLast)
+{
+ if (pLast)
+  return true;
+
+ double vNow = getMonotonicTime();
+ if (vNow - lastReportTime < (isTTY() ? PROGRESS_TTY_INTERVAL : PROGRESS_NON_TTY_INTERVAL))
+  return false;
+
+ lastReportTime = vNow;
+ return true;
+}
+
+
+AsyncLogBuf::AsyncLogBuf()
+{
+ target = NULL;
+ buffer = new char[ASYNC_LOG_BUFFER_SIZE];
+ setp(buffer, buffer + ASYNC_LOG_BUFFER_SIZE);
+
+ stopping = false;
+ running = false;
+ pthread_mutex_init(&mutex, NULL);
+ pthread_cond_init(&condition, NULL);
+}
+
+AsyncLogBuf::~AsyncLogBuf()
+{
+ stop();
+
+ delete [] buffer;
+ pthread_mutex_destroy(&mutex);
+ pthread_cond_destroy(&condition);
+}
+
+void AsyncLogBuf::start(streambuf *pTarget)
+{
+ if (running)
+  return;
+
+ target = pTarget;
+ stopping = false;
+
+ if (pthread_create(&writer, NULL, runWriter, this) != 0)
+ {
+  cerr << "Creating log writing thread failed!" << endl;
+  return;
+  }
+
+ running = true;
+}
+
+void AsyncLogBuf::stop()
+{
+ if (!running)
+  return;
+
+ handOver();
+
+ pthread_mutex_lock(&mutex);
+ stopping = true;
+ pthread_cond_signal(&condition);
+ pthread_mutex_unlock(&mutex);
+
+ pthread_join(writer, NULL);
+ running = false;
+}
+
+bool AsyncLogBuf::isRunning()
+{
+ return running;
+}
+
+/**
+ *  moves the buffered characters to the pending ones of the writer
+ */
+void AsyncLogBuf::handOver()
+{
+ if (pptr() == pbase())
+  return;
+
+ pthread_mutex_lock(&mutex);
+ pending.append(pbase(), pptr() - pbase());
+ pthread_cond_signal(&condition);
+ pthread_mutex_unlock(&mutex);
+
+ setp(buffer, buffer + ASYNC_LOG_BUFFER_SIZE);
+}
+
+AsyncLogBuf::int_type AsyncLogBuf::overflow(int_type pChar)
+{
+ handOver();
+
+ if (!traits_type::eq_int_type(pChar, traits_type::eof()))
+ {
+  *pptr() = traits_type::to_char_type(pChar);
+  pbump(1);
+  }
+
+ return traits_type::not_eof(pChar);
+}
+
+int AsyncLogBuf::sync()
+{
+ handOver();
+ return 0;
+}
+
+/**
+ *  takes all the pending characters at once and writes them, until it is
+ *  stopped and nothing is pending
+ */
+void *AsyncLogBuf::runWriter(void *pBuf)
+{
+ AsyncLogBuf *vBuf = (AsyncLogBuf *) pBuf;
+ string vWriting;
+
+ pthread_mutex_lock(&vBuf->mutex);
+ while (true)
+ {
+  while (vBuf->pending.empty() && !vBuf->stopping)
+   pthread_cond_wait(&vBuf->condition, &vBuf->mutex);
+
+  if (vBuf->pending.empty())
+   break;
+
+  vWriting.swap(vBuf->pending);
+  pthread_mutex_unlock(&vBuf->mutex);
+
+  vBuf->target->sputn(vWriting.data(), vWriting.size());
+  vBuf->target->pubsync();
+  vWriting.clear();
+
+  pthread_mutex_lock(&vBuf->mutex);
+  }
+ pthread_mutex_unlock(&vBuf->mutex);
+
+ return NULL;
+}
+
+
+// the files are kept to write their pending lines at exit, since exit()
+// does not destroy them
+static vector<AsyncLogFile *> gvAsyncLogFiles;
+
+AsyncLogFile::AsyncLogFile()
+{
+ async = true;
+ gvAsyncLogFiles.push_back(this);
+}
+
+AsyncLogFile::AsyncLogFile(const char *pFileName)
+{
+ async = true;
+ gvAsyncLogFiles.push_back(this);
+
+ open(pFileName);
+}
+
+AsyncLogFile::~AsyncLogFile()
+{
+ detach();
+
+ for (unsigned short i = 0; i < gvAsyncLogFiles.size(); i++)
+  if (gvAsyncLogFiles[i] == this)
+  {
+   gvAsyncLogFiles.erase(gvAsyncLogFiles.begin() + i);
+   break;
+   }
+}
+
+void AsyncLogFile::attach()
+{
+ static bool vRegistered = false;
+
+ if (!async || !is_open() || asyncBuf.isRunning())
+  return;
+
+ if (!vRegistered)
+ {
+  atexit(stopAll);
+  vRegistered = true;
+  }
+
+ asyncBuf.start(ofstream::rdbuf());
+ if (asyncBuf.isRunning())
+  ios::rdbuf(&asyncBuf);
+}
+
+void AsyncLogFile::detach()
+{
+ if (!asyncBuf.isRunning())
+  return;
+
+ asyncBuf.stop();
+ ios::rdbuf(ofstream::rdbuf());
+}
+
+void AsyncLogFile::open(const char *pFileName)
+{
+ detach();
+ ofstream::open(pFileName);
+ attach();
+}
+
+void AsyncLogFile::close()
+{
+ detach();
+ ofstream::close();
+}
+
+void AsyncLogFile::setAsync(bool pAsync)
+{
+ async = pAsync;
+
+ if (async)
+  attach();
+ else
+  detach();
+}
+
+void AsyncLogFile::stopAll()
+{
+ for (unsigned short i = 0; i < gvAsyncLogFiles.size(); i++)
+  gvAsyncLogFiles[i]->detach();
+}
@@ -0,0 +1,112 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Progress reporting and asynchronous log files
+ *
+ *  Progress throttles the progress lines (e.g. "\r1000 samples processed")
+ *  printed in the loops by time: a line is due every PROGRESS_TTY_INTERVAL
+ *  seconds when the standard output is a terminal, and every
+ *  PROGRESS_NON_TTY_INTERVAL seconds when it is redirected (e.g. in batch
+ *  jobs), plus the last one of each loop, so the loops do not flush the
+ *  output per item.
+ *
+ *  AsyncLogFile is an ofstream whose writes are buffered and handed to a
+ *  writer thread at each flush (e.g. by mout()), so the computation never
+ *  waits for the log file. The pending lines are written before the file
+ *  is closed or the program exits. The thread is not inherited by forked
+ *  processes, so the file should be made synchronous by setAsync(false)
+ *  before forking.
+ *
+ */
+
+#ifndef LOGGING_HPP
+#define LOGGING_HPP
+
+#include <string>
+#include <fstream>
+#include <pthread.h>
+
+using namespace std;
+
+
+class Progress
+{
+ private:
+
+  // -1 until the output is checked
+  static short tty;
+  static double lastReportTime;
+
+ public:
+
+  static bool isTTY();
+  // returns true if a progress line is due now, or the given item is the
+  // last one
+  static bool isDue(bool pLast = false);
+};
+
+
+// streambuf handing the written characters to a writer thread which writes
+// them into the target streambuf
+class AsyncLogBuf : public streambuf
+{
+ private:
+
+  streambuf *target;
+  char *buffer;
+
+  // characters handed to the writer and not written yet
+  string pending;
+  bool stopping;
+  bool running;
+  pthread_t writer;
+  pthread_mutex_t mutex;
+  pthread_cond_t condition;
+
+  void handOver();
+  static void *runWriter(void *);
+
+ protected:
+
+  virtual int_type overflow(int_type);
+  virtual int sync();
+
+ public:
+
+  AsyncLogBuf();
+  ~AsyncLogBuf();
+
+  void start(streambuf *);
+  // writes the pending characters and stops the writer
+  void stop();
+  bool isRunning();
+};
+
+
+class AsyncLogFile : public ofstream
+{
+ private:
+
+  AsyncLogBuf asyncBuf;
+  bool async;
+
+  void attach();
+  void detach();
+
+ public:
+
+  AsyncLogFile();
+  AsyncLogFile(const char *);
+  ~AsyncLogFile();
+
+  void open(const char *);
+  void close();
+
+  void setAsync(bool);
+
+  // writes the pending lines of all the open files (called at exit)
+  static void stopAll();
+};
+
+#endif /* LOGGING_HPP */
@@ -0,0 +1,77 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to MemoryAccount.hpp)
+ *
+ */
+
+#include <iomanip>
+
+#include "MemoryAccount.hpp"
+#include "Utils.hpp"
+
+
+const char *MemoryAccount::names[MEM_CATEGORY_COUNT] =
+ {"sentences", "words", "tree nodes", "dep. nodes", "propositions",
+  "arguments", "samples", "features", "prd. labels", "events"};
+long MemoryAccount::objectCounts[MEM_CATEGORY_COUNT];
+long MemoryAccount::byteCounts[MEM_CATEGORY_COUNT];
+
+
+void MemoryAccount::add(unsigned short pCategory, long pCount, long pBytes)
+{
+ if (pCategory >= MEM_CATEGORY_COUNT)
+  return;
+
+ __sync_fetch_and_add(&objectCounts[pCategory], pCount);
+ __sync_fetch_and_add(&byteCounts[pCategory], pBytes);
+}
+
+long MemoryAccount::getObjectCount(unsigned short pCategory)
+{
+ return __sync_fetch_and_add(&objectCounts[pCategory], 0);
+}
+
+long MemoryAccount::getByteCount(unsigned short pCategory)
+{
+ return __sync_fetch_and_add(&byteCounts[pCategory], 0);
+}
+
+long MemoryAccount::getTotalBytes()
+{
+ long vTotal = 0;
+
+ for (unsigned short i = 0; i < MEM_CATEGORY_COUNT; i++)
+  vTotal += getByteCount(i);
+
+ return vTotal;
+}
+
+/**
+ *  Each row contains the category, the number of its objects, their bytes
+ *  and their share of the total bytes
+ */
+void MemoryAccount::report(ostream &pStream)
+{
+ long vTotal = getTotalBytes();
+
+ pStream << setw(14) << "category" << setw(14) << "objects"
+         << setw(18) << "bytes" << setw(8) << "share" << endl;
+
+ for (unsigned short i = 0; i < MEM_CATEGORY_COUNT; i++)
+ {
+  long vBytes = getByteCount(i);
+
+  pStream << setw(14) << names[i]
+          << setw(14) << setThousandSeparator(ulongToStr(getObjectCount(i)))
+          << setw(18) << setThousandSeparator(ulongToStr(vBytes))
+          << setw(7) << fixed << setprecision(1)
+          << (vTotal > 0 ? vBytes * 100.0 / vTotal : 0) << "%" << endl;
+  pStream.unsetf(ios_base::floatfield);
+  pStream << setprecision(6);
+  }
+
+ pStream << setw(14) << "total" << setw(14) << ""
+         << setw(18) << setThousandSeparator(ulongToStr(vTotal)) << endl;
+}
@@ -0,0 +1,65 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Accounting of the memory held by the data structures
+ *
+ *  The objects add themselves (count and approximate bytes) to their
+ *  category where they are allocated (e.g. the Word constructor adds a
+ *  word, and setWordForm() adds the length of the form), and the ones that
+ *  release memory subtract it (e.g. an event space when it is cleared).
+ *  The bytes are the size of the objects plus the characters of their
+ *  strings and the elements of their vectors; the overhead of the heap is
+ *  not included, so the total is a lower bound of what getMemUsage()
+ *  reports.
+ *
+ *  The totals are updated atomically, since the loaders create sentences
+ *  in several threads.
+ *
+ */
+
+#ifndef MEMORYACCOUNT_HPP
+#define MEMORYACCOUNT_HPP
+
+#include <iostream>
+
+using namespace std;
+
+
+// memory categories
+#define MEM_SENTENCES 0
+#define MEM_WORDS 1
+#define MEM_TREE_NODES 2
+#define MEM_DEP_NODES 3
+#define MEM_PROPOSITIONS 4
+#define MEM_ARGUMENTS 5
+#define MEM_SAMPLES 6
+#define MEM_FEATURES 7
+#define MEM_PRD_LABELS 8
+#define MEM_EVENTS 9
+
+#define MEM_CATEGORY_COUNT 10
+
+class MemoryAccount
+{
+ private:
+
+  static const char *names[MEM_CATEGORY_COUNT];
+  static long objectCounts[MEM_CATEGORY_COUNT];
+  static long byteCounts[MEM_CATEGORY_COUNT];
+
+ public:
+
+  // adds the given number of objects and bytes to the category (negative
+  // values to release them)
+  static void add(unsigned short, long, long);
+
+  static long getObjectCount(unsigned short);
+  static long getByteCount(unsigned short);
+  static long getTotalBytes();
+
+  // writes the objects and bytes of each category and the total
+  static void report(ostream &);
+};
+
+#endif /* MEMORYACCOUNT_HPP */
@@ -0,0 +1,230 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to Metrics.hpp)
+ *
+ */
+
+#include <iostream>
+#include <iomanip>
+
+#include "Metrics.hpp"
+#include "Utils.hpp"
+
+
+static double getSeconds(const timespec &pStart, const timespec &pEnd)
+{
+ return (pEnd.tv_sec - pStart.tv_sec) + (pEnd.tv_nsec - pStart.tv_nsec) / 1e9;
+}
+
+double getMonotonicTime()
+{
+ timespec vTime;
+
+ clock_gettime(CLOCK_MONOTONIC, &vTime);
+
+ return vTime.tv_sec + vTime.tv_nsec / 1e9;
+}
+
+
+Timer::Timer()
+{
+ elapsedTime = 0;
+ cpuTime = 0;
+ start();
+}
+
+void Timer::start()
+{
+ clock_gettime(CLOCK_MONOTONIC, &startWallTime);
+ clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &startCPUTime);
+}
+
+void Timer::stop()
+{
+ timespec vEndWallTime, vEndCPUTime;
+
+ clock_gettime(CLOCK_MONOTONIC, &vEndWallTime);
+ clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &vEndCPUTime);
+
+ elapsedTime = getSeconds(startWallTime, vEndWallTime);
+ cpuTime = getSeconds(startCPUTime, vEndCPUTime);
+}
+
+double Timer::getElapsedTime()
+{
+ return elapsedTime;
+}
+
+double Timer::getCPUTime()
+{
+ return cpuTime;
+}
+
+
+ofstream MetricsRecorder::strmMetrics;
+bool MetricsRecorder::recording = false;
+unsigned MetricsRecorder::iteration = 0;
+Timer MetricsRecorder::recordTimer;
+vector<string> MetricsRecorder::phasePaths;
+vector<Timer> MetricsRecorder::phaseTimers;
+vector<string> MetricsRecorder::timedPhases;
+vector<pair<double, double> > MetricsRecorder::phaseTimes;
+vector<string> MetricsRecorder::countNames;
+vector<unsigned long> MetricsRecorder::counts;
+
+
+short MetricsRecorder::open(const string &pMetricsFile)
+{
+ close();
+
+ strmMetrics.open(pMetricsFile.c_str());
+ if (!strmMetrics)
+ {
+  cerr << "Can't create metrics file: " << pMetricsFile << endl;
+  return -1;
+  }
+
+ strmMetrics << setprecision(9);
+
+ return 0;
+}
+
+void MetricsRecorder::close()
+{
+ if (strmMetrics.is_open())
+  strmMetrics.close();
+ strmMetrics.clear();
+
+ recording = false;
+}
+
+bool MetricsRecorder::isOpen()
+{
+ return strmMetrics.is_open();
+}
+
+void MetricsRecorder::beginRecord(unsigned pIteration)
+{
+ if (!strmMetrics.is_open())
+  return;
+
+ iteration = pIteration;
+ timedPhases.clear();
+ phaseTimes.clear();
+ countNames.clear();
+ counts.clear();
+
+ recording = true;
+ recordTimer.start();
+}
+
+/**
+ *  The record is flushed as soon as it is written, so that it can be read
+ *  while the run continues and it is not written again by forked processes
+ */
+void MetricsRecorder::endRecord()
+{
+ if (!recording)
+  return;
+
+ recordTimer.stop();
+ recording = false;
+
+ strmMetrics << "{\"iteration\":" << iteration
+             << ",\"elapsed\":" << recordTimer.getElapsedTime()
+             << ",\"process_cpu\":" << recordTimer.getCPUTime()
+             << ",\"rss\":" << getRSS();
+
+ strmMetrics << ",\"phases\":{";
+ for (unsigned i = 0; i < timedPhases.size(); i++)
+  strmMetrics << (i == 0 ? "" : ",")
+              << "\"" << timedPhases[i] << "\":{\"elapsed\":"
+              << phaseTimes[i].first << ",\"process_cpu\":"
+              << phaseTimes[i].second << "}";
+
+ strmMetrics << "},\"counts\":{";
+ for (unsigned i = 0; i < countNames.size(); i++)
+  strmMetrics << (i == 0 ? "" : ",")
+              << "\"" << countNames[i] << "\":" << counts[i];
+
+ strmMetrics << "}}" << endl;
+}
+
+string MetricsRecorder::getPath(const string &pName)
+{
+ if (phasePaths.empty())
+  return pName;
+
+ return phasePaths.back() + "/" + pName;
+}
+
+/**
+ *  The phases are kept even when nothing is recorded, so that the paths
+ *  remain right if a record is begun inside a phase
+ */
+void MetricsRecorder::beginPhase(const string &pName)
+{
+ phasePaths.push_back(getPath(pName));
+ phaseTimers.push_back(Timer());
+}
+
+void MetricsRecorder::endPhase()
+{
+ if (phasePaths.empty())
+  return;
+
+ if (recording)
+ {
+  Timer &vTimer = phaseTimers.back();
+  vTimer.stop();
+
+  unsigned i = 0;
+  while ((i < timedPhases.size()) && (timedPhases[i] != phasePaths.back()))
+   i++;
+
+  if (i == timedPhases.size())
+  {
+   timedPhases.push_back(phasePaths.back());
+   phaseTimes.push_back(pair<double, double>(0, 0));
+   }
+
+  phaseTimes[i].first += vTimer.getElapsedTime();
+  phaseTimes[i].second += vTimer.getCPUTime();
+  }
+
+ phasePaths.pop_back();
+ phaseTimers.pop_back();
+}
+
+void MetricsRecorder::addCount(const string &pName, unsigned long pCount)
+{
+ if (!recording)
+  return;
+
+ string vPath = getPath(pName);
+
+ unsigned i = 0;
+ while ((i < countNames.size()) && (countNames[i] != vPath))
+  i++;
+
+ if (i == countNames.size())
+ {
+  countNames.push_back(vPath);
+  counts.push_back(0);
+  }
+
+ counts[i] += pCount;
+}
+
+
+PhaseGuard::PhaseGuard(const string &pName)
+{
+ MetricsRecorder::beginPhase(pName);
+}
+
+PhaseGuard::~PhaseGuard()
+{
+ MetricsRecorder::endPhase();
+}
@@ -0,0 +1,113 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Timers and per-iteration metrics of bootstrapping runs
+ *
+ *  Timer measures the wall clock time by the monotonic clock and the CPU
+ *  time of the process, both in nanosecond resolution. The CPU time is of
+ *  all threads of the process, including the workers a phase starts (e.g.
+ *  the loaders of the chunks) but also the ones running in the background
+ *  meanwhile (e.g. asynchronous saving).
+ *
+ *  MetricsRecorder collects the times of the phases of an iteration (e.g.
+ *  loading, labeling, training) and some counts, and writes them as a
+ *  record per iteration into a metrics file, one JSON object per line
+ *  (e.g. {"iteration":1,"elapsed":..,"process_cpu":..,"rss":..,
+ *  "phases":{..},"counts":{..}}). Phases are nested: a phase begun inside
+ *  another one is recorded by the path of their names (e.g. "dev/label"),
+ *  and the times of the phases of the same path in a record are summed up.
+ *  Counts are recorded by the path of the phase they are added in too.
+ *
+ *  The components begin their own phases (e.g. ZMEClassifier::classify()
+ *  begins "label") and the executables begin the enclosing ones (e.g. the
+ *  data set); nothing is recorded while no record is begun or the metrics
+ *  file is not open. The recorder is not thread-safe and must be used only
+ *  by the main thread.
+ *
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <time.h>
+
+using namespace std;
+
+
+// returns the time of the monotonic clock in seconds
+double getMonotonicTime();
+
+class Timer
+{
+ private:
+
+  timespec startWallTime;
+  timespec startCPUTime;
+
+  double elapsedTime;
+  double cpuTime;
+
+ public:
+
+  Timer();
+
+  void start();
+  // stops the timer and keeps the times since the last start()
+  void stop();
+  // times in seconds
+  double getElapsedTime();
+  double getCPUTime();
+};
+
+class MetricsRecorder
+{
+ private:
+
+  static ofstream strmMetrics;
+  static bool recording;
+  static unsigned iteration;
+  static Timer recordTimer;
+
+  // paths and timers of the phases begun and not ended yet
+  static vector<string> phasePaths;
+  static vector<Timer> phaseTimers;
+
+  // times and counts of the current record in the order they are recorded
+  static vector<string> timedPhases;
+  static vector<pair<double, double> > phaseTimes;
+  static vector<string> countNames;
+  static vector<unsigned long> counts;
+
+  static string getPath(const string &);
+
+ public:
+
+  static short open(const string &);
+  static void close();
+  static bool isOpen();
+
+  static void beginRecord(unsigned);
+  // writes the record of the current iteration into the metrics file
+  static void endRecord();
+
+  static void beginPhase(const string &);
+  static void endPhase();
+  // adds to the count of the given name in the current phase
+  static void addCount(const string &, unsigned long);
+};
+
+// begins a phase at construction and ends it at destruction, so that the
+// phase is ended at any return of the scope
+class PhaseGuard
+{
+ public:
+
+  PhaseGuard(const string &);
+  ~PhaseGuard();
+};
+
+#endif /* METRICS_HPP */
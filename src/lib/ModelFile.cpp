@@ -0,0 +1,105 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to ModelFile.hpp)
+ *
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include "ModelFile.hpp"
+#include "Utils.hpp"
+
+
+short MEModelFile::read(const string &pModelFile)
+{
+ clear();
+
+ ifstream strmModel (pModelFile.c_str());
+ if (!strmModel)
+ {
+  cerr << "Can't open model file: " << pModelFile << endl;
+  return -1;
+  }
+
+ string vLine;
+ getline(strmModel, vLine);
+ if (trim(vLine) != "#txt,maxent")
+ {
+  cerr << "Unsupported model file format (only text models are supported): "
+       << pModelFile << endl;
+  return -1;
+  }
+
+ // predicates
+ getline(strmModel, vLine);
+ unsigned vFeatureCount = strToInt(vLine);
+ features.resize(vFeatureCount);
+ for (unsigned i = 0; i < vFeatureCount; i++)
+  getline(strmModel, features[i]);
+
+ // outcomes
+ getline(strmModel, vLine);
+ unsigned vOutcomeCount = strToInt(vLine);
+ outcomes.resize(vOutcomeCount);
+ for (unsigned i = 0; i < vOutcomeCount; i++)
+  getline(strmModel, outcomes[i]);
+
+ // outcome ids of the parameters of each predicate
+ paramStarts.reserve(vFeatureCount + 1);
+ paramStarts.push_back(0);
+ for (unsigned i = 0; i < vFeatureCount; i++)
+ {
+  unsigned vParamCount = 0;
+  strmModel >> vParamCount;
+  for (unsigned j = 0; j < vParamCount; j++)
+  {
+   unsigned short vOutcomeId = 0;
+   strmModel >> vOutcomeId;
+   paramOutcomes.push_back(vOutcomeId);
+   }
+  paramStarts.push_back(paramOutcomes.size());
+  }
+
+ // parameter values
+ unsigned vParamCount = 0;
+ strmModel >> vParamCount;
+ if (!strmModel || (vParamCount != paramOutcomes.size()))
+ {
+  cerr << "Corrupted model file: " << pModelFile << endl;
+  clear();
+  return -1;
+  }
+
+ weights.resize(vParamCount);
+ for (unsigned i = 0; i < vParamCount; i++)
+  strmModel >> weights[i];
+
+ if (!strmModel)
+ {
+  cerr << "Corrupted model file: " << pModelFile << endl;
+  clear();
+  return -1;
+  }
+
+ for (unsigned i = 0; i < vParamCount; i++)
+  if (paramOutcomes[i] >= vOutcomeCount)
+  {
+   cerr << "Corrupted model file: " << pModelFile << endl;
+   clear();
+   return -1;
+   }
+
+ return 0;
+}
+
+void MEModelFile::clear()
+{
+ features.clear();
+ outcomes.clear();
+ paramStarts.clear();
+ paramOutcomes.clear();
+ weights.clear();
+}
@@ -0,0 +1,52 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Reader of the ME models saved in the text format of MaxentModel::save()
+ *  (and PMETrainer::save()), shared by ZMEScorer::load() and 
+ *  PMETrainer::loadWeights()
+ *
+ *  The file is organized as follows:
+ *
+ *  #txt,maxent
+ *  number of predicates, followed by one predicate per line
+ *  number of outcomes, followed by one outcome per line
+ *  for each predicate: the number of its parameters followed by the
+ *   outcome id of each parameter in the same line
+ *  number of parameters, followed by one parameter (weight) per line in
+ *   the order of the predicates and their outcome ids above
+ *
+ */
+
+#ifndef MODELFILE_HPP
+#define MODELFILE_HPP
+
+#include <vector>
+#include <string>
+
+#include "Types.hpp"
+
+using namespace std;
+
+
+class MEModelFile
+{
+ public:
+
+  // features (predicates) and outcomes in the order of the file
+  vector<string> features;
+  vector<ArgLabel> outcomes;
+
+  // parameters in CSR form: the parameters of feature i are for outcomes
+  // paramOutcomes[paramStarts[i]] ... paramOutcomes[paramStarts[i + 1] - 1]
+  // with the weights at the same positions of weights
+  vector<unsigned> paramStarts;
+  vector<unsigned short> paramOutcomes;
+  vector<double> weights;
+
+  // returns 0 on success and -1 on failure
+  short read(const string &);
+  void clear();
+};
+
+#endif /* MODELFILE_HPP */
@@ -15,6 +15,13 @@
 #include "TBTree.hpp"
 #include "DTree.hpp"
 #include "Utils.hpp"
+#include "ArgLabels.hpp"
+#include "FeatureProfiler.hpp"
+#include "FeatureHasher.hpp"
+#include "FeatureRegistry.hpp"
+#include "Metrics.hpp"
+#include "MemoryAccount.hpp"
+#include "GzStream.hpp"
 
 using namespace std;
 
@@ -34,15 +41,16 @@ Sample::Sample(Proposition * const &pProp, Constituent &pCnstnt,
 {
  prop = pProp;
  cnstntToken = pCnstnt;
- goldLabel = pLabel;
- selPrdLabel.first = "";
+ goldLabel = ArgLabelRegistry::getId(pLabel);
+ selPrdLabel.first = EMPTY_LABEL_ID;
  selPrdLabel.second = 0;
+ MemoryAccount::add(MEM_SAMPLES, 1, sizeof(Sample));
   
  pProp->addSample(this); 
 
  for (unsigned short i = 0; i < pViewCount; i++)
  {
-  classifierNo[i] = -1;
+  classifierNo[i] = UNLABELED_CLASSIFIER_NO;
   activeFeatureSets[i] = pFeatureSets[i] - 1;
   // Feature views are refered by numbers starting from 1, but they are
   // converted to array index (starting from 0).
@@ -85,7 +93,7 @@ string Sample::getWordsStr()
 
 string Sample::getGoldArgLabel()
 {
- return goldLabel;
+ return ArgLabelRegistry::getLabel(goldLabel);
 }
 
 /**
@@ -93,12 +101,17 @@ string Sample::getGoldArgLabel()
  * 
  *  Based on the value of pCheckConstraints, it will check the global SRL
  *  constraints and resolve conflicts as a post-processing step.
+ * 
+ *  Only the top PRD_LABEL_TOP_K labels (pLabels is sorted by probability)
+ *  are stored.
  */  
 bool Sample::setPrdArgLabels(vector<pair<ArgLabel, double> > &pLabels,
                              unsigned short pFeatureView, 
                              unsigned short pClassifierNo,
                              bool pCheckConstraints)
 {
+ // number of the labels held before, to account for the change
+ long vPrevCount = prdLabels[pFeatureView - 1].size();
 
  if (!prdLabels[pFeatureView - 1].empty())
  {
@@ -116,7 +129,16 @@ bool Sample::setPrdArgLabels(vector<pair<ArgLabel, double> > &pLabels,
   if (pLabels.at(0).first != "NULL")
    resolveConstraints(pLabels, pFeatureView);
   
- prdLabels[pFeatureView - 1] = pLabels;
+ unsigned short vTopK = pLabels.size() < PRD_LABEL_TOP_K ? pLabels.size() : PRD_LABEL_TOP_K;
+ long vAddedCount = (long) vTopK - vPrevCount;
+ MemoryAccount::add(MEM_PRD_LABELS, vAddedCount,
+                    vAddedCount * (long) sizeof(pair<ArgLabelId, float>));
+ prdLabels[pFeatureView - 1].resize(vTopK);
+ for (unsigned short i = 0; i < vTopK; i++)
+ {
+  prdLabels[pFeatureView - 1][i].first = ArgLabelRegistry::getId(pLabels[i].first);
+  prdLabels[pFeatureView - 1][i].second = pLabels[i].second;
+  }
  
  classifierNo[pFeatureView - 1] = pClassifierNo;
  return true;
@@ -127,7 +149,18 @@ short Sample::getClassifierNo(unsigned short pFeatureView)
  return classifierNo[pFeatureView - 1];
 }
 
+bool Sample::isLabeledBy(unsigned short pFeatureView, short pClassifierNo)
+{
+ return (!prdLabels[pFeatureView - 1].empty()) && 
+        (classifierNo[pFeatureView - 1] == pClassifierNo);
+}
+
 ArgLabel Sample::getPrdArgLabel(unsigned short pFeatureView)
+{
+ return ArgLabelRegistry::getLabel(getPrdArgLabelId(pFeatureView));
+}
+
+ArgLabelId Sample::getPrdArgLabelId(unsigned short pFeatureView)
 {
  // if the requested feature view is 0, it means that the selected common
  // label is requested
@@ -135,7 +168,7 @@ ArgLabel Sample::getPrdArgLabel(unsigned short pFeatureView)
   return selPrdLabel.first; 
  
  if (prdLabels[pFeatureView - 1].empty())
-  return "";
+  return EMPTY_LABEL_ID;
  else
   return prdLabels[pFeatureView - 1].at(0).first;
 }
@@ -170,20 +203,25 @@ ArgLabel Sample::getPrdOrGoldArgLabel(unsigned short pFeatureView)
  // label is requested
  if (pFeatureView == 0)
  {
-  if (!selPrdLabel.first.empty())
-   return selPrdLabel.first;
+  if (selPrdLabel.first != EMPTY_LABEL_ID)
+   return ArgLabelRegistry::getLabel(selPrdLabel.first);
   else 
    // if selected common label is empty, the sample is gold
-   return goldLabel;
+   return ArgLabelRegistry::getLabel(goldLabel);
   }
 
  if (!prdLabels[pFeatureView - 1].empty())
-  return prdLabels[pFeatureView - 1].at(0).first;
+  return ArgLabelRegistry::getLabel(prdLabels[pFeatureView - 1].at(0).first);
  else
-  return goldLabel;
+  return ArgLabelRegistry::getLabel(goldLabel);
 }
 
 void Sample::setSelPrdLabel(ArgLabel pLabel, double pProb)
+{
+ setSelPrdLabel(ArgLabelRegistry::getId(pLabel), pProb);
+}
+
+void Sample::setSelPrdLabel(ArgLabelId pLabel, double pProb)
 {
  selPrdLabel.first = pLabel;
  selPrdLabel.second = pProb;
@@ -191,7 +229,7 @@ void Sample::setSelPrdLabel(ArgLabel pLabel, double pProb)
 
 ArgLabel Sample::getSelPrdLabel()
 {
- return selPrdLabel.first;
+ return ArgLabelRegistry::getLabel(selPrdLabel.first);
 }
 
 double Sample::getSelPrdLabelProb()
@@ -206,38 +244,43 @@ void Sample::setSelectedPrdLabel(unsigned short pSelectionMethod,
   {
    case (AGREEMENT_ONLY):
     if (isPrdArgLabelsAgreed())
-     setSelPrdLabel(getPrdArgLabel(1), getAvgPrdArgLabelProb());
+     setSelPrdLabel(getPrdArgLabelId(1), getAvgPrdArgLabelProb());
     else
-     setSelPrdLabel("NULL", 0); 
+     setSelPrdLabel((ArgLabelId) NULL_LABEL_ID, 0); 
     break;
    case (AGREEMENT_CONFIDENCE):
     if (isPrdArgLabelsAgreed())
-     setSelPrdLabel(getPrdArgLabel(1), getAvgPrdArgLabelProb());
+     setSelPrdLabel(getPrdArgLabelId(1), getAvgPrdArgLabelProb());
     else
-     setSelPrdLabel(getMCPrdLabel(), getMCPrdLabelProb()); 
+     setSelPrdLabel(getMCPrdLabelId(), getMCPrdLabelProb()); 
     break;
    case (AGREEMENT_PREFERED_VIEW):
     if (isPrdArgLabelsAgreed())
-     setSelPrdLabel(getPrdArgLabel(1), getAvgPrdArgLabelProb());
+     setSelPrdLabel(getPrdArgLabelId(1), getAvgPrdArgLabelProb());
     else
-     setSelPrdLabel(getPrdArgLabel(pPreferedView), getPrdArgLabelProb(pPreferedView)); 
+     setSelPrdLabel(getPrdArgLabelId(pPreferedView), getPrdArgLabelProb(pPreferedView)); 
     break;
    case (CONFIDENECE_ONLY):
-    setSelPrdLabel(getMCPrdLabel(), getMCPrdLabelProb()); 
+    setSelPrdLabel(getMCPrdLabelId(), getMCPrdLabelProb()); 
     break;
    }
 }  
 
 ArgLabel Sample::getMCPrdLabel()
+{
+ return ArgLabelRegistry::getLabel(getMCPrdLabelId());
+}
+
+ArgLabelId Sample::getMCPrdLabelId()
 {
  double tmpMaxProb = getPrdArgLabelProb(1);
- ArgLabel tmpMCLabel = getPrdArgLabel(1);
+ ArgLabelId tmpMCLabel = getPrdArgLabelId(1);
  
  for (unsigned short cntView = 2; cntView <= FEATURE_VIEW_COUNT; cntView++)
   if (tmpMaxProb < getPrdArgLabelProb(cntView))
   {
    tmpMaxProb = getPrdArgLabelProb(cntView);
-   tmpMCLabel = getPrdArgLabel(cntView);
+   tmpMCLabel = getPrdArgLabelId(cntView);
    }
  
 return tmpMCLabel;
@@ -257,23 +300,19 @@ double Sample::getMCPrdLabelProb()
 
 bool Sample::isPrdArgument(unsigned short pFeatureView)
 {
- return (getPrdArgLabel(pFeatureView) != "NULL");
+ return (getPrdArgLabelId(pFeatureView) != NULL_LABEL_ID);
 }
 
 bool Sample::isPrdCoreArg(unsigned short pFeatureView)
 {
- for (unsigned short i = 0; !CORE_ARGS[i].empty(); i++)
-  if (getPrdArgLabel(pFeatureView) == CORE_ARGS[i])
-   return true;
- 
- return false;  
+ return ArgLabelRegistry::isCore(getPrdArgLabelId(pFeatureView));
 }
 
 bool Sample::isPrdArgLabelsAgreed()
 {
- ArgLabel tmpLabel = getPrdArgLabel(1);
+ ArgLabelId tmpLabel = getPrdArgLabelId(1);
  for (unsigned short cntView = 2; cntView <= FEATURE_VIEW_COUNT; cntView++)
-  if (tmpLabel != getPrdArgLabel(cntView))
+  if (tmpLabel != getPrdArgLabelId(cntView))
    return false;
  
  return true;
@@ -302,8 +341,7 @@ void Sample::resolveConstraints(vector<pair<ArgLabel, double> > &pLabels,
   // if the current is not this sample, its most probable label is not
   // NULL, and it is already labeled, process the constraints
   if ((*itSample != this) && 
-      ((*itSample)->getPrdArgLabel(pFeatureView) != "NULL") &&
-      ((*itSample)->getPrdArgLabel(pFeatureView) != ""))
+      ArgLabelRegistry::isArgument((*itSample)->getPrdArgLabelId(pFeatureView)))
   {
    // applying constraint 1:
    if ((*itSample)->isPrdCoreArg(pFeatureView) &&
@@ -311,7 +349,7 @@ void Sample::resolveConstraints(vector<pair<ArgLabel, double> > &pLabels,
    {
     if (pLabels[0].second > (*itSample)->getPrdArgLabelProb(pFeatureView))
     {
-     (*itSample)->prdLabels[pFeatureView - 1][0].first = "NULL";
+     (*itSample)->prdLabels[pFeatureView - 1][0].first = NULL_LABEL_ID;
      // since the label of current sample became NULL, no need to check 
      // for other constraints
      continue;
@@ -331,7 +369,7 @@ void Sample::resolveConstraints(vector<pair<ArgLabel, double> > &pLabels,
    {
     if (pLabels[0].second > (*itSample)->getPrdArgLabelProb(pFeatureView))
     {
-     (*itSample)->prdLabels[pFeatureView - 1][0].first = "NULL";
+     (*itSample)->prdLabels[pFeatureView - 1][0].first = NULL_LABEL_ID;
      // since the label of current sample became NULL, no need to check 
      // for other constraints
      continue;
@@ -348,6 +386,12 @@ void Sample::resolveConstraints(vector<pair<ArgLabel, double> > &pLabels,
    } 
 }
 
+void Sample::nullifyPrdArgLabel(unsigned short pFeatureView)
+{
+ if (!prdLabels[pFeatureView - 1].empty())
+  prdLabels[pFeatureView - 1][0].first = NULL_LABEL_ID;
+}
+
 bool Sample::isOverlapped(Sample &pSample)
 {
  switch (getSpansRelation(getWordSpan(), pSample.getWordSpan()))
@@ -374,246 +418,353 @@ void Sample::extractFeatures(unsigned short pFeatureView)
       FEATURES[activeFeatureSets[pFeatureView - 1]][cntFeatures] != E_O_F;
       cntFeatures++)
  {
-  switch (FEATURES[activeFeatureSets[pFeatureView - 1]][cntFeatures])
+  unsigned short vFeatureType = FEATURES[activeFeatureSets[pFeatureView - 1]][cntFeatures];
+  
+  // the feature has already been extracted for another view
+  short vIdx = indexOfFeature(vFeatureType);
+  if (vIdx != -1)
+  {
+   featureViews[pFeatureView - 1].push_back(vIdx);
+   continue;
+   }
+  
+  double vStartTime = 0;
+  if (FeatureProfiler::isEnabled())
+   vStartTime = getMonotonicTime();
+   
+  switch (vFeatureType)
   {    
    case (TRIAL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("TRIAL", extractTrialFeature()));
+    features.push_back(pair<string, string> ("TRIAL", extractTrialFeature()));
     break;
 
    case (PT_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PT", extractPhraseType()));
+    features.push_back(pair<string, string> ("PT", extractPhraseType()));
     break;
 
    case (PL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PL", extractPredLemma()));
+    features.push_back(pair<string, string> ("PL", extractPropFeature(PL_F)));
     break;
 
    case (PP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PP", extractPredPOS()));
+    features.push_back(pair<string, string> ("PP", extractPropFeature(PP_F)));
     break;
 
    case (PVP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PVP", extractPredVoice() + extractPosition()));
+    features.push_back(pair<string, string> ("PVP", extractPropFeature(PV_F) + extractPosition()));
     break;
 
    case (PATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PATH", extractPath()));
+    features.push_back(pair<string, string> ("PATH", extractPath()));
     break;
   
    case (CVNCP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CVNCP", extractCVNCountInPath(pFeatureView)));
+    features.push_back(pair<string, string> ("CVNCP", extractCVNCountInPath()));
     break;
   
    case (PTHLEN_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PTHLEN", extractPathLength(pFeatureView)));
+    features.push_back(pair<string, string> ("PTHLEN", extractPathLength()));
     break;
   
    case (HW_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("HW", extractHeadWord()));
+    features.push_back(pair<string, string> ("HW", extractHeadWord()));
     break;
   
    case (CW_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CW", extractContentWord()));
+    features.push_back(pair<string, string> ("CW", extractContentWord()));
     break;
 
    case (HWL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("HWL", extractHeadWordLemma()));
+    features.push_back(pair<string, string> ("HWL", extractHeadWordLemma()));
     break;
   
    case (CWL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CWL", extractContentWordLemma()));
+    features.push_back(pair<string, string> ("CWL", extractContentWordLemma()));
     break;
 
    case (GC_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("GC", extractGovCat()));
+    features.push_back(pair<string, string> ("GC", extractGovCat()));
     break;
   
    case (PS_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PS", extractPredSubcat()));
+    features.push_back(pair<string, string> ("PS", extractPropFeature(PS_F)));
     break;
   
    case (CS_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CS", extractCnstntSubcat()));
+    features.push_back(pair<string, string> ("CS", extractCnstntSubcat()));
     break;
   
    case (CPD_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CPD", extractCPDistance()));
+    features.push_back(pair<string, string> ("CPD", extractCPDistance()));
     break;
   
    case (CPI_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CPI", extractCPIdentifier()));
+    features.push_back(pair<string, string> ("CPI", extractPropFeature(CPI_F)));
     break;
  
    case (HLC_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("HLC", extractHWLocation()));
+    features.push_back(pair<string, string> ("HLC", extractHWLocation()));
     break;
 
    case (HWP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("HWP", extractHeadWordPOS()));
+    features.push_back(pair<string, string> ("HWP", extractHeadWordPOS()));
     break;
 
    case (CWP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("CWP", extractContentWordPOS()));
+    features.push_back(pair<string, string> ("CWP", extractContentWordPOS()));
     break;
 
    case (POSITION_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("POSITION", extractPosition()));
+    features.push_back(pair<string, string> ("POSITION", extractPosition()));
     break;
 
    case (PV_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PV", extractPredVoice())); 
+    features.push_back(pair<string, string> ("PV", extractPropFeature(PV_F))); 
     break;
 
    case (PF_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PF", extractPredForm())); 
+    features.push_back(pair<string, string> ("PF", extractPropFeature(PF_F))); 
     break;
 
    case (AWF_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWF", extractAWForm())); 
+    features.push_back(pair<string, string> ("AWF", extractAWForm())); 
     break;
 
    case (AWR_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWR", extractAWRel())); 
+    features.push_back(pair<string, string> ("AWR", extractAWRel())); 
     break;
 
    case (PR_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PR", extractPredRel())); 
+    features.push_back(pair<string, string> ("PR", extractPropFeature(PR_F))); 
     break;
 
    case (AWHF_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWH", extractAWHeadForm())); 
+    features.push_back(pair<string, string> ("AWH", extractAWHeadForm())); 
     break;
 
    case (AWHL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWHL", extractAWHeadLemma())); 
+    features.push_back(pair<string, string> ("AWHL", extractAWHeadLemma())); 
     break;
 
    case (AWHP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWHP", extractAWHeadPOS())); 
+    features.push_back(pair<string, string> ("AWHP", extractAWHeadPOS())); 
     break;
     
    case (PCRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PCRP", extractPredChildrenRP())); 
+    features.push_back(pair<string, string> ("PCRP", extractPropFeature(PCRP_F))); 
     break;
     
    case (AWCRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWCRP", extractAWChildrenRP())); 
+    features.push_back(pair<string, string> ("AWCRP", extractAWChildrenRP())); 
     break;
 
    case (PCPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PCPP", extractPredChildrenPP())); 
+    features.push_back(pair<string, string> ("PCPP", extractPropFeature(PCPP_F))); 
     break;
     
    case (AWCPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWCPP", extractAWChildrenPP())); 
+    features.push_back(pair<string, string> ("AWCPP", extractAWChildrenPP())); 
     break;
 
    case (RPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("RPATH", extractRelPath())); 
+    features.push_back(pair<string, string> ("RPATH", extractRelPath())); 
     break;
 
    case (ARPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("ARPATH", extractARelPath())); 
+    features.push_back(pair<string, string> ("ARPATH", extractARelPath())); 
     break;
 
    case (PPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PPATH", extractPOSPath())); 
+    features.push_back(pair<string, string> ("PPATH", extractPOSPath())); 
     break;
 
    case (APPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("APPATH", extractAPOSPath())); 
+    features.push_back(pair<string, string> ("APPATH", extractAPOSPath())); 
     break;
 
    case (FAMREL_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("FAMREL", extractFamilyRelation())); 
+    features.push_back(pair<string, string> ("FAMREL", extractFamilyRelation())); 
     break;
 
    case (PSRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PSRP", extractPredSiblingsRP())); 
+    features.push_back(pair<string, string> ("PSRP", extractPropFeature(PSRP_F))); 
     break;
     
    case (PSPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PSPP", extractPredSiblingsPP())); 
+    features.push_back(pair<string, string> ("PSPP", extractPropFeature(PSPP_F))); 
     break;
     
    case (PPSRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PPSRP", extractPredParentSiblingsRP())); 
+    features.push_back(pair<string, string> ("PPSRP", extractPropFeature(PPSRP_F))); 
     break;
     
    case (PPSPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("PPSPP", extractPredParentSiblingsPP())); 
+    features.push_back(pair<string, string> ("PPSPP", extractPropFeature(PPSPP_F))); 
     break;
     
    case (AWSRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWSRP", extractAWSiblingsRP())); 
+    features.push_back(pair<string, string> ("AWSRP", extractAWSiblingsRP())); 
     break;
     
    case (AWSPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWSPP", extractAWSiblingsPP())); 
+    features.push_back(pair<string, string> ("AWSPP", extractAWSiblingsPP())); 
     break;
     
    case (AWPSRP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWPSRP", extractAWParentSiblingsRP())); 
+    features.push_back(pair<string, string> ("AWPSRP", extractAWParentSiblingsRP())); 
     break;
     
    case (AWPSPP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWPSPP", extractAWParentSiblingsPP())); 
+    features.push_back(pair<string, string> ("AWPSPP", extractAWParentSiblingsPP())); 
     break;
     
    case (AWLRF_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWLRF", extractAWLRChildrenForms())); 
+    features.push_back(pair<string, string> ("AWLRF", extractAWLRChildrenForms())); 
     break;
     
    case (AWLSF_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWLSF", extractAWLSiblingForm())); 
+    features.push_back(pair<string, string> ("AWLSF", extractAWLSiblingForm())); 
     break;
     
    case (LCAPOS_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("LCAPOS", extractLCommonAncestorPOS())); 
+    features.push_back(pair<string, string> ("LCAPOS", extractLCommonAncestorPOS())); 
     break;
     
    case (AWLCRPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWLCRPATH", extractAWRelPathToLCA())); 
+    features.push_back(pair<string, string> ("AWLCRPATH", extractAWRelPathToLCA())); 
     break;
     
    case (AWLCPPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWLCPPATH", extractAWPOSPathToLCA())); 
+    features.push_back(pair<string, string> ("AWLCPPATH", extractAWPOSPathToLCA())); 
     break;
     
    case (DPTHLEN_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("DPTHLEN", extractDepPathLength(pFeatureView))); 
+    features.push_back(pair<string, string> ("DPTHLEN", extractDepPathLength())); 
     break;
     
    case (LPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("LPATH", extractLemmaPath())); 
+    features.push_back(pair<string, string> ("LPATH", extractLemmaPath())); 
     break;
     
    case (AWLCLPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("AWLCLPATH", extractAWLemmaPathToLCA())); 
+    features.push_back(pair<string, string> ("AWLCLPATH", extractAWLemmaPathToLCA())); 
     break;
     
    case (LCRRPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("LCRRPATH", extractLSARelPathToRoot())); 
+    features.push_back(pair<string, string> ("LCRRPATH", extractLSARelPathToRoot())); 
     break;
     
    case (LCRPPATH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("LCRPPATH", extractLSAPOSPathToRoot())); 
+    features.push_back(pair<string, string> ("LCRPPATH", extractLSAPOSPathToRoot())); 
     break;
     
    case (DDPTHLEN_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("DDPTHLEN", extractDividedDepPathLength(pFeatureView))); 
+    features.push_back(pair<string, string> ("DDPTHLEN", extractDividedDepPathLength())); 
     break;
     
    case (ISCAP_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("ISCAP", extractIsCapital())); 
+    features.push_back(pair<string, string> ("ISCAP", extractIsCapital())); 
     break;
     
    case (ISWH_F):
-    featureVectors[pFeatureView - 1].push_back(pair<string, string> ("ISWH", extractIsWH())); 
+    features.push_back(pair<string, string> ("ISWH", extractIsWH())); 
     break;
     
    } 
+   
+  // unknown feature types are not extracted
+  if (features.size() > featureTypes.size())
+  {
+   if (FeatureProfiler::isEnabled())
+    FeatureProfiler::addCall(vFeatureType, features.back().first, 
+                             getMonotonicTime() - vStartTime,
+                             features.back().second.size());
+   MemoryAccount::add(MEM_FEATURES, 1, 
+                      sizeof(pair<string, string>) + features.back().first.size() + 
+                      features.back().second.size());
+   
+   featureTypes.push_back(vFeatureType);
+   featureViews[pFeatureView - 1].push_back(features.size() - 1);
+   }
+  }
+}
+
+/**
+ *  returns the index of the feature type in the shared feature store, or 
+ *  -1 if it has not been extracted for any view yet
+ */
+short Sample::indexOfFeature(unsigned short pFeatureType)
+{
+ for (unsigned short cntFeature = 0; 
+      cntFeature < featureTypes.size(); 
+      cntFeature++)
+  if (featureTypes[cntFeature] == pFeatureType)
+   return cntFeature;
+   
+ return -1;
+}
+
+/**
+ *  extracts a feature which depends only on the proposition: if its scope 
+ *  is PROP_SCOPE (see PROP_SCOPE_FEATURES), the value is extracted once by 
+ *  the first sample of the proposition and reused by the other samples and 
+ *  feature views. 
+ */
+string Sample::extractPropFeature(unsigned short pFeatureType)
+{
+ string vValue;
+ bool vShared = (getFeatureScope(pFeatureType) == PROP_SCOPE);
+ 
+ if (vShared && prop->getCachedFeature(pFeatureType, vValue))
+  return vValue;
+  
+ switch (pFeatureType)
+ {
+  case (PL_F):
+   vValue = extractPredLemma();
+   break;
+  case (PP_F):
+   vValue = extractPredPOS();
+   break;
+  case (PV_F):
+   vValue = extractPredVoice();
+   break;
+  case (PS_F):
+   vValue = extractPredSubcat();
+   break;
+  case (PF_F):
+   vValue = extractPredForm();
+   break;
+  case (CPI_F):
+   vValue = extractCPIdentifier();
+   break;
+  case (PR_F):
+   vValue = extractPredRel();
+   break;
+  case (PCRP_F):
+   vValue = extractPredChildrenRP();
+   break;
+  case (PCPP_F):
+   vValue = extractPredChildrenPP();
+   break;
+  case (PSRP_F):
+   vValue = extractPredSiblingsRP();
+   break;
+  case (PSPP_F):
+   vValue = extractPredSiblingsPP();
+   break;
+  case (PPSRP_F):
+   vValue = extractPredParentSiblingsRP();
+   break;
+  case (PPSPP_F):
+   vValue = extractPredParentSiblingsPP();
+   break;
   }
+ 
+ if (vShared)
+  prop->cacheFeature(pFeatureType, vValue);
+  
+ return vValue;
 }
 
 /**
@@ -683,16 +834,13 @@ string Sample::extractPath()
  *  the most efficient way is to first extract path then its length (in 
  *  extractFeatures() function) if the path itself is enabled.
  */
-string Sample::extractPathLength(unsigned short pFeatureView)
+string Sample::extractPathLength()
 {
  string vPath;
  
- unsigned short tmpIdx = indexIn(PATH_F, 
-                                 FEATURES[activeFeatureSets[pFeatureView - 1]], 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]]) / 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]][0]));
- if ((tmpIdx != -1) && !featureVectors[pFeatureView - 1][tmpIdx].second.empty())
-  vPath = featureVectors[pFeatureView - 1][tmpIdx].second; 
+ short tmpIdx = indexOfFeature(PATH_F);
+ if ((tmpIdx != -1) && !features[tmpIdx].second.empty())
+  vPath = features[tmpIdx].second; 
  else
   vPath = extractPath();
  
@@ -701,16 +849,13 @@ string Sample::extractPathLength(unsigned short pFeatureView)
  return intToStr(tmpvcPath.size()); 
 }
 
-string Sample::extractCVNCountInPath(unsigned short pFeatureView)
+string Sample::extractCVNCountInPath()
 {
  string vPath;
  
- unsigned short tmpIdx = indexIn(PATH_F, 
-                                 FEATURES[activeFeatureSets[pFeatureView - 1]], 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]]) / 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]][0]));
- if ((tmpIdx != -1) && !featureVectors[pFeatureView - 1][tmpIdx].second.empty())
-  vPath = featureVectors[pFeatureView - 1][tmpIdx].second; 
+ short tmpIdx = indexOfFeature(PATH_F);
+ if ((tmpIdx != -1) && !features[tmpIdx].second.empty())
+  vPath = features[tmpIdx].second; 
  else
   vPath = extractPath();
  
@@ -1073,16 +1218,13 @@ string Sample::extractAWLemmaPathToLCA()
   return vArgNode->getLemmaPathTo(vLCANode);
 }
 
-string Sample::extractDepPathLength(unsigned short pFeatureView)
+string Sample::extractDepPathLength()
 {
  string vPath;
  
- unsigned short tmpIdx = indexIn(ARPATH_F, 
-                                 FEATURES[activeFeatureSets[pFeatureView - 1]], 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]]) / 
-                                 sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]][0]));
- if ((tmpIdx != -1) && (!featureVectors[pFeatureView - 1][tmpIdx].second.empty()))
-  vPath = featureVectors[pFeatureView - 1][tmpIdx].second; 
+ short tmpIdx = indexOfFeature(ARPATH_F);
+ if ((tmpIdx != -1) && (!features[tmpIdx].second.empty()))
+  vPath = features[tmpIdx].second; 
  else
   vPath = extractARelPath();
  
@@ -1123,22 +1265,19 @@ string Sample::extractLSAPOSPathToRoot()
   return vLCANode->getPOSPathTo(vLCANode->getRoot());
 }
 
-string Sample::extractDividedDepPathLength(unsigned short pFeatureView)
+string Sample::extractDividedDepPathLength()
 {
  string vPath;
  unsigned short vPath1Length = 0;
  unsigned short vPath2Length = 0;
  vector<string> tmpvcPath;
- unsigned short tmpIdx;
+ short tmpIdx;
  
  // extracting the length of whole path
- tmpIdx = indexIn(ARPATH_F, 
-                  FEATURES[activeFeatureSets[pFeatureView - 1]], 
-                  sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]]) / 
-                  sizeof(FEATURES[activeFeatureSets[pFeatureView - 1]][0]));
+ tmpIdx = indexOfFeature(ARPATH_F);
          
- if ((tmpIdx != -1) && (!featureVectors[pFeatureView - 1][tmpIdx].second.empty()))
-  vPath = featureVectors[pFeatureView - 1][tmpIdx].second; 
+ if ((tmpIdx != -1) && (!features[tmpIdx].second.empty()))
+  vPath = features[tmpIdx].second; 
  else
   vPath = extractARelPath();
  
@@ -1183,15 +1322,36 @@ string Sample::extractIsWH()
 void Sample::getZMEContext(vector<string> &pZMEFeatureVector, unsigned short pFeatureView)
 {
  for (unsigned short cntFeature = 0; 
-      cntFeature < featureVectors[pFeatureView - 1].size();
+      cntFeature < featureViews[pFeatureView - 1].size();
       cntFeature++)
+ {
+  pair<string, string> &vFeature = features[featureViews[pFeatureView - 1][cntFeature]];
   // if the value of feature is empty string, it will not be added to
   // feature vector (context)
-  if (featureVectors[pFeatureView - 1][cntFeature].second != "")
-  {
-   pZMEFeatureVector.push_back(featureVectors[pFeatureView - 1][cntFeature].first + '=' +   
-                               featureVectors[pFeatureView - 1][cntFeature].second);
-   }
+  if (vFeature.second == "")
+   continue;
+  
+  if (FeatureHasher::isHashing())
+   pZMEFeatureVector.push_back(FeatureHasher::hash(vFeature.first, vFeature.second));
+  else
+   pZMEFeatureVector.push_back(vFeature.first + '=' + vFeature.second);
+  }
+}
+
+const vector<unsigned> &Sample::getZMEContextIds(unsigned short pFeatureView)
+{
+ vector<unsigned> &vIds = contextIds[pFeatureView - 1];
+ 
+ // (an empty context is simply interned again)
+ if (vIds.empty())
+ {
+  vector<string> vContext;
+  getZMEContext(vContext, pFeatureView);
+  FeatureRegistry::getContextIds(vContext, vIds);
+  MemoryAccount::add(MEM_FEATURES, 0, vIds.size() * sizeof(unsigned));
+  }
+ 
+ return vIds;
 }
 
 string Sample::getZMEContextStr(unsigned short pFeatureView)
@@ -1215,18 +1375,28 @@ void Sample::writeToZME(unsigned short pFeatureView, ofstream &pStrmZME)
  {
   pStrmZME.seekp(pStrmZME.tellp(),fstream::beg);
 
-  pStrmZME << goldLabel << " " 
-           << getZMEContextStr(pFeatureView) << endl;
+  vector<string> vContext;
+  getZMEContext(vContext, pFeatureView);
+  
+  // the negative features of signed hashing are written as the buckets 
+  // with value -1 in the syntax of maxent (e.g. "1234:-1")
+  pStrmZME << getGoldArgLabel();
+  for (vector<string>::iterator itFeature = vContext.begin();
+       itFeature < vContext.end();
+       itFeature++)
+   if (FeatureHasher::isNegative(*itFeature))
+    pStrmZME << " " << itFeature->substr(1) << ":-1";
+   else
+    pStrmZME << " " << *itFeature;
+  pStrmZME << endl;
 
   }
 }
 
-void Sample::logPrdLabeling(unsigned short pFeatureView, ofstream &pStrm)
+void Sample::logPrdLabeling(unsigned short pFeatureView, OGzStream &pStrm)
 {
- if(pStrm.is_open())
+ if(pStrm.isOpen())
  {
-  pStrm.seekp(pStrm.tellp(),fstream::beg);
-  
   prop->getSentence()->display(pStrm);
         
   pStrm << getPrdArgLabel(pFeatureView) << "; "
@@ -1237,12 +1407,10 @@ void Sample::logPrdLabeling(unsigned short pFeatureView, ofstream &pStrm)
   }
 }
 
-void Sample::logPrdLabelings(unsigned short pViewCount, ofstream &pStrm)
+void Sample::logPrdLabelings(unsigned short pViewCount, OGzStream &pStrm)
 {
- if(pStrm.is_open())
+ if(pStrm.isOpen())
  {
-  pStrm.seekp(pStrm.tellp(),fstream::beg);
-  
   prop->getSentence()->display(pStrm);
         
   for (unsigned short cntView = 1; cntView <= pViewCount; cntView++)
@@ -24,6 +24,7 @@ using namespace std;
 
 
 class Proposition;
+class OGzStream;
 
 class Sample
 {
@@ -31,13 +32,14 @@ class Sample
 
   Proposition *prop;
   Constituent cnstntToken;
-  ArgLabel goldLabel;         // gold PropBank argument label
+  ArgLabelId goldLabel;       // gold PropBank argument label
   
   // vectors to store predicted labels by system paired with their probability:
   // Each item of the array is related to a feature view. For self-training
   // the array length is 1 and for co-training it's equal to the number of
   // views (e.g. 2)
-  vector<pair<ArgLabel, double> > prdLabels[FEATURE_VIEW_COUNT];          
+  // Only the PRD_LABEL_TOP_K most probable labels are kept as label ids.
+  vector<pair<ArgLabelId, float> > prdLabels[FEATURE_VIEW_COUNT];          
 
   // no of the classifier predicting the current label for each feature view
   // e.g. classifierNo[1] = 9 means that the label for feature view 1 has
@@ -52,16 +54,28 @@ class Sample
   //    to with each view)
   // 2. training views on common labels (with common-training-set co-training
   //    method)
-  pair<ArgLabel, double> selPrdLabel;          
+  pair<ArgLabelId, float> selPrdLabel;          
   
   // Each item of the array is related to a feature view. For self-training
   // the array length is 1 and for co-training it's equal to the number of
   // views (e.g. 2)
   unsigned short activeFeatureSets[FEATURE_VIEW_COUNT];
   
+  // features (name paired with value) extracted for all views, each stored 
+  // once even if it is shared by several views, and their feature types
+  vector<pair<string, string> > features;
+  vector<unsigned short> featureTypes;
+  
   // Each item of the array is related to a feature view. For self-training
   // the array length is 1 and for co-training it's equal to the number of
-  vector<pair<string, string> > featureVectors[FEATURE_VIEW_COUNT];
+  // views (e.g. 2). Each view selects its features from the shared store by
+  // their indices.
+  vector<unsigned char> featureViews[FEATURE_VIEW_COUNT];
+  
+  // the context of each feature view interned in FeatureRegistry, filled
+  // when first requested, so that the features are looked up once however
+  // many times the sample is labeled
+  vector<unsigned> contextIds[FEATURE_VIEW_COUNT];
   
  public:
 
@@ -78,6 +92,7 @@ class Sample
   ArgLabel getGoldArgLabel();
   // returns the predicted label with highest confidence for the given view
   ArgLabel getPrdArgLabel(unsigned short);
+  ArgLabelId getPrdArgLabelId(unsigned short);
   // returns the most likely predicted argument's probability for the given view
   double getPrdArgLabelProb(unsigned short);
   // returns the average probability of label predictions by all views 
@@ -91,11 +106,16 @@ class Sample
   // returns the no of classifier for the given feature view, which has
   // predicted the current label of the sample
   short getClassifierNo(unsigned short);
+  // checks whether the current label for the given feature view has been
+  // predicted by the given no of the classifier
+  bool isLabeledBy(unsigned short, short);
   void setSelPrdLabel(ArgLabel, double);
+  void setSelPrdLabel(ArgLabelId, double);
   ArgLabel getSelPrdLabel();
   double getSelPrdLabelProb();
   void setSelectedPrdLabel(unsigned short, unsigned short);
   ArgLabel getMCPrdLabel();
+  ArgLabelId getMCPrdLabelId();
   double getMCPrdLabelProb();
   // returns whether this sample is labeled as non-NULL argument or NULL
   // (non-Argument) for the given view
@@ -106,9 +126,16 @@ class Sample
   bool isPrdArgLabelsAgreed();
   // checks, finds, and resolve global SRL constraints
   void resolveConstraints(vector<pair<ArgLabel, double> > &, unsigned short);
+  // sets the most likely predicted label of the given view to NULL (when
+  // violating global SRL constraints), keeping its probability
+  void nullifyPrdArgLabel(unsigned short);
   bool isOverlapped(Sample &);
 
   void extractFeatures(unsigned short);
+  short indexOfFeature(unsigned short);
+  // extracts a predicate feature, shared through the proposition if its 
+  // scope is PROP_SCOPE
+  string extractPropFeature(unsigned short);
   // to conveniently try a new feature
   string extractTrialFeature();
   string extractPhraseType();
@@ -117,8 +144,8 @@ class Sample
   string extractPredPOS();
   string extractPredVoice();
   string extractPath();
-  string extractPathLength(unsigned short);
-  string extractCVNCountInPath(unsigned short);
+  string extractPathLength();
+  string extractCVNCountInPath();
   string extractHeadWord();
   string extractContentWord();
   string extractHeadWordLemma();
@@ -160,20 +187,21 @@ class Sample
   string extractLCommonAncestorPOS();
   string extractAWRelPathToLCA();
   string extractAWPOSPathToLCA();
-  string extractDepPathLength(unsigned short);
+  string extractDepPathLength();
   string extractLemmaPath();
   string extractAWLemmaPathToLCA();
   string extractLSARelPathToRoot();
   string extractLSAPOSPathToRoot();
-  string extractDividedDepPathLength(unsigned short);
+  string extractDividedDepPathLength();
   string extractIsCapital(); 
   string extractIsWH(); 
   
   void getZMEContext(vector<string> &, unsigned short);
   string getZMEContextStr(unsigned short);
+  const vector<unsigned> &getZMEContextIds(unsigned short);
   void writeToZME(unsigned short, ofstream &);
-  void logPrdLabeling(unsigned short, ofstream &);
-  void logPrdLabelings(unsigned short, ofstream &);
+  void logPrdLabeling(unsigned short, OGzStream &);
+  void logPrdLabelings(unsigned short, OGzStream &);
 
 };
 
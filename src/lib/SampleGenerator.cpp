@@ -15,6 +15,9 @@
 #include "Argument.hpp"
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "Metrics.hpp"
+#include "Logging.hpp"
+#include "FeatureProfiler.hpp"
 
 
 /**
@@ -63,11 +66,11 @@ int LabeledSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
                                             unsigned short pFeatureSets[],
                                             bool pWriteZME)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("generate");
+ FeatureProfiler::reset();
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
  
  ofstream strmZME;
  if (pWriteZME)
@@ -90,16 +93,16 @@ int LabeledSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
    return -1;
   
   sgAnalysis->incSentenceCount();
-  cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
+  if (Progress::isDue(itSentence + 1 == pSentences.end()))
+   cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
   }
   
  if (strmZME.is_open()) 
   strmZME.close(); 
 
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 
  return 0;
 }
@@ -186,11 +189,11 @@ int UnlabeledSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
                                               unsigned short pFeatureSets[],
                                               bool pWriteZME)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("generate");
+ FeatureProfiler::reset();
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
  
  ofstream strmZME;
  if (pWriteZME)
@@ -211,16 +214,16 @@ int UnlabeledSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
    } 
 
   sgAnalysis->incSentenceCount();
-  cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
+  if (Progress::isDue(itSentence + 1 == pSentences.end()))
+   cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
   }
   
  if (strmZME.is_open()) 
   strmZME.close(); 
 
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 
  return 0;
 }
@@ -277,11 +280,11 @@ int TestSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
                                      unsigned short pFeatureSets[],
                                      bool pWriteZME)
 {
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("generate");
+ FeatureProfiler::reset();
  
- vStartClk = clock();
- time(&vStartTime);
+ oTimer.start();
  
  ofstream strmZME;
  if (pWriteZME)
@@ -295,16 +298,16 @@ int TestSampleGenerator::generateSamples(vector<Sentence *> &pSentences,
    return -1;
 
   sgAnalysis->incSentenceCount();
-  cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
+  if (Progress::isDue(itSentence + 1 == pSentences.end()))
+   cout << "\r" << sgAnalysis->getSentenceCount() << " sentences processed" << flush;
   }
   
  if (strmZME.is_open()) 
   strmZME.close(); 
 
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
 
  return 0;
 }
@@ -431,6 +434,9 @@ void LabeledSGAnalysis::logSGAnalysis(const double &pCPUUsage,
    
   strmLog << endl;
 
+  if (FeatureProfiler::isEnabled())
+   FeatureProfiler::report(strmLog);
+
   strmLog.close(); 
   }
 }
@@ -518,6 +524,9 @@ void UnlabeledSGAnalysis::logSGAnalysis(const double &pCPUUsage,
           << sampleCount << " samples" << endl
           << endl << endl;
 
+  if (FeatureProfiler::isEnabled())
+   FeatureProfiler::report(strmLog);
+
   strmLog.close(); 
   }
 }
@@ -597,6 +606,9 @@ void TestSGAnalysis::logSGAnalysis(const double &pCPUUsage,
 
   strmLog << endl;
 
+  if (FeatureProfiler::isEnabled())
+   FeatureProfiler::report(strmLog);
+
   strmLog.close(); 
   }
 }
@@ -0,0 +1,169 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to Scorer.hpp)
+ *
+ */
+
+#include <cmath>
+
+#include "Scorer.hpp"
+#include "ModelFile.hpp"
+#include "FeatureRegistry.hpp"
+
+
+ZMEScorer::ZMEScorer()
+{
+ loaded = false;
+}
+
+/**
+ *  Loads the weights of a model saved in text format by 
+ *  MaxentModel::save() (see ModelFile.hpp), registering its features in
+ *  FeatureRegistry
+ *
+ *  returns 0 on success and -1 on failure
+ */
+short ZMEScorer::load(const string &pModelFile)
+{
+ clear();
+
+ MEModelFile oModel;
+ if (oModel.read(pModelFile) != 0)
+  return -1;
+
+ const unsigned vFeatureCount = oModel.features.size();
+ const unsigned short vOutcomeCount = oModel.outcomes.size();
+
+ outcomes.swap(oModel.outcomes);
+ weights.assign((size_t) vFeatureCount * vOutcomeCount, 0);
+
+ vector<unsigned> vIds (vFeatureCount);
+ for (unsigned i = 0; i < vFeatureCount; i++)
+  vIds[i] = FeatureRegistry::getId(oModel.features[i]);
+
+ featureRows.assign(FeatureRegistry::getCount(), -1);
+ for (unsigned i = 0; i < vFeatureCount; i++)
+ {
+  featureRows[vIds[i]] = i;
+  double *vRow = &weights[(size_t) i * vOutcomeCount];
+  for (unsigned j = oModel.paramStarts[i]; j < oModel.paramStarts[i + 1]; j++)
+   vRow[oModel.paramOutcomes[j]] = oModel.weights[j];
+  }
+
+ loaded = true;
+
+ return 0;
+}
+
+void ZMEScorer::clear()
+{
+ featureRows.clear();
+ outcomes.clear();
+ weights.clear();
+ loaded = false;
+}
+
+bool ZMEScorer::isLoaded()
+{
+ return loaded;
+}
+
+unsigned ZMEScorer::getFeatureCount()
+{
+ return outcomes.empty() ? 0 : weights.size() / outcomes.size();
+}
+
+unsigned short ZMEScorer::getOutcomeCount()
+{
+ return outcomes.size();
+}
+
+const ArgLabel &ZMEScorer::getOutcome(unsigned short pOutcomeId)
+{
+ return outcomes[pOutcomeId];
+}
+
+/**
+ *  Computes the posterior probabilities of all outcomes for the given
+ *  context feature ids:
+ *
+ *  p(o|c) = exp(sum of weights of features of c for o) / Z(c)
+ *
+ *  The features unknown to the model are ignored. The maximum score is 
+ *  subtracted before exponentiation to avoid overflow.
+ */
+void ZMEScorer::evalAll(const vector<unsigned> &pFeatureIds,
+                        vector<double> &pProbs)
+{
+ const unsigned short vOutcomeCount = outcomes.size();
+
+ pProbs.assign(vOutcomeCount, 0);
+ double *vScores = &pProbs[0];
+
+ // adding the rows of the active features
+ for (vector<unsigned>::const_iterator itId = pFeatureIds.begin();
+      itId < pFeatureIds.end();
+      itId++)
+ {
+  const unsigned vId = *itId & ~NEGATIVE_FEATURE_ID_FLAG;
+  if ((vId >= featureRows.size()) || (featureRows[vId] < 0))
+   continue;
+
+  const double *vRow = &weights[(size_t) featureRows[vId] * vOutcomeCount];
+  if (*itId & NEGATIVE_FEATURE_ID_FLAG)
+   for (unsigned short i = 0; i < vOutcomeCount; i++)
+    vScores[i] -= vRow[i];
+  else
+   for (unsigned short i = 0; i < vOutcomeCount; i++)
+    vScores[i] += vRow[i];
+  }
+
+ // softmax
+ double vMax = vScores[0];
+ for (unsigned short i = 1; i < vOutcomeCount; i++)
+  if (vScores[i] > vMax)
+   vMax = vScores[i];
+
+ double vSum = 0;
+ for (unsigned short i = 0; i < vOutcomeCount; i++)
+ {
+  vScores[i] = exp(vScores[i] - vMax);
+  vSum += vScores[i];
+  }
+
+ const double vNorm = 1 / vSum;
+ for (unsigned short i = 0; i < vOutcomeCount; i++)
+  vScores[i] *= vNorm;
+}
+
+/**
+ *  The top outcomes are selected by insertion into the (short) output, so
+ *  only the labels of the selected ones are copied.
+ */
+void ZMEScorer::getTopLabels(const vector<double> &pProbs,
+                             unsigned short pTopK,
+                             vector<pair<ArgLabel, double> > &pPrdLabels)
+{
+ vector<unsigned short> vTopIds;
+ for (unsigned short i = 0; i < pProbs.size(); i++)
+ {
+  unsigned short k = vTopIds.size();
+  while ((k > 0) && (pProbs[vTopIds[k - 1]] < pProbs[i]))
+   k--;
+  if (k < pTopK)
+  {
+   vTopIds.insert(vTopIds.begin() + k, i);
+   if (vTopIds.size() > pTopK)
+    vTopIds.pop_back();
+   }
+  }
+
+ pPrdLabels.resize(vTopIds.size());
+ for (unsigned short k = 0; k < vTopIds.size(); k++)
+ {
+  pPrdLabels[k].first = outcomes[vTopIds[k]];
+  pPrdLabels[k].second = pProbs[vTopIds[k]];
+  }
+}
@@ -0,0 +1,67 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Scorer class to evaluate a trained Zhang Le's maxent model without
+ *  going through MaxentModel::eval_all()
+ *
+ *  The weights of the model are loaded from the model file saved by the
+ *  classifier into a dense matrix with one contiguous row of the weights 
+ *  of all outcomes per feature (predicate) of the model, zero for the 
+ *  outcomes the feature has no parameter for. The contexts are given as 
+ *  the feature ids of FeatureRegistry, which are mapped to the rows when
+ *  the model is loaded. The label posteriors are computed by adding the 
+ *  rows of the active features into a score vector of the size of the 
+ *  label set and normalizing it with softmax.
+ *
+ */
+
+#ifndef SCORER_HPP
+#define SCORER_HPP
+
+#include <vector>
+#include <string>
+
+#include "Types.hpp"
+
+using namespace std;
+
+
+class ZMEScorer
+{
+ private:
+
+  // row of each feature id of FeatureRegistry (-1 for the features unknown
+  // to the model, including those registered after loading)
+  vector<int> featureRows;
+  // outcomes (argument labels) of the model in the order of the model file
+  vector<ArgLabel> outcomes;
+
+  // dense weight matrix: weight of row i for outcome o is 
+  // weights[i * outcomes.size() + o]
+  vector<double> weights;
+
+  bool loaded;
+
+ public:
+
+  ZMEScorer();
+
+  // loads the weights from a text model file saved by MaxentModel::save()
+  short load(const string &);
+  void clear();
+  bool isLoaded();
+  unsigned getFeatureCount();
+  unsigned short getOutcomeCount();
+  const ArgLabel &getOutcome(unsigned short);
+
+  // computes the probability of each outcome (indexed by the outcome id) 
+  // for the given context feature ids (see FeatureRegistry.hpp)
+  void evalAll(const vector<unsigned> &, vector<double> &);
+  // fills the given number of the most probable outcomes of the given
+  // probabilities with their labels, sorted descending like eval_all()
+  void getTopLabels(const vector<double> &, unsigned short, 
+                    vector<pair<ArgLabel, double> > &);
+};
+
+#endif /* SCORER_HPP */
@@ -8,6 +8,9 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <set>
+#include <map>
 
 #include "Sentence.hpp"
 #include "Types.hpp"
@@ -15,11 +18,18 @@
 #include "DTree.hpp"
 #include "Argument.hpp"
 #include "DataAnalysis.hpp"
+#include "MemoryAccount.hpp"
 #include "SampleGenerator.hpp"
 #include "Sample.hpp"
 #include "Utils.hpp"
+#include "ArgLabels.hpp"
+#include "GzStream.hpp"
 
 
+// labels of the predicate and its continuation in CoNLL props format
+static const string PRED_SE_LABEL = "V";
+static const string PRED_C_SE_LABEL = "C-V";
+
 /**
  * 
  *  Sentence class definitions
@@ -29,6 +39,7 @@
 Sentence::Sentence()
 {
  tbTree = NULL;
+ MemoryAccount::add(MEM_SENTENCES, 1, sizeof(Sentence));
  
  // when a sentence is created, a DTree is immediately created and assigned 
  // to it (unlike TBTree), which is in fact the root node of the tree
@@ -170,6 +181,12 @@ void Sentence::setTBTree(TBTree * const  & pTBTree)
  tbTree = pTBTree;
 }
 
+void Sentence::precomputeTBTree()
+{
+ if (tbTree)
+  tbTree->precompute();
+}
+
 TBTree* Sentence::getTBTree()
 {
  return tbTree;
@@ -208,24 +225,6 @@ void Sentence::setPropPredWord(const short &pPropNo, const WordIdx &pWord)
  props[pPropNo-1]->setPredWord(pWord);
 }
 
-/**
- *  iterates propositions of the senetnce to gather the predicate word 
- *  index of each of them to compose a vector as a template
- * 
- *  Each vector is in the length of the sentence and the lemma of each
- *  predicate id put exaclty in the element that corresponds to its
- *  index in the sentence. other elements are left empty.
- */
-void Sentence::getPredTemplate(vector<string> &pPredTemplate)
-{
- pPredTemplate.resize(words.size());
- 
- for (vector<Proposition *>::iterator itProp = props.begin();
-      itProp < props.end(); 
-      itProp++)
-  pPredTemplate.at((*itProp)->getPredWordIdx()-1) = (*itProp)->getPredLemma();
-}
-
 void Sentence::setPropPredSpanStart(const short &pPropNo, const WordIdx &pStart)
 {
  props[pPropNo-1]->setPredSpanStart(pStart);
@@ -294,29 +293,6 @@ short Sentence::getPropArgCount(const short &pPropNo)
  return props[pPropNo-1]->getArgCount();
 }
 
-/**
- *  iterates propositions of the sentence to gather the predicates and
- *  predicted arguments of each of them in start/end format, then put 
- *  them in a vector specific for that proposition
- */
-void Sentence::getPropsArgsSEStrs(vector< vector<string> > &pArgSEStrs,
-                                  unsigned short pFeatureView)
-{
- pArgSEStrs.resize(props.size());
- 
- short cntProp = 0;
- 
- for (vector<Proposition *>::iterator itProp = props.begin();
-      itProp < props.end(); 
-      itProp++, cntProp++)
- {
-  pArgSEStrs[cntProp].resize(words.size());
-  
-  (*itProp)->getPredSEStr(pArgSEStrs[cntProp]);
-  (*itProp)->getArgsSEStrs(pArgSEStrs[cntProp], pFeatureView);
-  }
-}
-
 void Sentence::setPropArgSpanEnd(const short &pPropNo, 
                                  const short &pArgNo,
                                  const WordIdx &pEnd)
@@ -479,6 +455,22 @@ unsigned short Sentence::getSampleCount()
  return vSampleCount;
 } 
 
+/**
+ *  Returns true if all propositions of the sentence have been labeled by 
+ *  the given no of the classifier for the given feature view; such a 
+ *  sentence is not dirty and need not to be relabeled.
+ */
+bool Sentence::isLabeledBy(unsigned short pFeatureView, short pClassifierNo)
+{
+ for (vector<Proposition *>::iterator itProp = props.begin(); 
+      itProp< props.end(); 
+      itProp++)
+  if (!(*itProp)->isLabeledBy(pFeatureView, pClassifierNo))
+   return false;
+
+ return true;
+} 
+
 double Sentence::getLabelingProbability(unsigned short pFeatureView)
 {
  unsigned int cntSamples = 0;
@@ -551,12 +543,10 @@ void Sentence::setSelectedPrdLabels(unsigned short pSelectionMethod,
   } 
 }
 
-void Sentence::logPrdLabeling(unsigned short pFeatureView, ofstream &pStrm)
+void Sentence::logPrdLabeling(unsigned short pFeatureView, OGzStream &pStrm)
 {
- if(pStrm.is_open())
+ if(pStrm.isOpen())
  {
-  pStrm.seekp(pStrm.tellp(),fstream::beg);
-  
   unsigned int cntSamples = 0;
   double probSum = 0;
 
@@ -591,12 +581,10 @@ void Sentence::logPrdLabeling(unsigned short pFeatureView, ofstream &pStrm)
   }
 }
   
-void Sentence::logPrdLabelings(unsigned short pViewCount, ofstream &pStrm)
+void Sentence::logPrdLabelings(unsigned short pViewCount, OGzStream &pStrm)
 {
- if(pStrm.is_open())
+ if(pStrm.isOpen())
  {
-  pStrm.seekp(pStrm.tellp(),fstream::beg);
-  
   unsigned int cntSamples = 0;
   double probSum[pViewCount];
 
@@ -664,10 +652,12 @@ Word::Word ()
 {
  wordCnstnt = NULL;
  wordDTNode = NULL;
+ MemoryAccount::add(MEM_WORDS, 1, sizeof(Word));
 }
 
 void Word::setWordForm(string pWordForm)
 {
+ MemoryAccount::add(MEM_WORDS, 0, (long) pWordForm.size() - (long) wordForm.size());
  wordForm = pWordForm;
 } 
 
@@ -683,6 +673,7 @@ string Word::getPOS()
 
 void Word::setWordLemma(string pLemma)
 {
+ MemoryAccount::add(MEM_WORDS, 0, (long) pLemma.size() - (long) wordLemma.size());
  wordLemma = pLemma;
 } 
 
@@ -735,6 +726,11 @@ Proposition::Proposition(Sentence * const &pSentence)
  predCSpan.start = 0;
  predCSpan.end = 0;
  predCCnstnt = NULL;
+ 
+ for (unsigned short i = 0; i < FEATURE_VIEW_COUNT; i++)
+  classifierNo[i] = UNLABELED_CLASSIFIER_NO;
+
+ MemoryAccount::add(MEM_PROPOSITIONS, 1, sizeof(Proposition));
 }
 
 Sentence *Proposition::getSentence()
@@ -782,6 +778,11 @@ WordSpan Proposition::getPredSpan()
  return predSpan;
 }
 
+WordSpan Proposition::getPredCSpan()
+{
+ return predCSpan;
+}
+
 WordSpan Proposition::getPredCnstntSpan()
 {
  return predCnstnt->getWordSpan();
@@ -1176,87 +1177,81 @@ void Proposition::setArgSpanEnd(const short &pArgNo, const WordIdx &pEnd)
 }
 
 /**
- *  puts the predicate (V*) and its probable continuation (C-V*) in 
- *  start/end format in a vector
+ *  marks the predicate (V*), its probable continuation (C-V*), and the 
+ *  predicted arguments in start/end format: the kind of each element 
+ *  (SE_NONE, SE_START, SE_SINGLE or SE_END) is marked and the starting 
+ *  ones point to their label, so that the saver can write them without 
+ *  any allocation
  * 
- *  The vector is in the length of the sentence and is filled with strings 
- *  representing the starting of the predicate, predicate continuation 
- *  and predicted arguments (e.g. "(A0*") and their ending (e.g. "*)"). 
- *  Other elements are filled with "*".
+ *  The vectors are resized to the length of the sentence and reset.
  */
-void Proposition::getPredSEStr(vector<string> &pArgSEStrs)
+void Proposition::getSEMarks(vector<unsigned char> &pKinds,
+                             vector<const string *> &pLabels,
+                             unsigned short pFeatureView)
 {
- // setting predicate start/end string
+ unsigned short vLength = sentence->getLength();
+ 
+ pKinds.assign(vLength, SE_NONE);
+ pLabels.assign(vLength, (const string *) NULL);
+ 
+ // marking predicate
  if (predSpan.start == predSpan.end)
  {
-  pArgSEStrs[predSpan.start - 1] = "(V*)";
+  pKinds[predSpan.start - 1] = SE_SINGLE;
+  pLabels[predSpan.start - 1] = &PRED_SE_LABEL;
   }
  else
  {
-  pArgSEStrs[predSpan.start - 1] = "(V* ";
-  pArgSEStrs[predSpan.end - 1] = "*)";
+  pKinds[predSpan.start - 1] = SE_START;
+  pLabels[predSpan.start - 1] = &PRED_SE_LABEL;
+  pKinds[predSpan.end - 1] = SE_END;
   }
 
- // setting predicate continuation start/end string if any
+ // marking predicate continuation if any
  if (predCSpan.start != 0)
  {
   if (predCSpan.start == predCSpan.end)
   {
-   pArgSEStrs[predCSpan.start - 1] = "(C-V*)";
+   pKinds[predCSpan.start - 1] = SE_SINGLE;
+   pLabels[predCSpan.start - 1] = &PRED_C_SE_LABEL;
    }
   else
   {
-   pArgSEStrs[predCSpan.start - 1] = "(C-V* ";
-   pArgSEStrs[predCSpan.end - 1] = "*)";
+   pKinds[predCSpan.start - 1] = SE_START;
+   pLabels[predCSpan.start - 1] = &PRED_C_SE_LABEL;
+   pKinds[predCSpan.end - 1] = SE_END;
    }
   }
-}
-
-/**
- *  iterates samples of the propositions to gather the predicted arguments
- *  of each of them in start/end format, then put them in a vector
- * 
- *  The vector is in the length of the sentence and is filled with strings 
- *  representing the starting of the predicate, predicate continuation 
- *  and predicted arguments (e.g. "(A0*") and their ending (e.g. "*)"). 
- *  Other elements are filled with "*".
- */
-void Proposition::getArgsSEStrs(vector<string> &pArgSEStrs, unsigned short pFeatureView)
-{
+ 
+ // marking predicted arguments
  for (vector<Sample *>::iterator itSample = samples.begin(); 
       itSample < samples.end(); 
       itSample++)
  {
   if (!(*itSample)->isPrdArgument(pFeatureView))
    continue;
-   
-  /////////////////////////////////////////////////////////////////////
-  // this is for temporarily treating overlaping arguments which happens 
-  // in two cases and causes error when using CoNLL srl-eval:
-  // 1st when no global constraint is applied on labeled predictions
-  // 2nd when the wrong predictions causes conflic between label and 
-  // compound verb predicate boundary
-  if ((pArgSEStrs[(*itSample)->getWordSpan().start - 1] != "") ||
-      (pArgSEStrs[(*itSample)->getWordSpan().end - 1] != ""))
-   continue;  
-  ///////////////////////////////////////////////////////////////////// 
-   
-  // if the argument span is only one word write start and end together,
-  // otherwise, write start to the element according to argument's span 
-  // start and end according to its span end
-  if ((*itSample)->getWordSpan().start == 
-      (*itSample)->getWordSpan().end)
+  
+  WordSpan vSpan = (*itSample)->getWordSpan();
+  
+  // skipping overlapping arguments, which happens in two cases and causes
+  // error when using CoNLL srl-eval: 1st when no global constraint is 
+  // applied on labeled predictions, 2nd when the wrong predictions causes
+  // conflict between label and compound verb predicate boundary
+  if ((pKinds[vSpan.start - 1] != SE_NONE) || (pKinds[vSpan.end - 1] != SE_NONE))
+   continue;
+  
+  const string *vLabel = &ArgLabelRegistry::getLabel((*itSample)->getPrdArgLabelId(pFeatureView));
+  
+  if (vSpan.start == vSpan.end)
   {
-   pArgSEStrs[(*itSample)->getWordSpan().start - 1] = "("+
-                                                      (*itSample)->getPrdArgLabel(pFeatureView) +
-                                                      "*)";
+   pKinds[vSpan.start - 1] = SE_SINGLE;
+   pLabels[vSpan.start - 1] = vLabel;
    }
   else
   {
-   pArgSEStrs[(*itSample)->getWordSpan().start - 1] = "(" + 
-                                                      (*itSample)->getPrdArgLabel(pFeatureView) + 
-                                                      "* ";
-   pArgSEStrs[(*itSample)->getWordSpan().end - 1] = "*)";
+   pKinds[vSpan.start - 1] = SE_START;
+   pLabels[vSpan.start - 1] = vLabel;
+   pKinds[vSpan.end - 1] = SE_END;
    }
   }
 }
@@ -1624,6 +1619,11 @@ void Proposition::checkForXPMissedArgs(TestSampleGenerator * const &pSG,
 void Proposition::addSample(Sample * const &pSample)
 {
  samples.push_back(pSample);
+ 
+ // the new sample has not been labeled yet, so the proposition should be 
+ // relabeled by the next classify() call of any view
+ for (unsigned short i = 0; i < FEATURE_VIEW_COUNT; i++)
+  classifierNo[i] = UNLABELED_CLASSIFIER_NO;
 }
 
 void Proposition::getSamples(vector<Sample *> &pSamples)
@@ -1635,3 +1635,104 @@ unsigned short Proposition::getSampleCount()
 {
  return samples.size();
 } 
+
+/**
+ *  Returns true if all samples of the proposition have been labeled by 
+ *  the given no of the classifier for the given feature view, so that
+ *  re-evaluating them by the same model can be skipped.
+ */
+bool Proposition::isLabeledBy(unsigned short pFeatureView, short pClassifierNo)
+{
+ if (classifierNo[pFeatureView - 1] != pClassifierNo)
+  return false;
+ 
+ for (vector<Sample *>::iterator itSample = samples.begin(); 
+      itSample < samples.end(); 
+      itSample++)
+  if (!(*itSample)->isLabeledBy(pFeatureView, pClassifierNo))
+   return false;
+ 
+ return true;
+}
+
+void Proposition::setClassifierNo(unsigned short pFeatureView, short pClassifierNo)
+{
+ classifierNo[pFeatureView - 1] = pClassifierNo;
+}
+
+bool Proposition::getCachedFeature(unsigned short pFeatureType, string &pValue)
+{
+ map<unsigned short, string>::iterator itFeature = featureCache.find(pFeatureType);
+ if (itFeature == featureCache.end())
+  return false;
+  
+ pValue = itFeature->second;
+ return true;
+}
+
+void Proposition::cacheFeature(unsigned short pFeatureType, const string &pValue)
+{
+ featureCache[pFeatureType] = pValue;
+}
+
+/**
+ *  Decodes the predicted labels of the proposition for the given view 
+ *  after all its samples are labeled, so that the result does not depend
+ *  on the labeling order:
+ * 
+ *  The argument candidates (non-NULL) are sorted by probability and 
+ *  greedily accepted unless they repeat an already accepted core argument 
+ *  label (constraint 1) or overlap an already accepted argument span 
+ *  (constraint 2), in which case their label is set to NULL.
+ * 
+ *  Accepted spans are kept disjoint in a map from start to end, so the 
+ *  overlap check is a single lookup and the whole decoding is O(k log k).
+ */
+void Proposition::resolveConstraints(unsigned short pFeatureView)
+{
+ vector<Sample *> vCandidates;
+ for (vector<Sample *>::iterator itSample = samples.begin(); 
+      itSample < samples.end(); 
+      itSample++)
+  if (ArgLabelRegistry::isArgument((*itSample)->getPrdArgLabelId(pFeatureView)))
+   vCandidates.push_back(*itSample);
+ 
+ if (vCandidates.size() < 2)
+  return;
+ 
+ // stable sorting keeps the earlier sample first on equal probabilities
+ unsigned short vActiveFeatureView = gvActiveFeatureView;
+ gvActiveFeatureView = pFeatureView;
+ stable_sort(vCandidates.begin(), vCandidates.end(), isMoreLikelyLabel);
+ gvActiveFeatureView = vActiveFeatureView;
+ 
+ set<ArgLabelId> vCoreLabels;
+ map<WordIdx, WordIdx> vSpans;
+ 
+ for (vector<Sample *>::iterator itSample = vCandidates.begin(); 
+      itSample < vCandidates.end(); 
+      itSample++)
+ {
+  // applying constraint 1:
+  if ((*itSample)->isPrdCoreArg(pFeatureView) &&
+      (vCoreLabels.count((*itSample)->getPrdArgLabelId(pFeatureView)) > 0))
+  {
+   (*itSample)->nullifyPrdArgLabel(pFeatureView);
+   continue;
+   }
+  
+  // applying constraint 2: the accepted span starting last before the end
+  // of this span is the only one which may overlap it
+  WordSpan vSpan = (*itSample)->getWordSpan();
+  map<WordIdx, WordIdx>::iterator itSpan = vSpans.upper_bound(vSpan.end);
+  if ((itSpan != vSpans.begin()) && ((--itSpan)->second >= vSpan.start))
+  {
+   (*itSample)->nullifyPrdArgLabel(pFeatureView);
+   continue;
+   }
+  
+  vSpans[vSpan.start] = vSpan.end;
+  if ((*itSample)->isPrdCoreArg(pFeatureView))
+   vCoreLabels.insert((*itSample)->getPrdArgLabelId(pFeatureView));
+  }
+}
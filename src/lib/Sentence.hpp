@@ -22,13 +22,16 @@
 
 #include <vector>
 #include <string>
+#include <map>
 
 #include "Types.hpp"
+#include "Constants.hpp"
 
 using namespace std;
 
 
 class DataAnalysis;
+class OGzStream;
 class LabeledSampleGenerator;
 class UnlabeledSampleGenerator;
 class TestSampleGenerator;
@@ -75,13 +78,15 @@ class Sentence
   
   void setTBTree(TBTree * const &);
   TBTree *getTBTree();
+  // precomputes head words, content words, subcat, and governing category
+  // of all constituents of the tree
+  void precomputeTBTree();
   void displayTree();
   
   void appendProp(const unsigned short &);
   void getProps(vector<Proposition *> &);
   short getPropCount();
   void setPropPredWord(const short &, const WordIdx &);
-  void getPredTemplate(vector<string> &);
   void setPropPredSpanStart(const short &, const WordIdx &); 
   void setPropPredSpanEnd(const short &, const WordIdx &); 
   void setPropPredCSpanStart(const short &, const WordIdx &); 
@@ -92,7 +97,6 @@ class Sentence
   void estimatePropPredBoundaries();
   void addPropArgument(const short &, const WordIdx &, const string &); 
   short getPropArgCount(const short &);
-  void getPropsArgsSEStrs(vector< vector<string> > &, unsigned short);
   void setPropArgSpanEnd(const short &, const short &, const WordIdx &);
   void findPropArgsInSpan(vector<Argument *> &, WordSpan &);
   void assignToPropPred(const short &, Constituent const &);
@@ -113,6 +117,9 @@ class Sentence
                           unsigned short, unsigned short [],
                           ofstream &);
   unsigned short getSampleCount();
+  // checks whether all propositions of the sentence have been labeled by
+  // the given no of the classifier for the given feature view
+  bool isLabeledBy(unsigned short, short);
   
   double getLabelingProbability(unsigned short);
   double getLabelingAgreement();
@@ -120,8 +127,8 @@ class Sentence
   // selection criterion selected by user
   void setSelectedPrdLabels(unsigned short, unsigned short);
   // logs predicated labeling of samples into a file
-  void logPrdLabeling(unsigned short, ofstream &);
-  void logPrdLabelings(unsigned short, ofstream &);
+  void logPrdLabeling(unsigned short, OGzStream &);
+  void logPrdLabelings(unsigned short, OGzStream &);
 };
 
 
@@ -189,6 +196,16 @@ class Proposition
   // vector<DArgument *> dArgs;
   
   vector<Sample *> samples;    //samples generated for the proposition
+  
+  // no of the classifier which has labeled all samples of the proposition
+  // for each feature view (UNLABELED_CLASSIFIER_NO if not labeled or if 
+  // samples are added later); used to skip relabeling propositions with an
+  // unchanged classifier
+  short classifierNo[FEATURE_VIEW_COUNT];
+  
+  // values of the proposition-scope features (see PROP_SCOPE_FEATURES),
+  // extracted by the first sample and shared by the others and all views 
+  map<unsigned short, string> featureCache;
  
  public:
  
@@ -205,6 +222,7 @@ class Proposition
   void setPredCSpanEnd(const WordIdx &); 
   void setPredLemma(const string &);
   WordSpan getPredSpan();
+  WordSpan getPredCSpan();
   WordSpan getPredCnstntSpan();
   short getPredLength();
   string getPredLemma();
@@ -228,8 +246,7 @@ class Proposition
   void addArgument(const WordIdx &, const string &); 
   short getArgCount();
   void setArgSpanEnd(const short &, const WordIdx &);
-  void getPredSEStr(vector<string> &);
-  void getArgsSEStrs(vector<string> &, unsigned short);
+  void getSEMarks(vector<unsigned char> &, vector<const string *> &, unsigned short);
   Argument* findArgInSpan(WordSpan &);
   Argument* findArgMatch(Constituent &);
   void displayArgs();
@@ -261,6 +278,12 @@ class Proposition
   void addSample(Sample * const &);
   void getSamples(vector<Sample *> &);
   unsigned short getSampleCount();
+  bool isLabeledBy(unsigned short, short);
+  void setClassifierNo(unsigned short, short);
+  bool getCachedFeature(unsigned short, string &);
+  void cacheFeature(unsigned short, const string &);
+  // enforces global SRL constraints on predicted labels of all samples
+  void resolveConstraints(unsigned short);
 };
 
 #endif /* SENTENCE_HPP */
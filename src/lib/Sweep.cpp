@@ -0,0 +1,187 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to Sweep.hpp)
+ *
+ */
+
+#include <iostream>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "Sweep.hpp"
+#include "Utils.hpp"
+
+
+short loadSweepConfigs(const string &pConfigFile, 
+                       vector<SweepConfig> &pConfigs)
+{
+ ifstream strmConfigs (pConfigFile.c_str());
+ if (!strmConfigs)
+ {
+  cerr << "Can't open file: " << pConfigFile << endl;
+  return -1;
+  }
+ 
+ string vLine;
+ vector<string> vcTokens;
+ 
+ while (!strmConfigs.eof())
+ {
+  getline(strmConfigs, vLine);
+  
+  // treating # as comment sign
+  if (!vLine.empty() && (vLine[0] == '#'))
+   continue; 
+  
+  vcTokens.clear();
+  tokenize(vLine, vcTokens, " \t\r");
+  if (vcTokens.empty())
+   continue;
+  
+  if (vcTokens.size() % 2 == 0)
+  {
+   cerr << "Parameters of sweep configuration " << vcTokens[0] 
+        << " are not in pairs!" << endl;
+   return -1;
+   }
+  
+  SweepConfig vConfig;
+  vConfig.label = vcTokens[0];
+  for (unsigned short i = 1; i < vcTokens.size(); i += 2)
+  {
+   vector<string> vcParam;
+   vcParam.push_back(vcTokens[i]);
+   vcParam.push_back(vcTokens[i + 1]);
+   vConfig.params.push_back(vcParam);
+   }
+  
+  pConfigs.push_back(vConfig);
+  }
+ 
+ return 0;
+}
+
+
+SweepRunner::SweepRunner(unsigned short pMaxWorkers, 
+                         unsigned long pMemoryBudget)
+{
+ maxWorkers = pMaxWorkers;
+ memoryBudget = pMemoryBudget;
+ failedCount = 0;
+}
+
+unsigned short SweepRunner::getFailedCount()
+{
+ return failedCount;
+}
+
+/**
+ *  the number of workers allowed by the cores and the memory budget
+ */
+unsigned short SweepRunner::getWorkerCount()
+{
+ long vWorkerCount = maxWorkers;
+ if (vWorkerCount == 0)
+  vWorkerCount = sysconf(_SC_NPROCESSORS_ONLN);
+ 
+ if (memoryBudget > 0)
+ {
+  // the resident memory of the parent, rather than its virtual size, which
+  // overstates what a worker can come to use
+  unsigned long vMemUsage = getRSS() / (1024 * 1024);
+  if ((vMemUsage > 0) && ((long) (memoryBudget / vMemUsage) < vWorkerCount))
+   vWorkerCount = memoryBudget / vMemUsage;
+  }
+ 
+ if (vWorkerCount < 1)
+  vWorkerCount = 1;
+ 
+ return vWorkerCount;
+}
+
+/**
+ *  Forks a worker per configuration, running at most the allowed number of
+ *  them at the same time. 
+ *
+ *  The output streams are flushed before forking, so that the buffered 
+ *  output is not written again by the workers. The standard output of the
+ *  workers is discarded, since their progress would be interleaved; each 
+ *  worker writes its own log.
+ */
+int SweepRunner::forkWorkers(vector<SweepConfig> &pConfigs, ofstream &pLog)
+{
+ unsigned short vWorkerCount = getWorkerCount();
+ vector<pair<int, unsigned> > vRunning;
+ 
+ mout("\nSweeping " + intToStr(pConfigs.size()) + " configurations by up to " + 
+      intToStr(vWorkerCount) + " workers ...\n", cout, pLog);
+ 
+ for (unsigned i = 0; i < pConfigs.size(); i++)
+ {
+  while (vRunning.size() >= vWorkerCount)
+   waitWorker(vRunning, pConfigs, pLog);
+  
+  cout << flush;
+  pLog << flush;
+  
+  pid_t vPid = fork();
+  if (vPid == 0)
+  {
+   if (freopen("/dev/null", "w", stdout) == NULL)
+    cerr << "Discarding the output of sweep worker " << pConfigs[i].label
+         << " failed!" << endl;
+   return i;
+   }
+  
+  if (vPid < 0)
+  {
+   cerr << "Forking sweep worker " << pConfigs[i].label << " failed!" << endl;
+   failedCount++;
+   continue;
+   }
+  
+  vRunning.push_back(make_pair((int) vPid, i));
+  mout("Configuration " + pConfigs[i].label + " started (pid " + 
+       intToStr(vPid) + ")\n", cout, pLog);
+  }
+ 
+ while (!vRunning.empty())
+  waitWorker(vRunning, pConfigs, pLog);
+ 
+ return -1;
+}
+
+void SweepRunner::waitWorker(vector<pair<int, unsigned> > &pRunning,
+                             vector<SweepConfig> &pConfigs,
+                             ofstream &pLog)
+{
+ int vStatus;
+ pid_t vPid = wait(&vStatus);
+ if (vPid < 0)
+ {
+  cerr << "Waiting for sweep workers failed!" << endl;
+  failedCount += pRunning.size();
+  pRunning.clear();
+  return;
+  }
+ 
+ for (unsigned i = 0; i < pRunning.size(); i++)
+  if (pRunning[i].first == vPid)
+  {
+   const string &vLabel = pConfigs[pRunning[i].second].label;
+   if (WIFEXITED(vStatus) && (WEXITSTATUS(vStatus) == 0))
+    mout("Configuration " + vLabel + " finished\n", cout, pLog);
+   else
+   {
+    mout("Configuration " + vLabel + " failed!\n", cout, pLog);
+    failedCount++;
+    }
+   
+   pRunning.erase(pRunning.begin() + i);
+   break;
+   }
+}
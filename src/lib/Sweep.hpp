@@ -0,0 +1,65 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Parameter sweep over configurations of a bootstrapping run
+ *
+ *  The data is loaded and the samples are generated once by the parent 
+ *  process, and then a worker process is forked per configuration, so that
+ *  the workers share the loaded data copy-on-write. Each worker applies 
+ *  its configuration's parameters and continues as a single run would.
+ *
+ *  The configuration file contains a configuration per line: a label 
+ *  followed by parameter and value pairs (e.g. "p1k -p 1000 -sc 2"); lines
+ *  starting with # are comments.
+ *
+ */
+
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include <vector>
+#include <string>
+#include <fstream>
+
+using namespace std;
+
+
+struct SweepConfig
+{
+ string label;
+ // parameter and value pairs, each as a vector like the lines of the 
+ // parameter files
+ vector<vector<string> > params;
+};
+
+short loadSweepConfigs(const string &, vector<SweepConfig> &);
+
+class SweepRunner
+{
+ private:
+
+  // maximum number of workers running at the same time (0 for the number
+  // of cores)
+  unsigned short maxWorkers;
+  // memory in MB the workers may use together (0 for no limit); since a 
+  // worker may come to copy all the pages it shares with the parent, the 
+  // resident memory of the parent is counted for each worker
+  unsigned long memoryBudget;
+  unsigned short failedCount;
+
+  unsigned short getWorkerCount();
+  void waitWorker(vector<pair<int, unsigned> > &, vector<SweepConfig> &, 
+                  ofstream &);
+
+ public:
+
+  SweepRunner(unsigned short, unsigned long);
+
+  // forks the workers and returns the index of the configuration in each 
+  // worker, and -1 in the parent after all the workers have finished
+  int forkWorkers(vector<SweepConfig> &, ofstream &);
+  unsigned short getFailedCount();
+};
+
+#endif /* SWEEP_HPP */
@@ -16,6 +16,8 @@
 #include "DataAnalysis.hpp"
 #include "Utils.hpp"
 #include "Constants.hpp"
+#include "HeadRules.hpp"
+#include "MemoryAccount.hpp"
 
 
 /**
@@ -30,12 +32,18 @@ TBTree::TBTree(Sentence &pSentence,
 {
  sentence = &pSentence;
  syntTag = pSyntTag;
+ syntTagId = HeadRules::getTagId(pSyntTag);
  parent = NULL;
  headChild = NULL;
  contentChild = NULL;
  depArgWord = NULL;
+ precomputed = false;
+ headWordCnstnt = NULL;
+ contentWordCnstnt = NULL;
+ govCatNode = NULL;
  wordSpan.start = pFirstWord;
  wordSpan.end = 0;
+ MemoryAccount::add(MEM_TREE_NODES, 1, sizeof(TBTree) + pSyntTag.size());
 }
 
 TBTree::TBTree(Sentence &pSentence, TBTree &pTree, 
@@ -46,11 +54,17 @@ TBTree::TBTree(Sentence &pSentence, TBTree &pTree,
  headChild = NULL;
  contentChild = NULL;
  depArgWord = NULL;
+ precomputed = false;
+ headWordCnstnt = NULL;
+ contentWordCnstnt = NULL;
+ govCatNode = NULL;
  // setting this node as a child of parent
  parent->children.push_back(this);
  syntTag = pSyntTag;
+ syntTagId = HeadRules::getTagId(pSyntTag);
  wordSpan.start = pFirstWord;
  wordSpan.end = 0;
+ MemoryAccount::add(MEM_TREE_NODES, 1, sizeof(TBTree) + pSyntTag.size());
 }
 
 TBTree *TBTree::getParent()
@@ -222,6 +236,9 @@ string TBTree::getHeadWordLemma()
  */
 Constituent TBTree::getHeadWordCnstnt()
 {
+ if (precomputed)
+  return headWordCnstnt;
+  
  Constituent vHeadChild = getHeadChild();
  
  if (vHeadChild)
@@ -257,15 +274,16 @@ Constituent TBTree::getHeadChild()
  *  In Surdeanu et al. (2008), it first finds the first occurance of a 
  *  conjunctor child to process only from the first child to that child.
  *  But here, we observed that it very slightly (0.04 points) degraded 
- *  the overal F1 when using F1 as feature. So, it is currently disabled.
+ *  the overal F1 when using F1 as feature. So, it is not used.
  *  
  *  Note:
  *  Due to inconsistency between Surdeanu et al. (2008) and Johansson &
  *  Negues (2007), where the latter is the reference of former, we adapted
  *  to variations of this rules for NAC and WHNP. The desired one can be 
- *  called from inside this function. However, using the former set of 
+ *  selected by HeadRules::setVariant(). However, using the former set of 
  *  rules gained 0.01 points better result.
  *  
+ *  The rules themselves are tables in Constants.hpp (see HeadRules.hpp).
  */
 Constituent TBTree::setHeadChild()
 {
@@ -276,502 +294,15 @@ Constituent TBTree::setHeadChild()
   return headChild;
   }
   
- short lastChild;
-/* 
- Currently disabled!
- // If this is a coordinated phrase, convert the conjunction child ordinal
- // to vector index and set it as last child to be processed, otherwise 
- // set the last child to the leftmost child.
- if (isCoordinated(lastChild)) 
-  lastChild--;
- else 
-*/
- lastChild = children.size() - 1;
-  
+ short vHeadChild = HeadRules::findHeadChild(syntTagId, children);
  
- // rule for ADJP (Adjective Phrase)
- if (syntTag == "ADJP")
- {
-  string priority [] = {"NNS", "QP", "NN", "$", "ADVP", "JJ", "VBN", "VBG",
-                        "ADJP", "JJR", "NP", "JJS", "DT", "FW", "RBR", 
-                        "RBS", "SBAR", "RB", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for ADVP (Adverb Phrase)
- if (syntTag == "ADVP")
- {
-  string priority [] = {"RB", "RBR", "RBS", "FW", "ADVP", "TO", "CD", 
-                        "JJR", "JJ", "IN", "NP", "JJS", "NN", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-
- // rule for CONJP (Conjunction Phrase)
- if (syntTag == "CONJP")
- {
-  string priority [] = {"CC", "RB", "IN", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-
- // rule for FRAG (Fragment)
- if (syntTag == "FRAG")
- {
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag.substr(0,2) == "NN") ||
-       (children[cntChild]->syntTag == "NP"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag[0] == 'W')
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag == "SBAR")
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag == "PP") ||
-       (children[cntChild]->syntTag == "IN"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag == "ADJP") ||
-       (children[cntChild]->syntTag == "JJ"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  string priority [] = {"ADVP", "RB", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-
- // rule for INTJ (Interjection e.g. "say" in "If there is, say, 1000 of ...")
- if (syntTag == "INTJ")
- {
-  headChild = children[lastChild];
-  return headChild;
-  }
- 	
- // rule for LST (List Marker e.g. "1:" in "1: effects of parse error")
- if (syntTag == "LST")
- {
-  string priority [] = {"LS", ":", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-
- // rule for NAC (Not a Constituent), WHNP (WH NP e.g. "who") using
- // Surdeanu et al. (2008) or Johansson & Negues (2007) version
- if ((syntTag == "NAC") || (syntTag == "WHNP"))
- {
-  headChild = findCoNLLHeadOfNACWHNP(lastChild);
-  //headChild = findJNHeadOfNACWHNP(lastChild);
-  return headChild;
-  }
-
- // rule for NP, NX (Incomplete NP)
- if ((syntTag == "NP") || (syntTag == "NX"))
- {
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if ((children[cntChild]->syntTag.substr(0,2) == "NN") ||
-       (children[cntChild]->syntTag == "NX"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  // NP-e: there is no funtion tag in CoNLL version of PropBank
-  
-  string priority [] = {"JJR", "CD", "JJ", "JJS", "RB", "QP", "NP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for PP, WHPP (WH PP e.g. "of which")
- if ((syntTag == "PP") || (syntTag == "WHPP"))
- {
-  string priority [] = {"IN", "TO", "VBG", "VBN", "RP", "FW", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-
- // rule for PRN (Parenthetical)
- if (syntTag == "PRN")
- {
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag[0] == 'S')
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag[0] == 'N')
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag[0] == 'W')
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag == "PP") ||
-       (children[cntChild]->syntTag == "IN"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag == "ADJP") ||
-       (children[cntChild]->syntTag.substr(0,2) == "JJ"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if ((children[cntChild]->syntTag == "ADVP") ||
-       (children[cntChild]->syntTag.substr(0,2) == "RB"))
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  }
-  
- // rule for PRT (Particle)
- if (syntTag == "PRT")
- {
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag == "RP")
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  }
- 
- // rule for QP (Quantifier Phrase)
- if (syntTag == "QP")
- {
-  string priority [] = {"$", "IN", "NNS", "NN", "JJ", "RB", "DT", "CD",
-                        "NCD", "QP", "JJR", "JJS", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for RRC (Reduced Relative Clause)
- if (syntTag == "RRC")
- {
-  string priority [] = {"VP", "NP", "ADVP", "ADJP", "PP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for S
- if (syntTag == "S")
- {
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag == "VP")
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag.find("-PRD") != string::npos)
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  
-  string priority [] = {"S", "SBAR", "ADJP", "UCP", "NP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for SBAR
- if (syntTag == "SBAR")
- {
-  string priority [] = {"S", "SQ", "SINV", "SBAR", "FRAG", "IN", "DT", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for SBARQ (Direct WH question)
- if (syntTag == "SBARQ")
- {
-  string priority [] = {"SQ", "S", "SINV", "SBARQ", "FRAG", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for SINV (Inverted Declarative Sentence; i.e. the subject follows the tensed verb or modal)
- if (syntTag == "SINV")
- {
-  string priority1 [] = {"VBZ", "VBD", "VBP", "VB", "MD", "VP", ""};
-  for (short cntPriority = 0; !priority1[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority1[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag.find("-PRD") != string::npos)
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  
-  string priority2 [] = {"S", "SINV", "ADJP", "NP", ""};
-  for (short cntPriority = 0; !priority2[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority2[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for SQ (Inverted yes/no question)
- if (syntTag == "SQ")
- {
-  string priority1 [] = {"VBZ", "VBD", "VBP", "VB", "MD", ""};
-  for (short cntPriority = 0; !priority1[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority1[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag.find("-PRD") != string::npos)
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  
-  string priority2 [] = {"VP", "SQ", ""};
-  for (short cntPriority = 0; !priority2[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority2[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for UCP (Unlike Coordinated Phrase; e.g. "Coca-Cola and other sodas")
- if (syntTag == "UCP")
- {
-  headChild = children[0];
-  return headChild;
-  }
- 	
- // rule for VP 
- if (syntTag == "VP")
- {
-  string priority1 [] = {"VBD", "VBN", "MD", "VBZ", "VB", "VBG", "VBP", 
-                         "VP", ""};
-  for (short cntPriority = 0; !priority1[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority1[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag.find("-PRD") != string::npos)
-   {
-    headChild = children[cntChild];
-    return headChild;
-    }
-  
-  string priority2 [] = {"ADJP", "NN", "NNS", "NP", ""};
-  for (short cntPriority = 0; !priority2[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority2[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for WHADJP
- if (syntTag == "WHADJP")
- {
-  string priority [] = {"CC", "WRB", "JJ", "ADJP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for WHADVP
- if (syntTag == "WHADVP")
- {
-  string priority [] = {"CC", "WRB", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-    {
-     headChild = children[cntChild];
-     return headChild;
-     }
-  }
-  
- // rule for X (Unknown, uncertain, or unbracketable)
- if (syntTag == "X")
- {
-  headChild = children[0];
-  return headChild;
-  }
- 	
  // the first word is considered the default head if rules were not fired
- return children[0]; 	 
-}
-
-Constituent TBTree::findCoNLLHeadOfNACWHNP(short &pLastChild)
-{
- if ((syntTag == "NAC") || (syntTag == "WHNP"))
- {
-  for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-   if ((children[cntChild]->syntTag.substr(0,2) == "NN") ||
-       (children[cntChild]->syntTag == "NX"))
-    return children[cntChild];
-
-  // NP-e: there is no funtion tag in CoNLL version of PropBank
+ if (vHeadChild == -1)
+  headChild = children[0];
+ else
+  headChild = children[vHeadChild];
   
-  string priority [] = {"JJR", "CD", "JJ", "JJS", "RB", "QP", "NP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-     return children[cntChild];
-  }
-
- // the first word is considered the default head if rules were not fired
- return children[0]; 	 
-}
-
-Constituent TBTree::findJNHeadOfNACWHNP(short &pLastChild)
-{
- if (syntTag == "NAC")
- {
-  for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag.substr(0,2) == "NN")
-    return children[cntChild];
-
-  string priority [] = {"NP", "NAC", "EX", "$", "CD", "QP", "PRP", "VBG",
-                        "JJ", "JJS", "JJR", "ADJP", "FW", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-     return children[cntChild];
-  }
-
- if (syntTag == "WHNP")
- {
-  for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-   if (children[cntChild]->syntTag.substr(0,2) == "NN")
-    return children[cntChild];
-
-  string priority [] = {"WDT", "WP", "WD$", "WHADJP", "WHPP", "WHNP", ""};
-  for (short cntPriority = 0; !priority[cntPriority].empty(); cntPriority++)
-   for (short cntChild = pLastChild; cntChild >= 0; cntChild--)
-    if (children[cntChild]->syntTag == priority[cntPriority])
-     return children[cntChild];
-  }
-
- // the first word is considered the default head if rules were not fired
- return children[0]; 	 
+ return headChild;
 }
 
 string TBTree::getContentWordForm()
@@ -807,6 +338,9 @@ string TBTree::getContentWordLemma()
  */
 Constituent TBTree::getContentWord()
 {
+ if (precomputed)
+  return contentWordCnstnt;
+  
  Constituent vContentChild = getContentChild();
 
  if (vContentChild)
@@ -848,69 +382,15 @@ Constituent TBTree::setContentChild()
   return contentChild;
   }
   
- short lastChild;
- lastChild = children.size() - 1;
-  
- // H1: heuristic for PP
- if (syntTag == "PP")
- {
-  contentChild = children[lastChild];
-  return contentChild;
-  }
-  
- // H2: heuristic for SBAR
- if (syntTag == "SBAR")
- {
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag[0] == 'S')
-   {
-    contentChild = children[cntChild];
-    return contentChild;
-    }
-  }
-
- // H3: heuristic for VP
- if (syntTag == "VP")
- {
-  for (short cntChild = 0; cntChild <= lastChild; cntChild++)
-   if (children[cntChild]->syntTag == "VP")
-   {
-    contentChild = children[cntChild];
-    return contentChild;
-    }
-   
-  contentChild = getHeadChild();
-  return contentChild;
-  }
-
- // H4: heuristic for ADVP
- if (syntTag == "ADVP")
- {
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if ((children[cntChild]->syntTag != "IN") && 
-       (children[cntChild]->syntTag != "TO"))
-   {
-    contentChild = children[cntChild];
-    return contentChild;
-    }
-  }
-   
- // H5: heuristic for ADJP
- if (syntTag == "ADJP")
- {
-  for (short cntChild = lastChild; cntChild >= 0; cntChild--)
-   if ((children[cntChild]->syntTag.substr(0, 2) == "JJ") ||
-       (children[cntChild]->syntTag[0] == 'V') ||
-       (children[cntChild]->syntTag[0] == 'N') ||
-       (children[cntChild]->syntTag == "ADJP"))
-   {
-    contentChild = children[cntChild];
-    return contentChild;
-    }
-  }
-
+ short vContentChild = HeadRules::findContentChild(syntTagId, children);
+ 
  // for all other phrase types, the content word is identical to head word
- return getHeadChild();
+ if (vContentChild == -1)
+  contentChild = getHeadChild();
+ else
+  contentChild = children[vContentChild];
+  
+ return contentChild;
 }
 
 string TBTree::getSubcat()
@@ -918,6 +398,9 @@ string TBTree::getSubcat()
  if (!parent)
   return "";
   
+ if (precomputed)
+  return parent->expansion;
+  
  string vSubcat = parent->getSyntTag() + "->";
  
  for (vector<TBTree *>::iterator itChild = parent->children.begin(); 
@@ -930,6 +413,14 @@ string TBTree::getSubcat()
 
 string TBTree::getGovCat()
 {
+ if (precomputed)
+ {
+  if (govCatNode)
+   return govCatNode->syntTag;
+  else
+   return "";
+  }
+  
  TBTree *vParent = parent;
  while (vParent)
   if ((vParent->syntTag[0] == 'S') ||
@@ -941,11 +432,67 @@ string TBTree::getGovCat()
  return "";   
 }
 
+/**
+ *  The governing category and the subcategorization rule are propagated 
+ *  top-down (the parent is processed before its children), and the head 
+ *  and content words bottom-up (the head and content child of the node 
+ *  have already been processed when the head rules are run for the node),
+ *  so each node is visited once.
+ */
+void TBTree::precompute()
+{
+ if (parent)
+ {
+  if ((parent->syntTag[0] == 'S') ||
+      (parent->syntTag == "VP"))
+   govCatNode = parent;
+  else
+   govCatNode = parent->govCatNode;
+  }
+ 
+ if (!isTerminal())
+ {
+  expansion = syntTag + "->";
+  for (vector<TBTree *>::iterator itChild = children.begin(); 
+       itChild < children.end(); 
+       itChild++)
+   expansion += (*itChild)->getSyntTag() + "-";
+  expansion.erase(expansion.size() - 1);
+  }
+
+ for (vector<TBTree *>::iterator itChild = children.begin(); 
+      itChild < children.end(); 
+      itChild++)
+  (*itChild)->precompute();
+  
+ if (isTerminal())
+ {
+  headWordCnstnt = this;
+  contentWordCnstnt = this;
+  }
+ else
+ {
+  // the head and content children are children of this node, and so they
+  // are already precomputed
+  Constituent vHeadChild = getHeadChild();
+  headWordCnstnt = vHeadChild ? vHeadChild->getHeadWordCnstnt() : NULL;
+  Constituent vContentChild = getContentChild();
+  contentWordCnstnt = vContentChild ? vContentChild->getContentWord() : NULL;
+  }
+  
+ precomputed = true;
+}
+
 string TBTree::getSyntTag()
 {
  return syntTag;
 }
 
+SyntTagId TBTree::getSyntTagId()
+{
+ return syntTagId;
+}
+
 void TBTree::setLastWord(const WordIdx &pWord)
 {
  wordSpan.end = pWord;
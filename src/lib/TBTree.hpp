@@ -46,8 +46,20 @@ class TBTree
   TBTree *headChild;
   // this is set when needed for the 1st time
   TBTree *contentChild;
+  
+  // the followings are filled by precompute() in a single pass over the 
+  // tree, after which the head word, content word, subcat, and governing 
+  // category getters are lookups
+  bool precomputed;
+  TBTree *headWordCnstnt;
+  TBTree *contentWordCnstnt;
+  // the subcategorization rule expanding this node (subcat of its children)
+  string expansion;
+  // the first dominating "S" or "VP" node
+  TBTree *govCatNode;
 
   string syntTag;
+  SyntTagId syntTagId;
   // word span facilitates accessing constituent words without tracing to 
   // the leaves
   WordSpan wordSpan;
@@ -80,6 +92,7 @@ class TBTree
   short getChildOrdinal();
   short getChildrenCount();
   string getSyntTag();
+  SyntTagId getSyntTagId();
   
   WordPtr setDepArgWord();
   WordPtr getDepArgWord();
@@ -97,10 +110,6 @@ class TBTree
   // Surdeanu et al. (2008) and Johansson and Negues (2007) and returns
   // the constituent of the head word as a by-product.
   Constituent setHeadChild();
-  // finds the head child of NAC and WHNP phrase using Surdeanu et al. rules
-  Constituent findCoNLLHeadOfNACWHNP(short &);
-  // finds the head child of NAC and WHNP phrase using J&N rules
-  Constituent findJNHeadOfNACWHNP(short &);
   
   string getContentWordForm();
   string getContentWordLemma();
@@ -117,6 +126,9 @@ class TBTree
   // returns the Governing Category of the noun phrase which is its first
   // dominating "S" or "VP" node
   string getGovCat();
+  // fills the head word, content word, subcat, and governing category of
+  // this node and all its descendants; it must be called on the root
+  void precompute();
   
   void setLastWord(const WordIdx &);
   WordSpan getWordSpan();
@@ -0,0 +1,839 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  (refer to Trainer.hpp)
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <pthread.h>
+
+#include "Trainer.hpp"
+#include "ModelFile.hpp"
+#include "Constants.hpp"
+#include "Utils.hpp"
+#include "Metrics.hpp"
+#include "FeatureHasher.hpp"
+
+
+// a block of events processed by a worker thread together with its own
+// buffers for expectations and log-likelihood
+struct PMEWorker
+{
+ PMETrainer *trainer;
+ unsigned start;
+ unsigned end;
+ const vector<double> *params;
+ vector<double> expected;
+ double logLikelihood;
+};
+
+static void *runPMEWorker(void *pWorker)
+{
+ PMEWorker *vWorker = (PMEWorker *) pWorker;
+ vWorker->logLikelihood = vWorker->trainer->accumulateExpectations(
+                                     vWorker->start, vWorker->end,
+                                     *vWorker->params, vWorker->expected);
+ return NULL;
+}
+
+
+/**
+ *  shuffles the order of the events by a generator of its own, so that the
+ *  online training is reproducible and does not change the sequence of
+ *  rand() used elsewhere (e.g. in negative sampling)
+ */
+static void shuffleEvents(vector<unsigned> &pOrder, unsigned long long &pSeed)
+{
+ for (unsigned i = pOrder.size(); i > 1; i--)
+ {
+  pSeed = pSeed * 6364136223846793005ULL + 1442695040888963407ULL;
+  swap(pOrder[i - 1], pOrder[(unsigned) ((pSeed >> 33) % i)]);
+  }
+}
+
+
+PMETrainer::PMETrainer(unsigned short pThreadCount, int pVerbose)
+{
+ threadCount = (pThreadCount == 0) ? 1 : pThreadCount;
+ verbose = pVerbose;
+ gaussian = 0;
+ cpuUsage = 0;
+ elapsedTime = 0;
+}
+
+double PMETrainer::getElapsedTime()
+{
+ return elapsedTime;
+}
+
+unsigned PMETrainer::getFeatureCount()
+{
+ return features.size();
+}
+
+unsigned PMETrainer::getParamCount()
+{
+ return theta.size();
+}
+
+unsigned PMETrainer::getEventCount()
+{
+ return eventCounts.size();
+}
+
+void PMETrainer::beginAddEvent()
+{
+ featureIds.clear();
+ features.clear();
+ outcomeIds.clear();
+ outcomes.clear();
+
+ eventStarts.clear();
+ eventFeatures.clear();
+ eventOutcomes.clear();
+ eventCounts.clear();
+ eventValues.clear();
+
+ eventStarts.push_back(0);
+}
+
+void PMETrainer::addEvent(const vector<string> &pContext,
+                          const ArgLabel &pOutcome,
+                          double pCount)
+{
+ map<ArgLabel, unsigned short>::iterator itOutcome = outcomeIds.find(pOutcome);
+ if (itOutcome == outcomeIds.end())
+ {
+  itOutcome = outcomeIds.insert(make_pair(pOutcome, outcomes.size())).first;
+  outcomes.push_back(pOutcome);
+  }
+
+ string vNegated;
+ for (vector<string>::const_iterator itFeature = pContext.begin();
+      itFeature < pContext.end();
+      itFeature++)
+ {
+  // the negative feature of signed hashing is the bucket with value -1
+  const string *vFeature = &*itFeature;
+  signed char vValue = 1;
+  if (FeatureHasher::isNegative(*itFeature))
+  {
+   vNegated.assign(*itFeature, 1, string::npos);
+   vFeature = &vNegated;
+   vValue = -1;
+   }
+
+  map<string, unsigned>::iterator itId = featureIds.find(*vFeature);
+  if (itId == featureIds.end())
+  {
+   itId = featureIds.insert(make_pair(*vFeature, features.size())).first;
+   features.push_back(*vFeature);
+   }
+  eventFeatures.push_back(itId->second);
+  eventValues.push_back(vValue);
+  }
+
+ eventStarts.push_back(eventFeatures.size());
+ eventOutcomes.push_back(itOutcome->second);
+ eventCounts.push_back(pCount);
+}
+
+/**
+ *  Creates one parameter for each (feature, outcome) pair seen in the
+ *  events, and computes the observed count of each parameter
+ */
+void PMETrainer::endAddEvent()
+{
+ vector<pair<unsigned, unsigned short> > vPairs;
+ vPairs.reserve(eventFeatures.size());
+
+ for (unsigned i = 0; i < eventCounts.size(); i++)
+  for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+   vPairs.push_back(make_pair(eventFeatures[k], eventOutcomes[i]));
+
+ sort(vPairs.begin(), vPairs.end());
+ vPairs.erase(unique(vPairs.begin(), vPairs.end()), vPairs.end());
+
+ paramStarts.assign(features.size() + 1, 0);
+ paramOutcomes.clear();
+ paramOutcomes.reserve(vPairs.size());
+ for (vector<pair<unsigned, unsigned short> >::iterator itPair = vPairs.begin();
+      itPair < vPairs.end();
+      itPair++)
+ {
+  paramStarts[itPair->first + 1]++;
+  paramOutcomes.push_back(itPair->second);
+  }
+ for (unsigned i = 1; i < paramStarts.size(); i++)
+  paramStarts[i] += paramStarts[i - 1];
+
+ theta.assign(paramOutcomes.size(), 0);
+ observed.assign(paramOutcomes.size(), 0);
+ for (unsigned i = 0; i < eventCounts.size(); i++)
+  for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+   observed[findParam(eventFeatures[k], eventOutcomes[i])] += 
+                                            eventCounts[i] * eventValues[k];
+}
+
+/**
+ *  returns the index of the parameter of the given feature and outcome
+ *  (the outcomes of a feature are sorted)
+ */
+unsigned PMETrainer::findParam(unsigned pFeature, unsigned short pOutcome)
+{
+ return lower_bound(paramOutcomes.begin() + paramStarts[pFeature],
+                    paramOutcomes.begin() + paramStarts[pFeature + 1],
+                    pOutcome) - paramOutcomes.begin();
+}
+
+/**
+ *  Accumulates the model expectations of the parameters over the events
+ *  from pStart to pEnd (exclusive) into pExpected, and returns the
+ *  log-likelihood of those events
+ */
+double PMETrainer::accumulateExpectations(unsigned pStart,
+                                          unsigned pEnd,
+                                          const vector<double> &pParams,
+                                          vector<double> &pExpected)
+{
+ const unsigned short vOutcomeCount = outcomes.size();
+ vector<double> vScores (vOutcomeCount);
+ double vLogLikelihood = 0;
+
+ for (unsigned i = pStart; i < pEnd; i++)
+ {
+  for (unsigned short o = 0; o < vOutcomeCount; o++)
+   vScores[o] = 0;
+
+  for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+  {
+   const unsigned vFeature = eventFeatures[k];
+   for (unsigned j = paramStarts[vFeature]; j < paramStarts[vFeature + 1]; j++)
+    vScores[paramOutcomes[j]] += pParams[j] * eventValues[k];
+   }
+
+  double vMax = vScores[0];
+  for (unsigned short o = 1; o < vOutcomeCount; o++)
+   if (vScores[o] > vMax)
+    vMax = vScores[o];
+
+  const double vOutcomeScore = vScores[eventOutcomes[i]];
+  double vSum = 0;
+  for (unsigned short o = 0; o < vOutcomeCount; o++)
+  {
+   vScores[o] = exp(vScores[o] - vMax);
+   vSum += vScores[o];
+   }
+
+  vLogLikelihood += eventCounts[i] * (vOutcomeScore - vMax - log(vSum));
+
+  const double vNorm = eventCounts[i] / vSum;
+  for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+  {
+   const unsigned vFeature = eventFeatures[k];
+   const double vValueNorm = vNorm * eventValues[k];
+   for (unsigned j = paramStarts[vFeature]; j < paramStarts[vFeature + 1]; j++)
+    pExpected[j] += vScores[paramOutcomes[j]] * vValueNorm;
+   }
+  }
+
+ return vLogLikelihood;
+}
+
+/**
+ *  Computes the model expectations of all parameters in parallel and
+ *  returns the log-likelihood of the events.
+ *
+ *  The events are divided into threadCount contiguous blocks; the first
+ *  block is processed by the calling thread. The partial results are
+ *  summed in the order of the blocks to keep the reduction deterministic.
+ */
+double PMETrainer::computeExpectations(const vector<double> &pParams,
+                                       vector<double> &pExpected)
+{
+ const unsigned vEventCount = eventCounts.size();
+ vector<PMEWorker> vWorkers (threadCount);
+ vector<pthread_t> vThreads (threadCount);
+
+ for (unsigned short t = 0; t < threadCount; t++)
+ {
+  vWorkers[t].trainer = this;
+  vWorkers[t].start = (unsigned) ((unsigned long long) vEventCount * t / threadCount);
+  vWorkers[t].end = (unsigned) ((unsigned long long) vEventCount * (t + 1) / threadCount);
+  vWorkers[t].params = &pParams;
+  vWorkers[t].expected.assign(pParams.size(), 0);
+  vWorkers[t].logLikelihood = 0;
+  }
+
+ for (unsigned short t = 1; t < threadCount; t++)
+  if (pthread_create(&vThreads[t], NULL, runPMEWorker, &vWorkers[t]) != 0)
+  {
+   cerr << "Creating training thread failed!" << endl;
+   exit(EXIT_FAILURE);
+   }
+
+ runPMEWorker(&vWorkers[0]);
+
+ for (unsigned short t = 1; t < threadCount; t++)
+  pthread_join(vThreads[t], NULL);
+
+ double vLogLikelihood = 0;
+ pExpected.assign(pParams.size(), 0);
+ for (unsigned short t = 0; t < threadCount; t++)
+ {
+  const vector<double> &vExpected = vWorkers[t].expected;
+  for (unsigned j = 0; j < pExpected.size(); j++)
+   pExpected[j] += vExpected[j];
+  vLogLikelihood += vWorkers[t].logLikelihood;
+  }
+
+ return vLogLikelihood;
+}
+
+/**
+ *  Computes the gradient of the negative log-likelihood (plus the Gaussian
+ *  prior penalty if set) for the given parameters, and returns the value of
+ *  the objective function
+ */
+double PMETrainer::computeGradient(const vector<double> &pParams,
+                                   vector<double> &pGradient)
+{
+ double vLoss = -computeExpectations(pParams, pGradient);
+
+ for (unsigned j = 0; j < pGradient.size(); j++)
+  pGradient[j] -= observed[j];
+
+ if (gaussian > 0)
+  for (unsigned j = 0; j < pGradient.size(); j++)
+  {
+   vLoss += pParams[j] * pParams[j] / (2 * gaussian);
+   pGradient[j] += pParams[j] / gaussian;
+   }
+
+ return vLoss;
+}
+
+/**
+ *  Limited-memory BFGS with backtracking line search (Armijo condition)
+ */
+void PMETrainer::trainLBFGS(size_t pIterations)
+{
+ const unsigned vParamCount = theta.size();
+ const unsigned short vHistorySize = PME_LBFGS_HISTORY;
+
+ vector<double> vGradient (vParamCount);
+ vector<double> vNewTheta (vParamCount);
+ vector<double> vNewGradient (vParamCount);
+ vector<double> vDirection (vParamCount);
+
+ // correction pairs kept in a circular buffer; vHead is the next slot
+ vector< vector<double> > vS (vHistorySize, vector<double>(vParamCount));
+ vector< vector<double> > vY (vHistorySize, vector<double>(vParamCount));
+ vector<double> vRho (vHistorySize);
+ vector<double> vAlpha (vHistorySize);
+ unsigned short vHead = 0, vHistory = 0;
+
+ double vLoss = computeGradient(theta, vGradient);
+
+ for (size_t cntIter = 1; cntIter <= pIterations; cntIter++)
+ {
+  // two-loop recursion to compute the search direction
+  vDirection = vGradient;
+  for (unsigned short i = 0; i < vHistory; i++)
+  {
+   unsigned short h = (vHead + vHistorySize - 1 - i) % vHistorySize;
+   double vDot = 0;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDot += vS[h][j] * vDirection[j];
+   vAlpha[h] = vRho[h] * vDot;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDirection[j] -= vAlpha[h] * vY[h][j];
+   }
+
+  if (vHistory > 0)
+  {
+   unsigned short h = (vHead + vHistorySize - 1) % vHistorySize;
+   double vYY = 0;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vYY += vY[h][j] * vY[h][j];
+   const double vGamma = 1 / (vRho[h] * vYY);
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDirection[j] *= vGamma;
+   }
+
+  for (unsigned short i = vHistory; i > 0; i--)
+  {
+   unsigned short h = (vHead + vHistorySize - i) % vHistorySize;
+   double vDot = 0;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDot += vY[h][j] * vDirection[j];
+   const double vBeta = vRho[h] * vDot;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDirection[j] += vS[h][j] * (vAlpha[h] - vBeta);
+   }
+
+  double vGD = 0, vGG = 0;
+  for (unsigned j = 0; j < vParamCount; j++)
+  {
+   vDirection[j] = -vDirection[j];
+   vGD += vGradient[j] * vDirection[j];
+   vGG += vGradient[j] * vGradient[j];
+   }
+
+  if (vGG == 0)
+   break;
+
+  // not a descent direction: restart from steepest descent
+  if (vGD >= 0)
+  {
+   vHistory = 0;
+   for (unsigned j = 0; j < vParamCount; j++)
+    vDirection[j] = -vGradient[j];
+   vGD = -vGG;
+   }
+
+  // backtracking line search
+  double vStep = (vHistory == 0) ? 1 / sqrt(vGG) : 1;
+  double vNewLoss = 0;
+  bool vAccepted = false;
+  for (unsigned short cntTry = 0; cntTry < 20; cntTry++)
+  {
+   for (unsigned j = 0; j < vParamCount; j++)
+    vNewTheta[j] = theta[j] + vStep * vDirection[j];
+   vNewLoss = computeGradient(vNewTheta, vNewGradient);
+   if (vNewLoss <= vLoss + 1E-04 * vStep * vGD)
+   {
+    vAccepted = true;
+    break;
+    }
+   vStep *= 0.5;
+   }
+
+  if (!vAccepted)
+   break;
+
+  double vSY = 0;
+  for (unsigned j = 0; j < vParamCount; j++)
+  {
+   vS[vHead][j] = vNewTheta[j] - theta[j];
+   vY[vHead][j] = vNewGradient[j] - vGradient[j];
+   vSY += vS[vHead][j] * vY[vHead][j];
+   }
+  if (vSY > 1E-10)
+  {
+   vRho[vHead] = 1 / vSY;
+   vHead = (vHead + 1) % vHistorySize;
+   if (vHistory < vHistorySize)
+    vHistory++;
+   }
+
+  const double vChange = fabs(vLoss - vNewLoss) / max(1.0, fabs(vNewLoss));
+
+  theta.swap(vNewTheta);
+  vGradient.swap(vNewGradient);
+  vLoss = vNewLoss;
+
+  if (verbose)
+   cout << "\r" << cntIter << " iterations (loss: " << vLoss << ")          "
+        << flush;
+
+  if (vChange < PME_CONVERGENCE_EPSILON)
+   break;
+  }
+
+ if (verbose)
+  cout << endl;
+}
+
+/**
+ *  Generalized Iterative Scaling; when a Gaussian prior is set, the update
+ *  of each parameter is found by Newton's method.
+ */
+void PMETrainer::trainGIS(size_t pIterations)
+{
+ const unsigned vParamCount = theta.size();
+
+ // the correction constant is the maximum number of active features of
+ // an event
+ unsigned vCorrection = 0;
+ for (unsigned i = 0; i < eventCounts.size(); i++)
+  if (eventStarts[i + 1] - eventStarts[i] > vCorrection)
+   vCorrection = eventStarts[i + 1] - eventStarts[i];
+
+ if (vCorrection == 0)
+  return;
+
+ vector<double> vExpected (vParamCount);
+ double vPrevLogLikelihood = 0;
+
+ for (size_t cntIter = 1; cntIter <= pIterations; cntIter++)
+ {
+  double vLogLikelihood = computeExpectations(theta, vExpected);
+
+  for (unsigned j = 0; j < vParamCount; j++)
+  {
+   if (gaussian > 0)
+   {
+    double vDelta = 0;
+    for (unsigned short cntNewton = 0; cntNewton < 50; cntNewton++)
+    {
+     const double vExp = vExpected[j] * exp(vCorrection * vDelta);
+     const double vF = vExp + (theta[j] + vDelta) / gaussian - observed[j];
+     const double vDF = vCorrection * vExp + 1 / gaussian;
+     const double vStep = vF / vDF;
+     vDelta -= vStep;
+     if (fabs(vStep) < 1E-10)
+      break;
+     }
+    theta[j] += vDelta;
+    }
+   else if (vExpected[j] > 0)
+    theta[j] += log(observed[j] / vExpected[j]) / vCorrection;
+   }
+
+  if (verbose)
+   cout << "\r" << cntIter << " iterations (log-likelihood: "
+        << vLogLikelihood << ")          " << flush;
+
+  if ((cntIter > 1) &&
+      (fabs(vLogLikelihood - vPrevLogLikelihood) /
+       max(1.0, fabs(vLogLikelihood)) < PME_CONVERGENCE_EPSILON))
+   break;
+
+  vPrevLogLikelihood = vLogLikelihood;
+  }
+
+ if (verbose)
+  cout << endl;
+}
+
+/**
+ *  computes the scores of all outcomes for event i by the current parameters
+ */
+void PMETrainer::scoreEvent(unsigned i, vector<double> &pScores)
+{
+ pScores.assign(outcomes.size(), 0);
+
+ for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+ {
+  const unsigned vFeature = eventFeatures[k];
+  for (unsigned j = paramStarts[vFeature]; j < paramStarts[vFeature + 1]; j++)
+   pScores[paramOutcomes[j]] += theta[j] * eventValues[k];
+  }
+}
+
+/**
+ *  Stochastic gradient descent of the negative log-likelihood, one event at
+ *  a time in a shuffled order in each pass. The step of each parameter is
+ *  the learning rate divided by the root of its accumulated squared 
+ *  gradients (AdaGrad), which copes with the different scales of the 
+ *  weighted events and the rare features. The Gaussian prior is applied to
+ *  the updated parameters in proportion to the weight of the event.
+ */
+void PMETrainer::trainSGD(size_t pPasses)
+{
+ const unsigned short vOutcomeCount = outcomes.size();
+ const unsigned vEventCount = eventCounts.size();
+
+ vector<double> vScores (vOutcomeCount);
+ vector<double> vSquares (theta.size(), 0);
+ vector<unsigned> vOrder (vEventCount);
+ double vTotalCount = 0;
+ for (unsigned i = 0; i < vEventCount; i++)
+ {
+  vOrder[i] = i;
+  vTotalCount += eventCounts[i];
+  }
+
+ unsigned long long vSeed = PME_SHUFFLE_SEED;
+ double vPrevLogLikelihood = 0;
+
+ for (size_t cntPass = 1; cntPass <= pPasses; cntPass++)
+ {
+  shuffleEvents(vOrder, vSeed);
+
+  double vLogLikelihood = 0;
+  for (vector<unsigned>::iterator itEvent = vOrder.begin();
+       itEvent < vOrder.end();
+       itEvent++)
+  {
+   const unsigned i = *itEvent;
+   scoreEvent(i, vScores);
+
+   double vMax = vScores[0];
+   for (unsigned short o = 1; o < vOutcomeCount; o++)
+    if (vScores[o] > vMax)
+     vMax = vScores[o];
+
+   const double vOutcomeScore = vScores[eventOutcomes[i]];
+   double vSum = 0;
+   for (unsigned short o = 0; o < vOutcomeCount; o++)
+   {
+    vScores[o] = exp(vScores[o] - vMax);
+    vSum += vScores[o];
+    }
+
+   vLogLikelihood += eventCounts[i] * (vOutcomeScore - vMax - log(vSum));
+
+   const double vNorm = eventCounts[i] / vSum;
+   const double vDecay = (gaussian > 0) ? 
+                         eventCounts[i] / (gaussian * vTotalCount) : 0;
+   for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+   {
+    const unsigned vFeature = eventFeatures[k];
+    for (unsigned j = paramStarts[vFeature]; j < paramStarts[vFeature + 1]; j++)
+    {
+     double vGradient = vScores[paramOutcomes[j]] * vNorm;
+     if (paramOutcomes[j] == eventOutcomes[i])
+      vGradient -= eventCounts[i];
+     vGradient = vGradient * eventValues[k] + theta[j] * vDecay;
+
+     vSquares[j] += vGradient * vGradient;
+     if (vSquares[j] > 0)
+      theta[j] -= PME_SGD_LEARNING_RATE * vGradient / sqrt(vSquares[j]);
+     }
+    }
+   }
+
+  if (verbose)
+   cout << "\r" << cntPass << " passes (log-likelihood: "
+        << vLogLikelihood << ")          " << flush;
+
+  if ((cntPass > 1) &&
+      (fabs(vLogLikelihood - vPrevLogLikelihood) /
+       max(1.0, fabs(vLogLikelihood)) < PME_CONVERGENCE_EPSILON))
+   break;
+
+  vPrevLogLikelihood = vLogLikelihood;
+  }
+
+ if (verbose)
+  cout << endl;
+}
+
+/**
+ *  Multiclass averaged perceptron: for each misclassified event, the 
+ *  parameters of its features are increased for its outcome and decreased
+ *  for the predicted one by the weight of the event (times the value of
+ *  the feature). The parameters are 
+ *  finally replaced by their average over all the steps, which is computed
+ *  from the sum of the updates weighted by their step (vTotals) instead of
+ *  summing all the parameters at each step.
+ */
+void PMETrainer::trainPerceptron(size_t pPasses)
+{
+ const unsigned short vOutcomeCount = outcomes.size();
+ const unsigned vEventCount = eventCounts.size();
+
+ vector<double> vScores (vOutcomeCount);
+ vector<double> vTotals (theta.size(), 0);
+ vector<unsigned> vOrder (vEventCount);
+ for (unsigned i = 0; i < vEventCount; i++)
+  vOrder[i] = i;
+
+ unsigned long long vSeed = PME_SHUFFLE_SEED;
+ double vStep = 1;
+
+ for (size_t cntPass = 1; cntPass <= pPasses; cntPass++)
+ {
+  shuffleEvents(vOrder, vSeed);
+
+  unsigned cntErrors = 0;
+  for (vector<unsigned>::iterator itEvent = vOrder.begin();
+       itEvent < vOrder.end();
+       itEvent++, vStep++)
+  {
+   const unsigned i = *itEvent;
+   scoreEvent(i, vScores);
+
+   unsigned short vPredicted = 0;
+   for (unsigned short o = 1; o < vOutcomeCount; o++)
+    if (vScores[o] > vScores[vPredicted])
+     vPredicted = o;
+
+   if (vPredicted == eventOutcomes[i])
+    continue;
+
+   cntErrors++;
+   for (unsigned k = eventStarts[i]; k < eventStarts[i + 1]; k++)
+   {
+    const unsigned vFeature = eventFeatures[k];
+    for (unsigned j = paramStarts[vFeature]; j < paramStarts[vFeature + 1]; j++)
+    {
+     double vUpdate = 0;
+     if (paramOutcomes[j] == eventOutcomes[i])
+      vUpdate = eventCounts[i];
+     else if (paramOutcomes[j] == vPredicted)
+      vUpdate = -eventCounts[i];
+     else
+      continue;
+
+     vUpdate *= eventValues[k];
+     theta[j] += vUpdate;
+     vTotals[j] += vStep * vUpdate;
+     }
+    }
+   }
+
+  if (verbose)
+   cout << "\r" << cntPass << " passes (" << cntErrors << " errors)          "
+        << flush;
+
+  if (cntErrors == 0)
+   break;
+  }
+
+ for (unsigned j = 0; j < theta.size(); j++)
+  theta[j] -= vTotals[j] / vStep;
+
+ if (verbose)
+  cout << endl;
+}
+
+/**
+ *  The parameters of the pairs not in the model, and the pairs of the 
+ *  model not seen in the events, are left as they are. Returns 0 on 
+ *  success and -1 if the model can't be read.
+ */
+short PMETrainer::loadWeights(const string &pModelFile)
+{
+ MEModelFile oModel;
+ if (oModel.read(pModelFile) != 0)
+  return -1;
+
+ // the ids of the outcomes of the model in this trainer (-1 if not seen in
+ // the events)
+ vector<int> vOutcomeIds (oModel.outcomes.size(), -1);
+ for (unsigned i = 0; i < oModel.outcomes.size(); i++)
+ {
+  map<ArgLabel, unsigned short>::iterator itId = outcomeIds.find(oModel.outcomes[i]);
+  if (itId != outcomeIds.end())
+   vOutcomeIds[i] = itId->second;
+  }
+
+ for (unsigned i = 0; i < oModel.features.size(); i++)
+ {
+  map<string, unsigned>::iterator itId = featureIds.find(oModel.features[i]);
+  if (itId == featureIds.end())
+   continue;
+
+  unsigned vFeature = itId->second;
+  for (unsigned j = oModel.paramStarts[i]; j < oModel.paramStarts[i + 1]; j++)
+  {
+   int vOutcome = vOutcomeIds[oModel.paramOutcomes[j]];
+   if (vOutcome < 0)
+    continue;
+
+   unsigned k = findParam(vFeature, vOutcome);
+   if ((k < paramStarts[vFeature + 1]) && (paramOutcomes[k] == vOutcome))
+    theta[k] = oModel.weights[j];
+   }
+  }
+
+ return 0;
+}
+
+bool PMETrainer::isOnlineMethod(const string &pMethod)
+{
+ return (pMethod == "sgd") || (pMethod == "perceptron");
+}
+
+/**
+ *  returns 0 on success and -1 if the method is unknown or there is no
+ *  event to train with
+ */
+short PMETrainer::train(size_t pIterations,
+                        const string &pMethod,
+                        double pGaussian)
+{
+ Timer oTimer;
+ PhaseGuard oPhase("estimate");
+
+ oTimer.start();
+
+ if (eventCounts.empty() || theta.empty())
+ {
+  cerr << "No training event has been added!" << endl;
+  return -1;
+  }
+
+ gaussian = pGaussian;
+
+ if (verbose)
+  cout << endl << eventCounts.size() << " events, " << features.size()
+       << " features, " << theta.size() << " parameters, "
+       << threadCount << " threads" << endl;
+
+ if (pMethod == "lbfgs")
+  trainLBFGS(pIterations);
+ else if (pMethod == "gis")
+  trainGIS(pIterations);
+ else if (pMethod == "sgd")
+  trainSGD(pIterations);
+ else if (pMethod == "perceptron")
+  trainPerceptron(pIterations);
+ else
+ {
+  cerr << "Unknown ME parameter estimation method: " << pMethod << endl;
+  return -1;
+  }
+
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
+
+ return 0;
+}
+
+/**
+ *  Saves the model in the text format of MaxentModel::save() (see
+ *  ModelFile.hpp)
+ */
+short PMETrainer::save(const string &pModelFile)
+{
+ ofstream strmModel (pModelFile.c_str());
+ if (!strmModel)
+ {
+  cerr << "Can't create model file: " << pModelFile << endl;
+  return -1;
+  }
+
+ strmModel << "#txt,maxent" << endl;
+
+ strmModel << features.size() << endl;
+ for (vector<string>::iterator itFeature = features.begin();
+      itFeature < features.end();
+      itFeature++)
+  strmModel << *itFeature << endl;
+
+ strmModel << outcomes.size() << endl;
+ for (vector<ArgLabel>::iterator itOutcome = outcomes.begin();
+      itOutcome < outcomes.end();
+      itOutcome++)
+  strmModel << *itOutcome << endl;
+
+ for (unsigned i = 0; i < features.size(); i++)
+ {
+  strmModel << paramStarts[i + 1] - paramStarts[i] << ' ';
+  for (unsigned j = paramStarts[i]; j < paramStarts[i + 1]; j++)
+   strmModel << paramOutcomes[j] << ' ';
+  strmModel << endl;
+  }
+
+ strmModel << theta.size() << endl;
+ strmModel.precision(20);
+ for (vector<double>::iterator itTheta = theta.begin();
+      itTheta < theta.end();
+      itTheta++)
+  strmModel << *itTheta << endl;
+
+ strmModel.close();
+
+ return 0;
+}
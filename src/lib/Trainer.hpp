@@ -0,0 +1,117 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  Built-in multi-threaded maximum entropy trainer (parallel ME trainer)
+ *  used as an alternative backend to Zhang Le's MaxentModel::train()
+ *
+ *  The training events are partitioned into contiguous blocks, one per
+ *  thread; each thread computes the model expectations and log-likelihood
+ *  of its block into its own buffer, and the buffers are then reduced in
+ *  the order of the threads, so that the result does not depend on the
+ *  thread scheduling.
+ *
+ *  Besides the batch methods (L-BFGS and GIS), the trainer provides two
+ *  online methods for fast bootstrapping iterations, which make a few
+ *  passes over the shuffled events in a single thread: SGD of the same
+ *  log-linear (ME) model with AdaGrad step sizes, and the multiclass
+ *  averaged perceptron. Both produce the weights of a log-linear model, so
+ *  the labels are still given normalized (softmax) probabilities. They can
+ *  be started from the weights of a previously trained model, so that
+ *  retraining with newly selected samples only updates the model.
+ *
+ *  The trained model is saved in the text format of MaxentModel::save() to
+ *  be loaded back by MaxentModel::load() (and ZMEScorer::load()).
+ *
+ */
+
+#ifndef TRAINER_HPP
+#define TRAINER_HPP
+
+#include <vector>
+#include <string>
+#include <map>
+#include <fstream>
+
+#include "Types.hpp"
+
+using namespace std;
+
+
+class PMETrainer
+{
+ private:
+
+  // interned features (predicates) and outcomes
+  map<string, unsigned> featureIds;
+  vector<string> features;
+  map<ArgLabel, unsigned short> outcomeIds;
+  vector<ArgLabel> outcomes;
+
+  // events stored in CSR form: the features of event i are
+  // eventFeatures[eventStarts[i]] ... eventFeatures[eventStarts[i + 1] - 1]
+  vector<unsigned> eventStarts;
+  vector<unsigned> eventFeatures;
+  vector<unsigned short> eventOutcomes;
+  vector<double> eventCounts;
+  // the value of each feature of the events: 1, or -1 for the negative
+  // features of signed hashing (see FeatureHasher.hpp)
+  vector<signed char> eventValues;
+
+  // parameters in CSR form: the parameters of feature i are for outcomes
+  // paramOutcomes[paramStarts[i]] ... paramOutcomes[paramStarts[i + 1] - 1];
+  // there is one parameter per (feature, outcome) pair seen in training
+  vector<unsigned> paramStarts;
+  vector<unsigned short> paramOutcomes;
+  vector<double> theta;
+  vector<double> observed;
+
+  unsigned short threadCount;
+  int verbose;
+  double gaussian;
+
+  double cpuUsage;
+  double elapsedTime;
+
+  unsigned findParam(unsigned, unsigned short);
+  double computeExpectations(const vector<double> &, vector<double> &);
+  double computeGradient(const vector<double> &, vector<double> &);
+  void trainLBFGS(size_t);
+  void trainGIS(size_t);
+  void scoreEvent(unsigned, vector<double> &);
+  void trainSGD(size_t);
+  void trainPerceptron(size_t);
+
+ public:
+
+  PMETrainer(unsigned short, int);
+
+  double getElapsedTime();
+  unsigned getFeatureCount();
+  unsigned getParamCount();
+  unsigned getEventCount();
+
+  void beginAddEvent();
+  void addEvent(const vector<string> &, const ArgLabel &, double);
+  void endAddEvent();
+
+  // initializes the parameters by the weights of the same (feature, 
+  // outcome) pairs in the given saved model (called after endAddEvent())
+  short loadWeights(const string &);
+  
+  // trains with the given number of iterations (passes for the online 
+  // methods), method (lbfgs, gis, sgd or perceptron) and Gaussian prior 
+  // variance (0 for no prior)
+  short train(size_t, const string &, double);
+  short save(const string &);
+
+  // returns true for the methods which are only provided by this trainer
+  static bool isOnlineMethod(const string &);
+
+  // called by the worker threads to accumulate the expectations of a block
+  // of events for the given parameters
+  double accumulateExpectations(unsigned, unsigned, const vector<double> &,
+                                vector<double> &);
+};
+
+#endif /* TRAINER_HPP */
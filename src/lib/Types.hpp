@@ -51,6 +51,11 @@ typedef DTree* DTNode;
 // because of importance, ArgLabel is defined to increase representativeness;
 // it may be later converted to an enumeration!
 typedef std::string ArgLabel;
+// integer id of an ArgLabel registered in ArgLabelRegistry (see ArgLabels.hpp)
+typedef unsigned short ArgLabelId;
+
+// integer id of a syntactic tag registered in HeadRules (see HeadRules.hpp)
+typedef unsigned short SyntTagId;
 
 
 #endif /* TYPES_HPP */
@@ -13,12 +13,15 @@
 #include <iostream>
 #include <cstdlib>
 #include <fstream>
-#include <time.h>
 
 #include "Constants.hpp"
 #include "ULoader.hpp"
+#include "CoNLLReader.hpp"
+#include "ChunkLoading.hpp"
 #include "Sentence.hpp"
 #include "Utils.hpp"
+#include "Metrics.hpp"
+#include "Logging.hpp"
 #include "TBTree.hpp"
 #include "DTree.hpp"
 #include "DataAnalysis.hpp"
@@ -27,6 +30,9 @@
 using namespace std;
 
 
+// data and syntDep files
+#define U_FILE_COUNT 2
+
 ULoader::ULoader(string &pDataFile, string &pSyntDepFile, int pMaxSentences)
 {
  dataFile = pDataFile;
@@ -38,6 +44,11 @@ ULoader::ULoader(string &pDataFile, string &pSyntDepFile, int pMaxSentences)
  loadedCnstntCount = 0;
  loadedPredsCount = 0;
  
+ precomputeTBTrees = false;
+ threadCount = 1;
+ displayProgress = true;
+ skippedLines = 0;
+ 
  cpuUsage = 0;
  elapsedTime = 0;
 }
@@ -47,6 +58,16 @@ double ULoader::getElapsedTime()
  return elapsedTime;
 }
 
+void ULoader::setTBTreePrecomputation(bool pPrecompute)
+{
+ precomputeTBTrees = pPrecompute;
+}
+
+void ULoader::setThreadCount(unsigned short pThreadCount)
+{
+ threadCount = (pThreadCount == 0) ? 1 : pThreadCount;
+}
+
 
 /**
  *  @ 22.01.2010
@@ -60,34 +81,137 @@ double ULoader::getElapsedTime()
  *  maxSentences attribute of the class, unless it is set to 0 in which 
  *  case all sentences will be loaded.
  * 
+ *  If more than one thread is set, the sentences are loaded in parallel
+ *  (see loadDataParallel()).
+ * 
  */
 int ULoader::loadData(vector<Sentence *> & pSentences)
 {
- string tmpLine, tmpDep;
- vector<string> tmpvcTokens, tmpvcDep;
- int cntLine = 0;
- int cntSentence = 0;
- bool tmpIsPredicate = false;
- clock_t vStartClk, vEndClk;
- time_t vStartTime, vEndTime;
+ Timer oTimer;
+ PhaseGuard oPhase("load");
+ int vResult;
  
- vStartClk = clock();
- time(&vStartTime);
-  
- ifstream strmData (dataFile.c_str());
- if(! strmData)
+ oTimer.start();
+ 
+ if (threadCount > 1)
+  vResult = loadDataParallel(pSentences);
+ else
  {
-  cerr << "Can't open file: " << dataFile << endl;
-  return -1;
+  CoNLLReader vReaders[U_FILE_COUNT];
+  if (openFiles(vReaders) != 0)
+   return -1;
+  
+  vResult = loadSentences(vReaders, pSentences);
   }
+ 
+ lemmaCache.clear();
+ MetricsRecorder::addCount("sentences", pSentences.size());
+ 
+ oTimer.stop();
+ cpuUsage = oTimer.getCPUTime();
+ elapsedTime = oTimer.getElapsedTime();
+ 
+ return vResult;
+}
 
- ifstream strmSyntDep (syntDepFile.c_str());
- if(! strmSyntDep)
- {
-  cerr << "Can't open file: " << syntDepFile << endl;
+/**
+ *  loads the sentences in sentence-aligned chunks, one per thread, each by
+ *  a separate loader (see ChunkLoading.hpp)
+ */
+int ULoader::loadDataParallel(vector<Sentence *> & pSentences)
+{
+ CoNLLReader vReaders[U_FILE_COUNT];
+ if (openFiles(vReaders) != 0)
   return -1;
-  }
+ 
+ int vResult = loadChunksParallel(*this, vReaders, U_FILE_COUNT, 
+                                  maxSentences, threadCount, pSentences);
+ 
+ if (displayProgress && (vResult == 0))
+  cout << "\r" << loadedSentencesCount << " sentences loaded" << flush;
+ 
+ return vResult;
+}
+
+ULoader *ULoader::createChunkLoader(int pSentenceCount, int pSkippedLines)
+{
+ ULoader *vLoader = new ULoader (dataFile, syntDepFile, pSentenceCount);
+ vLoader->setTBTreePrecomputation(precomputeTBTrees);
+ vLoader->displayProgress = false;
+ vLoader->skippedLines = pSkippedLines;
+ 
+ return vLoader;
+}
+
+void ULoader::mergeChunkLoader(ULoader &pLoader)
+{
+ loadedSentencesCount += pLoader.loadedSentencesCount;
+ loadedWordsCount += pLoader.loadedWordsCount;
+ loadedCnstntCount += pLoader.loadedCnstntCount;
+ loadedPredsCount += pLoader.loadedPredsCount;
+}
+
+/**
+ *  loads the chunk of sentences starting at the given offsets of the files
+ *  (called by the worker threads)
+ */
+int ULoader::loadChunk(const size_t pStarts[], vector<Sentence *> &pSentences)
+{
+ CoNLLReader vReaders[U_FILE_COUNT];
+ if (openFiles(vReaders) != 0)
+  return -1;
+ 
+ for (unsigned short f = 0; f < U_FILE_COUNT; f++)
+  vReaders[f].seek(pStarts[f]);
+ 
+ return loadSentences(vReaders, pSentences);
+}
+
+/**
+ *  returns the lemma of the word from the cache of the loader, extracting
+ *  it (see extractLemma()) only for a new pair of word form and POS; each
+ *  loading thread has its own loader, so the cache needs no lock
+ */
+const string &ULoader::getLemma(const string &pWordForm, const string &pPOS)
+{
+ pair<string, string> vKey (pWordForm, pPOS);
+ map<pair<string, string>, string>::iterator itLemma = lemmaCache.find(vKey);
+ if (itLemma == lemmaCache.end())
+  itLemma = lemmaCache.insert(make_pair(vKey, 
+                                        extractLemma(pWordForm, pPOS))).first;
+ 
+ return itLemma->second;
+}
+
+short ULoader::openFiles(CoNLLReader pReaders[])
+{
+ const string *vFiles[U_FILE_COUNT] = {&dataFile, &syntDepFile};
+ 
+ for (unsigned short f = 0; f < U_FILE_COUNT; f++)
+  if (pReaders[f].open(*vFiles[f]) != 0)
+  {
+   cerr << "Can't open file: " << *vFiles[f] << endl;
+   return -1;
+   }
+ 
+ return 0;
+}
 
+/**
+ *  reads the sentences from the opened files (data and syntDep in this 
+ *  order) up to maxSentences
+ */
+int ULoader::loadSentences(CoNLLReader pReaders[], 
+                           vector<Sentence *> & pSentences)
+{
+ StrRef tmpLine, tmpDep;
+ vector<StrRef> tmpvcTokens, tmpvcDep;
+ int cntLine = 0;
+ int cntSentence = 0;
+ bool tmpIsPredicate = false;
+ CoNLLReader &strmData = pReaders[0];
+ CoNLLReader &strmSyntDep = pReaders[1];
+ 
  // looping to read sentences
  while (!strmData.eof())
  {
@@ -96,8 +220,8 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
    break;
   
   // reading the 1st line (in CoNLL format) of a sentence from files
-  getline(strmData, tmpLine);
-  getline(strmSyntDep, tmpDep);
+  strmData.readLine(tmpLine);
+  strmSyntDep.readLine(tmpDep);
   
   // If the 1st line of a sentence is empty, there is a blank line at the
   // begining of the sentence, which is not allowed, or it is the last line
@@ -122,13 +246,14 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
    Word * tmpWord = new Word ();
    
    // loading word form and lemma
-   tmpWord->setWordForm(trim(tmpvcTokens[0]));
-   tmpWord->setWordLemma(extractLemma(tmpWord->getWordForm(), tmpvcTokens[1]));
+   tmpWord->setWordForm(trim(tmpvcTokens[0]).str());
+   tmpWord->setWordLemma(getLemma(tmpWord->getWordForm(), 
+                                   tmpvcTokens[1].str()));
    
    // currently, we consider all words with the POS tag starting with "VB"
    // as predicate except auxiliary verbs (including "be" verbs) wrongly 
    // tagged with "VB"
-   tmpIsPredicate = isVerbPredicate(tmpvcTokens[0], tmpvcTokens[1]);
+   tmpIsPredicate = isVerbPredicate(tmpvcTokens[0].str(), tmpvcTokens[1].str());
    
    if (tmpIsPredicate)
    {
@@ -149,11 +274,11 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
    tmpvcDep.clear();
    tokenize(tmpDep, tmpvcDep, " \t\n\r");
    tmpHeadIdxs.push_back(strToInt(tmpvcDep[0]));
-   appendToDTree(*(pSentences.back()), tmpWord, tmpvcDep[1]);
+   appendToDTree(*(pSentences.back()), tmpWord, tmpvcDep[1].str());
    
    // reading the next lines (in CoNLL format) of a sentence from files
-   getline(strmData, tmpLine);
-   getline(strmSyntDep, tmpDep);
+   strmData.readLine(tmpLine);
+   strmSyntDep.readLine(tmpDep);
    cntLine++;
    }
   
@@ -167,7 +292,7 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
   if ((isEmptyLine(tmpLine)) && (!isEmptyLine(tmpDep)))
   {
    cerr << "\nThere is a mismatch between data file and dependency  file in line "
-        << cntLine << endl;
+        << skippedLines + cntLine << endl;
    return -1;
    }
   
@@ -175,9 +300,13 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
   //  to after completing the reading if it
   pSentences.back()->setDTreeHeads(tmpHeadIdxs);
   
+  if (precomputeTBTrees)
+   pSentences.back()->precomputeTBTree();
+  
   cntSentence++;
   
-  cout << "\r" << cntSentence << " sentences loaded" << flush;
+  if (displayProgress && Progress::isDue())
+   cout << "\r" << cntSentence << " sentences loaded" << flush;
   
 /*cout << endl;
   cout << cntSentence << "- ";
@@ -190,13 +319,11 @@ int ULoader::loadData(vector<Sentence *> & pSentences)
   
  }
  
- vEndClk = clock();
- cpuUsage = ((double) (vEndClk - vStartClk)) / CLOCKS_PER_SEC;
- time(&vEndTime);
- elapsedTime = difftime(vEndTime, vStartTime);
-
- loadedSentencesCount = cntSentence;
- loadedWordsCount = cntLine - cntSentence;
+ if (displayProgress)
+  cout << "\r" << cntSentence << " sentences loaded" << flush;
+ 
+ loadedSentencesCount += cntSentence;
+ loadedWordsCount += cntLine - cntSentence;
  
  return 0;
 };
@@ -234,8 +361,8 @@ void ULoader::appendToProps(Sentence &pCurrSentence,
  *  as its class member.
  */
 void ULoader::appendToTBTree(Sentence &pCurrSentence,
-                             const string &pPOS, 
-                             const string &pTagStr, 
+                             const StrRef &pPOS, 
+                             const StrRef &pTagStr, 
                              const WordIdx pWord,
                              const bool &pIsPredicate)
 {
@@ -245,7 +372,7 @@ void ULoader::appendToTBTree(Sentence &pCurrSentence,
  if (pWord == 1)
   tmpTBStack.clear();
  
- for (unsigned int i = 0; i < pTagStr.size(); i++)
+ for (unsigned int i = 0; i < pTagStr.size; i++)
   if (pTagStr[i] == '(')
   {
    if (!tmpTag.empty())
@@ -307,7 +434,7 @@ void ULoader::appendToTBTree(Sentence &pCurrSentence,
     // with firstWord = lastWord but not pushed back to stack, since 
     // it will not be needed to be assigned as parent for some others.
     TBTree *tbTreeNode = new TBTree (pCurrSentence, *tmpTBStack.back(), 
-                                     pPOS, pWord);
+                                     pPOS.str(), pWord);
     
     loadedCnstntCount++;
     tbTreeNode->setLastWord(pWord);
@@ -324,7 +451,7 @@ void ULoader::appendToTBTree(Sentence &pCurrSentence,
    tmpTBStack.pop_back();
    }
   else
-   tmpTag.append(pTagStr.substr(i,1)); 
+   tmpTag += pTagStr[i]; 
 };
 
 
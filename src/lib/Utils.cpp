@@ -12,6 +12,8 @@
 #include <stdlib.h>
 #include <dirent.h>
 #include <algorithm>
+#include <pthread.h>
+#include <unistd.h>
 
 #include "wn.h"
 
@@ -22,6 +24,11 @@
 // This is declared (extern) in Constants.hpp. For commnets see there.
 unsigned short gvActiveFeatureView = 1;
 
+// WordNet keeps its results in static buffers, so it is called under this 
+// lock when sentences are loaded by several threads (the loaders cache the
+// lemmas, so it is only taken for the words new to a loader)
+static pthread_mutex_t wordNetLock = PTHREAD_MUTEX_INITIALIZER;
+
 
 /**
  *  @Adapted from Swirl -> CharUtils -> simpleTokenize()
@@ -54,7 +61,8 @@ void tokenize(const string &pInput,
  */
 string extractLemma(const string &pWord, const string &pPOS)
 {
- char *vWord, * vLemma;
+ char *vWord, * vLemma = NULL;
+ string vResult;
  vWord = const_cast<char *> (pWord.c_str());
  
  // conveting to WordNet POS tags; if no matching POS, returns the word itself
@@ -71,10 +79,14 @@ string extractLemma(const string &pWord, const string &pPOS)
  else
   return pWord;
   
+ pthread_mutex_lock(&wordNetLock);
  if (wninit() == 0)
   vLemma = morphstr(vWord, vWNPOS);
  else 
   cerr << "\nError in initializing WordNet" << endl;
+ if (vLemma)
+  vResult = vLemma;
+ pthread_mutex_unlock(&wordNetLock);
   
  if (!vLemma)
  {
@@ -84,7 +96,7 @@ string extractLemma(const string &pWord, const string &pPOS)
    return vWord;
   }
  
- return vLemma; 
+ return vResult; 
 }
  
 
@@ -531,6 +543,12 @@ bool isAgreedLabel(Sample* p1st, Sample* p2nd)
          p2nd->isPrdArgLabelsAgreed());
 }
 
+bool isMoreLikelyOutcome(const pair<ArgLabel, double> &p1st, 
+                         const pair<ArgLabel, double> &p2nd)
+{
+ return (p1st.second > p2nd.second);
+}
+
 
 /**
  *  returns the relation of the first passed word span of elements (e.g. words)
@@ -609,6 +627,19 @@ string getFeatureName(const short &pFeatureType)
 */  
 }
 
+/**
+ *  returns the dependency scope of the feature type (SAMPLE_SCOPE or 
+ *  PROP_SCOPE) as declared in PROP_SCOPE_FEATURES
+ */
+unsigned short getFeatureScope(const unsigned short &pFeatureType)
+{
+ for (unsigned short i = 0; PROP_SCOPE_FEATURES[i] != E_O_F; i++)
+  if (PROP_SCOPE_FEATURES[i] == pFeatureType)
+   return PROP_SCOPE;
+
+ return SAMPLE_SCOPE;
+}
+
 /**
  *  @ Adapted from http://stackoverflow.com/questions/669438/
  *                      how-to-get-memory-usage-at-run-time-in-c
@@ -636,3 +667,17 @@ unsigned long int getMemUsage()
 
  return vMemSize;
 }
+
+/**
+ *  returns the resident set size of the process in Bytes, read from the 
+ *  second field of /proc/self/statm (in pages); on failure, returns 0
+ */ 
+unsigned long int getRSS()
+{
+ ifstream strmStatm("/proc/self/statm",ios_base::in);
+
+ unsigned long vSize = 0, vResident = 0;
+ strmStatm >> vSize >> vResident;
+
+ return vResident * sysconf(_SC_PAGESIZE);
+}
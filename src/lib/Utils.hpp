@@ -60,11 +60,15 @@ bool isMoreLikelyLabeling(Sentence*, Sentence*);
 bool isMoreAgreedLabeling(Sentence*, Sentence*);
 bool isMoreLikelyLabel(Sample*, Sample*);
 bool isAgreedLabel(Sample*, Sample*);
+bool isMoreLikelyOutcome(const pair<ArgLabel, double> &, 
+                         const pair<ArgLabel, double> &);
 
 int getSpansRelation(const WordSpan &, const WordSpan &);
 
 string getFeatureName(const short &);
+unsigned short getFeatureScope(const unsigned short &);
 
 unsigned long int getMemUsage();
+unsigned long int getRSS();
 
 #endif /* UTILS_HPP */
@@ -13,6 +13,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "CoNLLReader.hpp"
 
 using namespace std;
 
@@ -89,11 +90,10 @@ int main(int argc, char ** argv)
 short Convert(const string &pSourceFile,
               const string &pDestFile)
 {
- ifstream strmSrc;
+ CoNLLReader strmSrc;
  if (!pSourceFile.empty())
  {
-  strmSrc.open(pSourceFile.c_str());
-  if(!strmSrc)
+  if (strmSrc.open(pSourceFile) != 0)
   {
    cerr << "Can't open file: " << pSourceFile << endl;
    return -1;
@@ -107,15 +107,15 @@ short Convert(const string &pSourceFile,
   return -1;
   }
  
- string vSrcLine;
- vector<string> vcTokens;
+ StrRef vSrcLine;
+ vector<StrRef> vcTokens;
  size_t cntSntncs = 0;
  size_t cntWords = 0;
  
  // looping to read lines
  while (!strmSrc.eof())
  {
-  getline(strmSrc, vSrcLine);
+  strmSrc.readLine(vSrcLine);
 
   vcTokens.clear();
   tokenize(vSrcLine, vcTokens, " \t\n\r");
@@ -21,6 +21,7 @@
 #include <algorithm>
 
 #include "Utils.hpp"
+#include "GzStream.hpp"
 
 using namespace std;
 
@@ -153,8 +154,9 @@ int main(int argc, char ** argv)
  
 
  // creating output file
+ string tmpScoreFile = stripCompressedSuffix(vScoreFiles[0]);
  string vOutputFile = vOutputDir + "/" + 
-                      vScoreFiles[0].substr(0, vScoreFiles[0].find_last_of('.')) +
+                      tmpScoreFile.substr(0, tmpScoreFile.find_last_of('.')) +
                       ".all";
  ofstream strmOutput (vOutputFile.c_str());
  if(!strmOutput)
@@ -190,7 +192,8 @@ void collectFiles(vector<string> &pFiles, string &pSourceDir, string &pPrefix)
    
    if (tmpPOS != string::npos)
    {
-    string vExt = tmpFileName.substr(tmpPOS + pPrefix.size());
+    // compressed score files are collected too
+    string vExt = stripCompressedSuffix(tmpFileName.substr(tmpPOS + pPrefix.size()));
     
     size_t tmpPoint = vExt.find('.');
     
@@ -205,7 +208,7 @@ void collectFiles(vector<string> &pFiles, string &pSourceDir, string &pPrefix)
 
 void collectParameters(string &pLogFile, Parameter &pParams)
 {
- ifstream strmFile (pLogFile.c_str());
+ IGzStream strmFile (pLogFile);
      
  if(!strmFile)
  {
@@ -372,7 +375,7 @@ void collectScores(string &pSourceDir,vector<string> &pScoreFiles,
       itFile++)
  {
   string tmpScoreFile = pSourceDir + "/" + (*itFile).c_str();
-  ifstream strmFile (tmpScoreFile.c_str());
+  IGzStream strmFile (tmpScoreFile);
      
   if(!strmFile)
   {
@@ -394,7 +397,8 @@ void collectScores(string &pSourceDir,vector<string> &pScoreFiles,
     tokenize(vLine, tmpTokens, " \t\n\r");
     
     Scores *tmpScores = new Scores;
-    tmpScores->size = strToInt((*itFile).substr((*itFile).find_last_of('.') + 1));
+    string tmpFileName = stripCompressedSuffix(*itFile);
+    tmpScores->size = strToInt(tmpFileName.substr(tmpFileName.find_last_of('.') + 1));
     tmpScores->precision = tmpTokens[4];
     tmpScores->recall = tmpTokens[5];
     tmpScores->f1 = tmpTokens[6];
@@ -20,6 +20,7 @@
 #include <algorithm>
 
 #include "Utils.hpp"
+#include "GzStream.hpp"
 
 using namespace std;
 
@@ -224,8 +225,9 @@ int main(int argc, char ** argv)
  
 
  // creating output file
+ string tmpScoreFile = stripCompressedSuffix(vScoreFiles[0]);
  string vOutputFile = vOutputDir + "/" + 
-                      vScoreFiles[0].substr(0, vScoreFiles[0].find_last_of('.')) +
+                      tmpScoreFile.substr(0, tmpScoreFile.find_last_of('.')) +
                       ".all";
  ofstream strmOutput (vOutputFile.c_str());
  if(!strmOutput)
@@ -261,7 +263,8 @@ void collectFiles(vector<string> &pFiles, string &pSourceDir, string &pPrefix)
    
    if (tmpPOS != string::npos)
    {
-    string vExt = tmpFileName.substr(tmpPOS + pPrefix.size());
+    // compressed score files are collected too
+    string vExt = stripCompressedSuffix(tmpFileName.substr(tmpPOS + pPrefix.size()));
     
     size_t tmpPoint = vExt.find('.');
     
@@ -288,7 +291,7 @@ void collectParameters(string &pLogFile, Parameter &pParams)
  
  cout << "\nProcessing parameters..." << endl;
  
- ifstream strmParams (pLogFile.c_str());
+ IGzStream strmParams (pLogFile);
      
  if(!strmParams)
  {
@@ -485,7 +488,7 @@ void collectParameters(string &pLogFile, Parameter &pParams)
  */
 void collectSTDataUsage(string &pLogFile, vector<DataUsage *> &pcDataUsage)
 {
- ifstream strmFile (pLogFile.c_str());
+ IGzStream strmFile (pLogFile);
 
  if(!strmFile)
  {
@@ -577,7 +580,7 @@ void collectSTDataUsage(string &pLogFile, vector<DataUsage *> &pcDataUsage)
 void collectCTDataUsage(string &pLogFile, vector<DataUsage *> &pcDataUsage,
                         short pFeatureView)
 {
- ifstream strmFile (pLogFile.c_str());
+ IGzStream strmFile (pLogFile);
 
  if(!strmFile)
  {
@@ -725,7 +728,7 @@ void collectScores(string &pSourceDir,vector<string> &pScoreFiles,
       itFile++)
  {
   string tmpScoreFile = pSourceDir + "/" + (*itFile).c_str();
-  ifstream strmFile (tmpScoreFile.c_str());
+  IGzStream strmFile (tmpScoreFile);
      
   if(!strmFile)
   {
@@ -747,7 +750,8 @@ void collectScores(string &pSourceDir,vector<string> &pScoreFiles,
     tokenize(vLine, tmpTokens, " \t\n\r");
     
     Scores *tmpScores = new Scores;
-    tmpScores->it = strToInt((*itFile).substr((*itFile).find_last_of('.') + 1));
+    string tmpFileName = stripCompressedSuffix(*itFile);
+    tmpScores->it = strToInt(tmpFileName.substr(tmpFileName.find_last_of('.') + 1));
     tmpScores->precision = tmpTokens[4];
     tmpScores->recall = tmpTokens[5];
     tmpScores->f1 = tmpTokens[6];
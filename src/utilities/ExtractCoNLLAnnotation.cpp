@@ -14,6 +14,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "CoNLLReader.hpp"
 
 using namespace std;
 
@@ -150,11 +151,10 @@ short ExtractCols(const string &pSourceFile,
                   unsigned short pColSpace,
                   const string &pDestFile)
 {
- ifstream strmSrc;
+ CoNLLReader strmSrc;
  if (!pSourceFile.empty())
  {
-  strmSrc.open(pSourceFile.c_str());
-  if(!strmSrc)
+  if (strmSrc.open(pSourceFile) != 0)
   {
    cerr << "Can't open file: " << pSourceFile << endl;
    return -1;
@@ -168,14 +168,14 @@ short ExtractCols(const string &pSourceFile,
   return -1;
   }
  
- string vSrcLine;
- vector<string> vcTokens;
+ StrRef vSrcLine;
+ vector<StrRef> vcTokens;
  size_t cntSntncs = 0;
  
  // looping to read lines
  while (!strmSrc.eof())
  {
-  getline(strmSrc, vSrcLine);
+  strmSrc.readLine(vSrcLine);
 
   vcTokens.clear();
   tokenize(vSrcLine, vcTokens, " \t\n\r");
@@ -211,11 +211,10 @@ short ExtractRows(const string &pSourceFile,
                   bool pBlankLine,
                   const string &pDestFile)
 {
- ifstream strmSrc;
+ CoNLLReader strmSrc;
  if (!pSourceFile.empty())
  {
-  strmSrc.open(pSourceFile.c_str());
-  if(!strmSrc)
+  if (strmSrc.open(pSourceFile) != 0)
   {
    cerr << "Can't open file: " << pSourceFile << endl;
    return -1;
@@ -229,13 +228,13 @@ short ExtractRows(const string &pSourceFile,
   return -1;
   }
  
- string vSrcLine;
+ StrRef vSrcLine;
  size_t cntSntncs = 0;
  
  // looping to read lines
  while (!strmSrc.eof())
  {
-  getline(strmSrc, vSrcLine);
+  strmSrc.readLine(vSrcLine);
 
   // if this is a sentence separator line, put an empty line in the output
   if (vSrcLine.empty())
@@ -246,8 +245,8 @@ short ExtractRows(const string &pSourceFile,
    cout << "\r" << cntSntncs << " sentences processed" << flush;
    }
   else
-   if (vSrcLine[0] == pRow) 
-    strmDest << vSrcLine.substr(4)
+   if ((vSrcLine[0] == pRow) && (vSrcLine.size >= 4)) 
+    strmDest << StrRef(vSrcLine.data + 4, vSrcLine.size - 4)
              << endl;
   
   }
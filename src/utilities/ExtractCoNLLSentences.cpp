@@ -14,6 +14,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "CoNLLReader.hpp"
 
 using namespace std;
 
@@ -200,25 +201,24 @@ size_t LoadSentences(vector<string> &pSrcFiles,
                      unsigned int pMinLength,
                      unsigned int pMaxLength)
 {
- vector<ifstream *> strmSources;
+ vector<CoNLLReader *> strmSources;
  
  for (unsigned short i = 0; i < pSrcFiles.size(); i++)
  {
-  ifstream *tmpStrm = new ifstream;
-  tmpStrm->open(pSrcFiles[i].c_str());
+  CoNLLReader *tmpStrm = new CoNLLReader;
   strmSources.push_back(tmpStrm);
 
   // one annotation vector per file
   pAnnotations.resize(pAnnotations.size() + 1);
   
-  if(!strmSources[i])
+  if (tmpStrm->open(pSrcFiles[i]) != 0)
   {
    cerr << "Can't open file: " << pSrcFiles[i] << endl;
    return 0;
    }
   }
 
- vector<string> vcSrcLines(strmSources.size(), "");
+ vector<StrRef> vcSrcLines(strmSources.size());
 
  size_t cntLine = 0;
  size_t cntSentence = 0;
@@ -230,11 +230,7 @@ size_t LoadSentences(vector<string> &pSrcFiles,
  {
   // reading the 1st line (in CoNLL format) of a sentence from files
   for (unsigned short i = 0; i < strmSources.size(); i++)
-  {
-   string tmpLine;
-   getline(*strmSources[i], tmpLine);
-   vcSrcLines[i] = tmpLine;
-   }
+   strmSources[i]->readLine(vcSrcLines[i]);
   
   // If the 1st line of a sentence is empty, there is a blank line at the
   // begining of the sentence, which is not allowed, or it is the last line
@@ -253,15 +249,11 @@ size_t LoadSentences(vector<string> &pSrcFiles,
   while (!isEmptyLine(vcSrcLines[0]))
   { 
    for (unsigned short i = 0; i < pAnnotations.size(); i++)
-    pAnnotations[i][pAnnotations[i].size() - 1].push_back(vcSrcLines[i]);
+    pAnnotations[i][pAnnotations[i].size() - 1].push_back(vcSrcLines[i].str());
 
    // reading the next lines (in CoNLL format) of a sentence from files
    for (unsigned short i = 0; i < strmSources.size(); i++)
-   {
-    string tmpLine;
-    getline(*strmSources[i], tmpLine);
-    vcSrcLines[i] = tmpLine;
-    }
+    strmSources[i]->readLine(vcSrcLines[i]);
   
 
    cntLine++;
@@ -14,6 +14,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "GzStream.hpp"
 
 using namespace std;
 
@@ -218,21 +219,21 @@ size_t LoadSentences(const string &pWordsFile,
                      unsigned int pMinLength,
                      unsigned int pMaxLength)
 {
- ifstream strmWords (pWordsFile.c_str());
+ IGzStream strmWords (pWordsFile);
  if(!strmWords)
  {
   cerr << "Can't open file: " << pWordsFile << endl;
   return 0;
   }
 
- ifstream strmSynt (pSyntFile.c_str());
+ IGzStream strmSynt (pSyntFile);
  if(!strmSynt)
  {
   cerr << "Can't open file: " << pSyntFile << endl;
   return 0;
   }
 
- ifstream strmProps (pPropsFile.c_str());
+ IGzStream strmProps (pPropsFile);
  if(!strmProps)
  {
   cerr << "Can't open file: " << pPropsFile << endl;
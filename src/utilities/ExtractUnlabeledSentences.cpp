@@ -14,6 +14,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "GzStream.hpp"
 
 using namespace std;
 
@@ -183,7 +184,7 @@ size_t LoadSentences(const string &pSrcFile,
                      unsigned int pMinLength,
                      unsigned int pMaxLength)
 {
- ifstream strmData (pSrcFile.c_str());
+ IGzStream strmData (pSrcFile);
  if(!strmData)
  {
   cerr << "Can't open file: " << pSrcFile << endl;
@@ -0,0 +1,853 @@
+/**
+ *  @ RSK
+ *  @ Version 1.1        19.10.2026
+ *
+ *  excutable file to generate a synthetic corpus of any size for scale and
+ *  performance testing: labeled data as CoNLL words, synt.cha, synt.dep
+ *  and props files (as loaded by CoNLLLoader) and unlabeled data as merged
+ *  word/POS/cha file and synt.dep file (as loaded by ULoader)
+ *
+ *  Sentences are generated from a small grammar whose clauses are headed
+ *  by a predicate verb; the subject, object and prepositional phrases of
+ *  each clause and the subordinate clauses are its arguments, so that the
+ *  props, constituency trees and dependency trees are consistent with each
+ *  other. Sentence length, tree depth, predicates per sentence, arguments
+ *  per predicate and the distribution of argument labels are given as
+ *  parameters, and the same seed always generates the same corpus (the
+ *  random generator is implemented here and does not depend on the
+ *  platform).
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "Constants.hpp"
+#include "Utils.hpp"
+#include "Logging.hpp"
+
+using namespace std;
+
+
+#define MIN_TREE_DEPTH 4
+
+const string SYNTH_NOUNS[] = {"company", "market", "price", "share", "year",
+                              "investor", "bank", "government", "stock", "deal",
+                              "office", "plan", "report", "analyst", "profit",
+                              "week", "group", "month", "rate", "director", ""};
+const string SYNTH_VERBS[] = {"report", "expect", "acquire", "announce", "increase",
+                              "reduce", "offer", "approve", "change", "close",
+                              "raise", "trade", "claim", "decline", "receive",
+                              "include", "provide", "estimate", "complete", "sign", ""};
+const string SYNTH_ADJS[] = {"new", "big", "small", "major", "recent", "financial",
+                             "early", "private", "federal", "strong", ""};
+const string SYNTH_PREPS[] = {"in", "on", "for", "at", "with", "from", ""};
+const string SYNTH_DETS[] = {"the", "a", "this", "its", ""};
+
+/**
+ *  a constituent of the generated tree, or a word if it has no children
+ */
+struct synthNode
+{
+ string tag;
+ string form;
+ // lemma of the predicate verbs (empty for the other words)
+ string lemma;
+ // dependency relation of the head word of the node to that of its parent
+ string rel;
+ vector<synthNode *> children;
+ unsigned short headChild;
+ // arguments of the predicate verbs paired with their labels
+ vector<pair<synthNode *, string> > args;
+ // word span and head word (0-based), set when the tree is linearized
+ unsigned start;
+ unsigned end;
+ unsigned headWord;
+ };
+
+/**
+ *  parameters and state of the generation of a sentence
+ */
+struct synthContext
+{
+ unsigned short maxDepth;
+ unsigned int vocabularySize;
+ unsigned short minArgs;
+ unsigned short maxArgs;
+ double objectRate;
+ double ppRate;
+ vector<pair<string, double> > subjectLabels;
+ vector<pair<string, double> > argLabels;
+
+ unsigned int wordCount;
+ vector<synthNode *> baseNPs;
+ };
+
+struct synthWord
+{
+ string form;
+ string pos;
+ string cha;
+ string predLemma;
+ int head;
+ string rel;
+ };
+
+static unsigned long long gvRandomState = 1;
+
+void setSeed(unsigned long);
+double nextRandom();
+unsigned int randomInt(unsigned int, unsigned int);
+bool extractLabelDist(const string &, vector<pair<string, double> > &);
+string drawLabel(const vector<pair<string, double> > &, vector<string> &);
+string drawWord(const string [], unsigned int);
+unsigned short getChainCapacity(unsigned short, unsigned short);
+synthNode *newNode(const string &, const string &);
+synthNode *addWord(synthNode *, const string &, const string &, const string &,
+                   synthContext &);
+synthNode *generateNP(unsigned short, const string &, synthContext &);
+synthNode *generateClause(unsigned short, unsigned short, const string &,
+                          synthContext &);
+synthNode *generateSentence(unsigned short, unsigned int, synthContext &);
+void linearize(synthNode *, vector<synthWord> &, vector<synthNode *> &);
+void deleteTree(synthNode *);
+void writeLabeled(vector<synthWord> &, vector<synthNode *> &, ostream &,
+                  ostream &, ostream &, ostream &);
+void writeUnlabeled(vector<synthWord> &, ostream &, ostream &);
+void displayProgress(unsigned int);
+
+static void usage(const char * execName)
+{
+ cout << "Usage: " << execName << "[option][...]" << endl
+      << " <-n[Number of labeled sentences]>" << endl
+      << " <-u[Number of unlabeled sentences]>" << endl
+      << " <-s[Random seed]>" << endl
+      << " <-min[Minimum sentence length]>" << endl
+      << " <-max[Maximum sentence length]>" << endl
+      << " <-d[Maximum tree depth (at least 4)]>" << endl
+      << " <-minp[Minimum predicates per sentence]>" << endl
+      << " <-maxp[Maximum predicates per sentence]>" << endl
+      << " <-mina[Minimum arguments per predicate]>" << endl
+      << " <-maxa[Maximum arguments per predicate]>" << endl
+      << " <-or[Rate of objects among the optional arguments]>" << endl
+      << " <-pr[Rate of PP attachment to noun phrases]>" << endl
+      << " <-sl[Subject label distribution; e.g. A0:80,A1:20]>" << endl
+      << " <-al[Other argument label distribution; e.g. A1:60,A2:15,AM-TMP:10,AM-LOC:15]>" << endl
+      << " <-v[Vocabulary size of each word class]>" << endl
+      << " <-ln[Labeled files name prefix (considered in labeled dir)]>" << endl
+      << " <-un[Unlabeled files name prefix (considered in unlabeled dir)]>" << endl
+      <<  endl;
+}
+
+int main(int argc, char ** argv)
+{
+ unsigned int vLabeledNum = 1000;
+ unsigned int vUnlabeledNum = 0;
+ unsigned long vSeed = 1;
+ unsigned int vMinLength = 5;
+ unsigned int vMaxLength = 30;
+ unsigned short vMinPreds = 1;
+ unsigned short vMaxPreds = 3;
+ string vSubjectLabels = "A0:80,A1:20";
+ string vArgLabels = "A1:60,A2:15,AM-TMP:10,AM-LOC:10,AM-MNR:5";
+
+ synthContext vContext;
+ vContext.maxDepth = 12;
+ vContext.vocabularySize = 1000;
+ vContext.minArgs = 1;
+ vContext.maxArgs = 3;
+ vContext.objectRate = 0.7;
+ vContext.ppRate = 0.2;
+
+ string vLabeledPath = DEFAULT_CONLL_LABELED_PATH;
+ string vUnlabeledPath = DEFAULT_CONLL_UNLABELED_PATH;
+ string vLabeledName = vLabeledPath + "/" + "synthetic.train";
+ string vUnlabeledName = vUnlabeledPath + "/" + "synthetic.unlabeled";
+
+ if ((argc > 1) && (string(argv[1]) == "help"))
+ {
+  usage(argv[0]);
+  exit(-1);
+  }
+
+ for (unsigned short cntArg = 1; cntArg + 1 < argc; cntArg++)
+ {
+  if (argv[cntArg][0] != '-')
+   continue;
+
+  string vParam = argv[cntArg] + 1;
+
+  if (vParam == "n")
+  {
+   vLabeledNum = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "u")
+  {
+   vUnlabeledNum = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "s")
+  {
+   vSeed = strtoul(argv[cntArg + 1], NULL, 10);
+   continue;
+   }
+
+  if (vParam == "min")
+  {
+   vMinLength = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "max")
+  {
+   vMaxLength = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "d")
+  {
+   vContext.maxDepth = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "minp")
+  {
+   vMinPreds = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "maxp")
+  {
+   vMaxPreds = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "mina")
+  {
+   vContext.minArgs = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "maxa")
+  {
+   vContext.maxArgs = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "or")
+  {
+   vContext.objectRate = atof(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "pr")
+  {
+   vContext.ppRate = atof(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "sl")
+  {
+   vSubjectLabels = argv[cntArg + 1];
+   continue;
+   }
+
+  if (vParam == "al")
+  {
+   vArgLabels = argv[cntArg + 1];
+   continue;
+   }
+
+  if (vParam == "v")
+  {
+   vContext.vocabularySize = atoi(argv[cntArg + 1]);
+   continue;
+   }
+
+  if (vParam == "ln")
+  {
+   vLabeledName = vLabeledPath + "/" + argv[cntArg + 1];
+   continue;
+   }
+
+  if (vParam == "un")
+  {
+   vUnlabeledName = vUnlabeledPath + "/" + argv[cntArg + 1];
+   continue;
+   }
+  }
+
+ // keeping the parameters consistent
+ if (vContext.maxDepth < MIN_TREE_DEPTH)
+  vContext.maxDepth = MIN_TREE_DEPTH;
+ if (vMinPreds == 0)
+  vMinPreds = 1;
+ if (vMaxPreds < vMinPreds)
+  vMaxPreds = vMinPreds;
+ if (vContext.minArgs == 0)
+  vContext.minArgs = 1;
+ if (vContext.maxArgs < vContext.minArgs)
+  vContext.maxArgs = vContext.minArgs;
+ if (vMaxLength < vMinLength)
+  vMaxLength = vMinLength;
+ if (vContext.vocabularySize == 0)
+  vContext.vocabularySize = 1;
+
+ if (!extractLabelDist(vSubjectLabels, vContext.subjectLabels) ||
+     !extractLabelDist(vArgLabels, vContext.argLabels))
+ {
+  cerr << "Invalid label distribution!" << endl;
+  exit(-1);
+  }
+
+ setSeed(vSeed);
+
+ /**
+  *  generating labeled data
+  */
+
+ if (vLabeledNum > 0)
+ {
+  ofstream strmWords ((vLabeledName + ".words").c_str());
+  ofstream strmSyntCha ((vLabeledName + ".synt.cha").c_str());
+  ofstream strmSyntDep ((vLabeledName + ".synt.dep").c_str());
+  ofstream strmProps ((vLabeledName + ".props").c_str());
+  if (!strmWords || !strmSyntCha || !strmSyntDep || !strmProps)
+  {
+   cerr << "Can't create labeled files: " << vLabeledName << ".*" << endl;
+   exit(-1);
+   }
+
+  cout << "\nGenerating labeled sentences ..." << endl;
+  for (unsigned int cntSntnc = 0; cntSntnc < vLabeledNum; cntSntnc++)
+  {
+   synthNode *vRoot = generateSentence(randomInt(vMinPreds, vMaxPreds),
+                                       randomInt(vMinLength, vMaxLength),
+                                       vContext);
+   vector<synthWord> vWords;
+   vector<synthNode *> vPreds;
+   linearize(vRoot, vWords, vPreds);
+   writeLabeled(vWords, vPreds, strmWords, strmSyntCha, strmSyntDep, strmProps);
+   deleteTree(vRoot);
+
+   if (Progress::isDue())
+    displayProgress(cntSntnc + 1);
+   }
+  displayProgress(vLabeledNum);
+  if (Progress::isTTY())
+   cout << endl;
+  }
+
+ /**
+  *  generating unlabeled data
+  */
+
+ if (vUnlabeledNum > 0)
+ {
+  ofstream strmData ((vUnlabeledName + ".cha").c_str());
+  ofstream strmSyntDep ((vUnlabeledName + ".synt.dep").c_str());
+  if (!strmData || !strmSyntDep)
+  {
+   cerr << "Can't create unlabeled files: " << vUnlabeledName << ".*" << endl;
+   exit(-1);
+   }
+
+  cout << "\nGenerating unlabeled sentences ..." << endl;
+  for (unsigned int cntSntnc = 0; cntSntnc < vUnlabeledNum; cntSntnc++)
+  {
+   synthNode *vRoot = generateSentence(randomInt(vMinPreds, vMaxPreds),
+                                       randomInt(vMinLength, vMaxLength),
+                                       vContext);
+   vector<synthWord> vWords;
+   vector<synthNode *> vPreds;
+   linearize(vRoot, vWords, vPreds);
+   writeUnlabeled(vWords, strmData, strmSyntDep);
+   deleteTree(vRoot);
+
+   if (Progress::isDue())
+    displayProgress(cntSntnc + 1);
+   }
+  displayProgress(vUnlabeledNum);
+  if (Progress::isTTY())
+   cout << endl;
+  }
+
+ cout << "\nGenerating the corpus is done!" << endl;
+
+ return 0;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  xorshift64* generator; the state must never be 0
+ */
+void setSeed(unsigned long pSeed)
+{
+ gvRandomState = 0x9E3779B97F4A7C15ULL ^ (unsigned long long) pSeed;
+ if (gvRandomState == 0)
+  gvRandomState = 1;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  returns a random number in [0, 1)
+ */
+double nextRandom()
+{
+ gvRandomState ^= gvRandomState >> 12;
+ gvRandomState ^= gvRandomState << 25;
+ gvRandomState ^= gvRandomState >> 27;
+
+ return ((gvRandomState * 0x2545F4914F6CDD1DULL) >> 11) / 9007199254740992.0;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  returns a random integer in [pMin, pMax]
+ */
+unsigned int randomInt(unsigned int pMin, unsigned int pMax)
+{
+ return pMin + (unsigned int) (nextRandom() * (pMax - pMin + 1));
+}
+
+///---------------------------------------------------------------------
+/**
+ *  extracts labels and their weights from a string like A0:80,A1:20
+ */
+bool extractLabelDist(const string &pDist, vector<pair<string, double> > &pLabels)
+{
+ vector<string> vcLabels;
+ tokenize(pDist, vcLabels, ",");
+
+ pLabels.clear();
+ for (unsigned i = 0; i < vcLabels.size(); i++)
+ {
+  vector<string> vcLabel;
+  tokenize(vcLabels[i], vcLabel, ":");
+  if (vcLabel.size() != 2)
+   return false;
+
+  pLabels.push_back(pair<string, double>(vcLabel[0], atof(vcLabel[1].c_str())));
+  }
+
+ return !pLabels.empty();
+}
+
+///---------------------------------------------------------------------
+/**
+ *  draws a label by the distribution among those not used yet by the
+ *  predicate (unless all of them are used), and adds it to the used ones
+ */
+string drawLabel(const vector<pair<string, double> > &pLabels,
+                 vector<string> &pUsedLabels)
+{
+ double vTotal = 0;
+ for (unsigned i = 0; i < pLabels.size(); i++)
+  if (find(pUsedLabels.begin(), pUsedLabels.end(), pLabels[i].first) ==
+      pUsedLabels.end())
+   vTotal += pLabels[i].second;
+
+ bool vAll = (vTotal == 0);
+ if (vAll)
+  for (unsigned i = 0; i < pLabels.size(); i++)
+   vTotal += pLabels[i].second;
+
+ double vDraw = nextRandom() * vTotal;
+ string vLabel;
+ for (unsigned i = 0; i < pLabels.size(); i++)
+ {
+  if (!vAll &&
+      (find(pUsedLabels.begin(), pUsedLabels.end(), pLabels[i].first) !=
+       pUsedLabels.end()))
+   continue;
+
+  // the last label which can be drawn is taken if rounding passes the end
+  vLabel = pLabels[i].first;
+  if (vDraw < pLabels[i].second)
+   break;
+  vDraw -= pLabels[i].second;
+  }
+
+ pUsedLabels.push_back(vLabel);
+ return vLabel;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  draws a word of a class of the given vocabulary size by a Zipf-like
+ *  (log-uniform) distribution of ranks; the ranks beyond the list of the
+ *  class are made by numbering its words (a size of 0 for closed classes
+ *  drawn only from their list)
+ */
+string drawWord(const string pList[], unsigned int pVocabularySize)
+{
+ unsigned int vListSize = 0;
+ while (!pList[vListSize].empty())
+  vListSize++;
+
+ if (pVocabularySize == 0)
+  return pList[randomInt(0, vListSize - 1)];
+
+ unsigned int vRank = (unsigned int) exp(nextRandom() * log((double) pVocabularySize + 1)) - 1;
+ if (vRank >= pVocabularySize)
+  vRank = pVocabularySize - 1;
+
+ if (vRank < vListSize)
+  return pList[vRank];
+
+ return pList[vRank % vListSize] + intToStr(vRank / vListSize);
+}
+
+///---------------------------------------------------------------------
+/**
+ *  returns the number of predicates of a chain of clauses nested by SBAR
+ *  starting from the given level
+ *
+ *  A clause at level L has its VP at L + 1 and the object at L + 2; a
+ *  subordinate clause is nested at L + 3 (VP, SBAR, S)
+ */
+unsigned short getChainCapacity(unsigned short pLevel, unsigned short pMaxDepth)
+{
+ if (pLevel + 2 > pMaxDepth)
+  return 0;
+
+ return 1 + getChainCapacity(pLevel + 3, pMaxDepth);
+}
+
+///---------------------------------------------------------------------
+synthNode *newNode(const string &pTag, const string &pRel)
+{
+ synthNode *vNode = new synthNode;
+ vNode->tag = pTag;
+ vNode->rel = pRel;
+ vNode->headChild = 0;
+ vNode->start = 0;
+ vNode->end = 0;
+ vNode->headWord = 0;
+
+ return vNode;
+}
+
+///---------------------------------------------------------------------
+synthNode *addWord(synthNode *pParent, const string &pPOS, const string &pForm,
+                   const string &pRel, synthContext &pContext)
+{
+ synthNode *vWord = newNode(pPOS, pRel);
+ vWord->form = pForm;
+ pParent->children.push_back(vWord);
+ pContext.wordCount++;
+
+ return vWord;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  generates a noun phrase at the given level: a base NP (DT NN) or, if the
+ *  depth allows, a NP with an attached PP (NP (NP DT NN) (PP IN NP))
+ */
+synthNode *generateNP(unsigned short pLevel, const string &pRel,
+                      synthContext &pContext)
+{
+ synthNode *vNP = newNode("NP", pRel);
+
+ if ((pLevel + 2 <= pContext.maxDepth) && (nextRandom() < pContext.ppRate))
+ {
+  vNP->children.push_back(generateNP(pLevel + 1, "", pContext));
+  vNP->headChild = 0;
+
+  synthNode *vPP = newNode("PP", "NMOD");
+  addWord(vPP, "IN", drawWord(SYNTH_PREPS, 0), "", pContext);
+  vPP->children.push_back(generateNP(pLevel + 2, "PMOD", pContext));
+  vNP->children.push_back(vPP);
+
+  return vNP;
+  }
+
+ addWord(vNP, "DT", drawWord(SYNTH_DETS, 0), "NMOD", pContext);
+ addWord(vNP, "NN", drawWord(SYNTH_NOUNS, pContext.vocabularySize), "", pContext);
+ vNP->headChild = 1;
+ pContext.baseNPs.push_back(vNP);
+
+ return vNP;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  generates a clause at the given level with the given number of
+ *  predicates (the rest of the predicates are in the nested clauses):
+ *  (S NP (VP VB [NP] [PP] [(SBAR IN S)]))
+ */
+synthNode *generateClause(unsigned short pLevel, unsigned short pPredCount,
+                          const string &pRel, synthContext &pContext)
+{
+ synthNode *vS = newNode("S", pRel);
+ synthNode *vSubject = generateNP(pLevel + 1, "SBJ", pContext);
+ vS->children.push_back(vSubject);
+
+ synthNode *vVP = newNode("VP", "");
+ vS->children.push_back(vVP);
+ vS->headChild = 1;
+
+ string vLemma = drawWord(SYNTH_VERBS, pContext.vocabularySize);
+ bool vPast = (nextRandom() < 0.5);
+ string vForm = vLemma;
+ if (vPast)
+  vForm += (vLemma[vLemma.size() - 1] == 'e') ? "d" : "ed";
+ else
+  vForm += "s";
+
+ synthNode *vVerb = addWord(vVP, vPast ? "VBD" : "VBZ", vForm, "", pContext);
+ vVerb->lemma = vLemma;
+ vVP->headChild = 0;
+
+ vector<string> vUsedLabels;
+ vVerb->args.push_back(pair<synthNode *, string>
+                       (vSubject, drawLabel(pContext.subjectLabels, vUsedLabels)));
+
+ // the optional arguments (object and PP) fill the argument count of the
+ // predicate apart from the subject and the subordinate clause
+ unsigned short vArgCount = randomInt(pContext.minArgs, pContext.maxArgs);
+ unsigned short vOptionalCount = vArgCount - 1 - (pPredCount > 1 ? 1 : 0);
+ if (vArgCount < 1 + (pPredCount > 1 ? 1 : 0))
+  vOptionalCount = 0;
+
+ for (unsigned short i = 0; i < vOptionalCount; i++)
+ {
+  bool vObject = (nextRandom() < pContext.objectRate) ||
+                 (pLevel + 3 > pContext.maxDepth);
+  synthNode *vArg;
+
+  if (vObject)
+   vArg = generateNP(pLevel + 2, "OBJ", pContext);
+  else
+  {
+   vArg = newNode("PP", "ADV");
+   addWord(vArg, "IN", drawWord(SYNTH_PREPS, 0), "", pContext);
+   vArg->children.push_back(generateNP(pLevel + 3, "PMOD", pContext));
+   }
+
+  vVP->children.push_back(vArg);
+  vVerb->args.push_back(pair<synthNode *, string>
+                        (vArg, drawLabel(pContext.argLabels, vUsedLabels)));
+  }
+
+ if (pPredCount > 1)
+ {
+  synthNode *vSBAR = newNode("SBAR", "OBJ");
+  addWord(vSBAR, "IN", "that", "", pContext);
+  vSBAR->children.push_back(generateClause(pLevel + 3, pPredCount - 1,
+                                           "SUB", pContext));
+  vVP->children.push_back(vSBAR);
+  vVerb->args.push_back(pair<synthNode *, string>
+                        (vSBAR, drawLabel(pContext.argLabels, vUsedLabels)));
+  }
+
+ return vS;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  generates a sentence with the given number of predicates, padded with
+ *  adjectives up to the given length (the length is at least what the
+ *  predicates need)
+ *
+ *  The predicates are nested in chains of subordinate clauses as deep as
+ *  the maximum depth allows, and more chains are coordinated if needed:
+ *  (S1 (S ... .)) or (S1 (S (S ...) CC (S ...) .))
+ */
+synthNode *generateSentence(unsigned short pPredCount, unsigned int pLength,
+                            synthContext &pContext)
+{
+ pContext.wordCount = 0;
+ pContext.baseNPs.clear();
+
+ synthNode *vS1 = newNode("S1", "");
+ synthNode *vS;
+
+ if (pPredCount <= getChainCapacity(2, pContext.maxDepth))
+ {
+  vS = generateClause(2, pPredCount, "", pContext);
+  vS1->children.push_back(vS);
+  }
+ else
+ {
+  vS = newNode("S", "");
+  vS1->children.push_back(vS);
+
+  unsigned short vCapacity = getChainCapacity(3, pContext.maxDepth);
+  unsigned short vLeft = pPredCount;
+  while (vLeft > 0)
+  {
+   unsigned short vChain = vLeft < vCapacity ? vLeft : vCapacity;
+
+   if (!vS->children.empty())
+    addWord(vS, "CC", "and", "COORD", pContext);
+   vS->children.push_back(generateClause(3, vChain,
+                                         vS->children.empty() ? "" : "CONJ",
+                                         pContext));
+   vLeft -= vChain;
+   }
+  vS->headChild = 0;
+  }
+
+ addWord(vS, ".", ".", "P", pContext);
+
+ // padding the base NPs with adjectives before their nouns
+ while ((pContext.wordCount < pLength) && !pContext.baseNPs.empty())
+ {
+  synthNode *vNP = pContext.baseNPs[randomInt(0, pContext.baseNPs.size() - 1)];
+  synthNode *vAdj = newNode("JJ", "NMOD");
+  vAdj->form = drawWord(SYNTH_ADJS, pContext.vocabularySize);
+  vNP->children.insert(vNP->children.begin() + 1, vAdj);
+  vNP->headChild++;
+  pContext.wordCount++;
+  }
+
+ return vS1;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  assigns word spans and head words to the nodes and converts the tree
+ *  into the CoNLL columns of its words; the predicates are collected in
+ *  their order in the sentence
+ */
+void linearize(synthNode *pNode, vector<synthWord> &pWords,
+               vector<synthNode *> &pPreds)
+{
+ pNode->start = pWords.size();
+
+ if (pNode->children.empty())
+ {
+  synthWord vWord;
+  vWord.form = pNode->form;
+  vWord.pos = pNode->tag;
+  vWord.cha = "*";
+  vWord.predLemma = pNode->lemma;
+  vWord.head = -1;
+  pWords.push_back(vWord);
+
+  if (!pNode->lemma.empty())
+   pPreds.push_back(pNode);
+
+  pNode->end = pNode->start;
+  pNode->headWord = pNode->start;
+  return;
+  }
+
+ for (unsigned i = 0; i < pNode->children.size(); i++)
+  linearize(pNode->children[i], pWords, pPreds);
+
+ pNode->end = pWords.size() - 1;
+ pNode->headWord = pNode->children[pNode->headChild]->headWord;
+
+ // the head words of the other children depend on the head word of the node
+ for (unsigned i = 0; i < pNode->children.size(); i++)
+  if (i != pNode->headChild)
+  {
+   pWords[pNode->children[i]->headWord].head = pNode->headWord;
+   pWords[pNode->children[i]->headWord].rel = pNode->children[i]->rel;
+   }
+
+ pWords[pNode->start].cha = "(" + pNode->tag + pWords[pNode->start].cha;
+ pWords[pNode->end].cha += ")";
+}
+
+///---------------------------------------------------------------------
+void deleteTree(synthNode *pNode)
+{
+ for (unsigned i = 0; i < pNode->children.size(); i++)
+  deleteTree(pNode->children[i]);
+
+ delete pNode;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  writes a sentence into the CoNLL words, synt.cha, synt.dep and props
+ *  files; the props have a column per predicate marking its arguments
+ */
+void writeLabeled(vector<synthWord> &pWords, vector<synthNode *> &pPreds,
+                  ostream &pStrmWords, ostream &pStrmSyntCha,
+                  ostream &pStrmSyntDep, ostream &pStrmProps)
+{
+ vector<vector<string> > vColumns (pPreds.size(), vector<string>(pWords.size(), "*"));
+
+ for (unsigned cntPred = 0; cntPred < pPreds.size(); cntPred++)
+ {
+  vector<string> &vColumn = vColumns[cntPred];
+  vColumn[pPreds[cntPred]->start] = "(V*)";
+
+  for (unsigned i = 0; i < pPreds[cntPred]->args.size(); i++)
+  {
+   synthNode *vArg = pPreds[cntPred]->args[i].first;
+   vColumn[vArg->start] = "(" + pPreds[cntPred]->args[i].second + vColumn[vArg->start];
+   vColumn[vArg->end] += ")";
+   }
+  }
+
+ for (unsigned i = 0; i < pWords.size(); i++)
+ {
+  pStrmWords << pWords[i].form << endl;
+  pStrmSyntCha << pWords[i].pos << " " << pWords[i].cha << endl;
+
+  if (pWords[i].head == -1)
+   pStrmSyntDep << 0 << " " << "ROOT" << endl;
+  else
+   pStrmSyntDep << pWords[i].head + 1 << " " << pWords[i].rel << endl;
+
+  pStrmProps << (pWords[i].predLemma.empty() ? "-" : pWords[i].predLemma);
+  for (unsigned cntPred = 0; cntPred < pPreds.size(); cntPred++)
+   pStrmProps << " " << vColumns[cntPred][i];
+  pStrmProps << endl;
+  }
+
+ pStrmWords << endl;
+ pStrmSyntCha << endl;
+ pStrmSyntDep << endl;
+ pStrmProps << endl;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  writes a sentence into the merged word/POS/cha file and synt.dep file
+ *  of unlabeled data
+ */
+void writeUnlabeled(vector<synthWord> &pWords, ostream &pStrmData,
+                    ostream &pStrmSyntDep)
+{
+ for (unsigned i = 0; i < pWords.size(); i++)
+ {
+  pStrmData << pWords[i].form << " " << pWords[i].pos << " "
+            << pWords[i].cha << endl;
+
+  if (pWords[i].head == -1)
+   pStrmSyntDep << 0 << " " << "ROOT" << endl;
+  else
+   pStrmSyntDep << pWords[i].head + 1 << " " << pWords[i].rel << endl;
+  }
+
+ pStrmData << endl;
+ pStrmSyntDep << endl;
+}
+
+///---------------------------------------------------------------------
+/**
+ *  displays the number of sentences generated so far, overwriting the
+ *  previous one on a terminal and in a line of its own otherwise (e.g. 
+ *  when the output is redirected to a file)
+ */
+void displayProgress(unsigned int pCount)
+{
+ if (Progress::isTTY())
+  cout << "\r" << pCount << " sentences generated" << flush;
+ else
+  cout << pCount << " sentences generated" << endl;
+}
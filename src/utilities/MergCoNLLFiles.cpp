@@ -15,6 +15,7 @@
 
 #include "Constants.hpp"
 #include "Utils.hpp"
+#include "CoNLLReader.hpp"
 
 using namespace std;
 
@@ -88,15 +89,14 @@ int main(int argc, char ** argv)
 short MergFiles(vector<string> &pSrcFiles,
                 const string &pDestFile)
 {
- vector<ifstream *> strmSources;
+ vector<CoNLLReader *> strmSources;
  
  for (unsigned short i = 0; i < pSrcFiles.size(); i++)
  {
-  ifstream *tmpStrm = new ifstream;
-  tmpStrm->open(pSrcFiles[i].c_str());
+  CoNLLReader *tmpStrm = new CoNLLReader;
   strmSources.push_back(tmpStrm);
 
-  if(!strmSources[i])
+  if (tmpStrm->open(pSrcFiles[i]) != 0)
   {
    cerr << "Can't open file: " << pSrcFiles[i] << endl;
    return -1;
@@ -110,7 +110,7 @@ short MergFiles(vector<string> &pSrcFiles,
   return -1;
   }
  
- vector<string> vcSrcLines(strmSources.size(), "");
+ vector<StrRef> vcSrcLines(strmSources.size());
  size_t cntLines = 0;
  
  // looping to read files; only one of the streams is checked for eof
@@ -118,11 +118,7 @@ short MergFiles(vector<string> &pSrcFiles,
  {
   // reading the 1st line (in CoNLL format) of a sentence from files
   for (unsigned short i = 0; i < strmSources.size(); i++)
-  {
-   string tmpLine;
-   getline(*strmSources[i], tmpLine);
-   vcSrcLines[i] = tmpLine;
-   }
+   strmSources[i]->readLine(vcSrcLines[i]);
   
   // controlling CoNLL files consistency; base is the 1st file
   if (isEmptyLine(vcSrcLines[0]))
@@ -134,10 +130,6 @@ short MergFiles(vector<string> &pSrcFiles,
      return 0;
      }
   
-  // an empty line after each sentence
-  for (unsigned short i = 0; i < vcSrcLines.size(); i++)
-   trimLine(vcSrcLines[i]);
-  
   strmDest << vcSrcLines[0];
   for (unsigned short i = 1; i < vcSrcLines.size(); i++)
    strmDest << "\t" << vcSrcLines[i];
@@ -147,5 +139,8 @@ short MergFiles(vector<string> &pSrcFiles,
   cout << "\r" << cntLines << " Lines merged" << flush;
   }
  
+ for (unsigned short i = 0; i < strmSources.size(); i++)
+  delete strmSources[i];
+ 
  return 0;
 }